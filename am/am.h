@@ -32,6 +32,11 @@
   + 04/10/24 (pjf):
     - Require C++17.
     - Fix templatized versions of product functions.
+  + 10/18/26: Add AngularMomentumSequence and ProductAngularMomentaView, for
+    allocation-free iteration over coupled angular momenta.
+  + 10/18/26: Add AMInterval, with class- and parity-aware intersection,
+    union, and coupling.
+  + 10/18/26: Reject AMInterval step other than one or two.
 
 ****************************************************************/
 
@@ -39,6 +44,9 @@
 #define AM_H_
 
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -117,6 +125,132 @@ namespace am {
     return result;
   }
 
+#ifndef SWIG
+  template<typename R>
+  class AngularMomentumSequence
+  // Lazy sequence of angular momenta first, first+step, ..., in steps of one
+  // or two.
+  //
+  // No storage is allocated, so the sequence may be used in place of a
+  // std::vector in inner loops:
+  //
+  //   for (HalfInt J : am::ProductAngularMomentaView(j1,j2))
+  //     ...
+  {
+   public:
+
+    class iterator
+    {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = R;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const R*;
+      using reference = R;
+
+      constexpr iterator() : j_(), step_(1) {}
+      constexpr iterator(const R& j, int step) : j_(j), step_(step) {}
+
+      constexpr R operator*() const {return j_;}
+      constexpr iterator& operator++() {j_ += step_; return *this;}
+      constexpr iterator operator++(int) {iterator it = *this; j_ += step_; return it;}
+      constexpr bool operator==(const iterator& other) const {return j_==other.j_;}
+      constexpr bool operator!=(const iterator& other) const {return !(j_==other.j_);}
+
+     private:
+      R j_;
+      int step_;
+    };
+
+    using value_type = R;
+    using size_type = std::size_t;
+    using const_iterator = iterator;
+
+    constexpr AngularMomentumSequence() : first_(), size_(0), step_(1) {}
+
+    constexpr AngularMomentumSequence(const R& j_min, const R& j_max, int step = 1)
+    // Construct sequence j_min, j_min+step, ..., not exceeding j_max.
+      : first_(j_min), size_(0), step_(step)
+    {
+      if (j_min<=j_max)
+        size_ = std::size_t(int(j_max-j_min)/step)+1;
+    }
+
+    // accessors
+    constexpr std::size_t size() const {return size_;}
+    constexpr bool empty() const {return size_==0;}
+    constexpr int step() const {return step_;}
+    constexpr R front() const {return first_;}
+    constexpr R back() const {return (*this)[size_-1];}
+    constexpr R operator[](std::size_t i) const {return first_+R(step_*int(i));}
+
+    // iteration
+    constexpr iterator begin() const {return iterator(first_,step_);}
+    constexpr iterator end() const {return iterator(first_+R(step_*int(size_)),step_);}
+
+    std::vector<R> vector() const
+    // Materialize sequence as std::vector.
+    {
+      return std::vector<R>(begin(),end());
+    }
+
+   private:
+    R first_;
+    std::size_t size_;
+    int step_;
+  };
+
+  template<
+      typename T, typename U,
+      typename R = typename std::common_type_t<T,U>,
+      std::enable_if_t<
+          std::is_constructible_v<HalfInt, R>
+          || std::is_convertible_v<R, HalfInt>
+        >* = nullptr
+    >
+  constexpr inline
+  AngularMomentumSequence<R> ProductAngularMomentaView(const T j1, const U j2)
+  // Generate lazy sequence of angular momenta that j1 and j2 can be coupled to
+  // under the triangle inequality.
+  //
+  // This is the allocation-free counterpart of ProductAngularMomenta.
+  {
+    using std::abs;
+    return AngularMomentumSequence<R>(
+        abs(static_cast<R>(j1)-static_cast<R>(j2)), static_cast<R>(j1)+static_cast<R>(j2)
+      );
+  }
+
+  template<
+      typename T, typename U,
+      typename R = typename std::common_type_t<T,U>,
+      std::enable_if_t<
+          std::is_constructible_v<HalfInt, R>
+          || std::is_convertible_v<R, HalfInt>
+        >* = nullptr
+    >
+  constexpr inline
+  AngularMomentumSequence<R> ProductAngularMomentaView(const T j1, const U j2, int grade)
+  // Generate lazy sequence of angular momenta that j1 and j2 can be coupled to
+  // under the triangle inequality, restricted to fixed parity.
+  //
+  // Only angular momenta J with floor(J)%2==grade are included, e.g., for
+  // integer J, the values with (-)^J=(-)^grade.  The sequence therefore
+  // advances in steps of two.
+  //
+  // Arguments:
+  //   j1, j2 (HalfInt) : angular momenta to couple (should be nonnegative)
+  //   grade (int) : parity grade (0 or 1)
+  {
+    using std::abs;
+    R j_min = abs(static_cast<R>(j1)-static_cast<R>(j2));
+    const R j_max = static_cast<R>(j1)+static_cast<R>(j2);
+    if (((TwiceValue(j_min)/2)%2)!=(grade%2))
+      j_min += 1;
+    return AngularMomentumSequence<R>(j_min, j_max, 2);
+  }
+#endif  // SWIG
+
   template<
       typename T, typename U,
       typename R = typename std::common_type_t<T,U>,
@@ -186,6 +320,189 @@ namespace am {
     return AngularMomentumRangeIntersection(r1,r);
   }
 
+#ifndef SWIG
+  ////////////////////////////////////////////////////////////////
+  // angular momentum interval algebra
+  ////////////////////////////////////////////////////////////////
+
+  class AMInterval
+  // Set of angular momenta min, min+step, ..., max, in steps of one or two.
+  //
+  // Unlike the HalfInt::pair ranges above, an AMInterval carries the integer
+  // or half-integer class of its values (through min), and, for step two, a
+  // parity grade, so that operations on intervals respect these selection
+  // rules.  Intervals are stored in canonical form (max reachable from min,
+  // step one for a single value), so that equal sets compare equal.
+  {
+   public:
+
+    constexpr AMInterval() : two_min_(0), two_max_(-2), two_step_(2) {}
+
+    constexpr AMInterval(const HalfInt& j)
+    // Construct interval containing the single value j.
+      : two_min_(TwiceValue(j)), two_max_(TwiceValue(j)), two_step_(2)
+    {}
+
+    constexpr AMInterval(const HalfInt& j_min, const HalfInt& j_max, int step = 1)
+    // Construct interval j_min, j_min+step, ..., not exceeding j_max.
+    //
+    // Throws std::invalid_argument for step other than 1 or 2.
+      : two_min_(TwiceValue(j_min)), two_max_(TwiceValue(j_max)), two_step_(2*step)
+    {
+      if (!((step==1)||(step==2)))
+        throw std::invalid_argument("angular momentum interval with step not 1 or 2");
+      Normalize();
+    }
+
+    static constexpr AMInterval FromRange(const HalfInt::pair& range)
+    {
+      return AMInterval(range.first, range.second);
+    }
+
+    static constexpr AMInterval Triangle(const HalfInt& j1, const HalfInt& j2)
+    // Angular momenta to which j1 and j2 couple.
+    {
+      const HalfInt j_min = (j1>j2) ? j1-j2 : j2-j1;
+      return AMInterval(j_min, j1+j2);
+    }
+
+    // accessors
+    constexpr bool empty() const {return two_max_<two_min_;}
+    constexpr std::size_t size() const
+    {
+      return empty() ? 0 : std::size_t((two_max_-two_min_)/two_step_)+1;
+    }
+    constexpr HalfInt min() const {return HalfInt(two_min_,2);}
+    constexpr HalfInt max() const {return HalfInt(two_max_,2);}
+    constexpr int step() const {return two_step_/2;}
+    constexpr HalfInt::pair range() const {return HalfInt::pair(min(),max());}
+    constexpr HalfInt operator[](std::size_t i) const {return HalfInt(two_min_+two_step_*int(i),2);}
+
+    constexpr bool Contains(const HalfInt& j) const
+    {
+      const int two_j = TwiceValue(j);
+      return (two_j>=two_min_) && (two_j<=two_max_) && ((two_j-two_min_)%two_step_==0);
+    }
+
+    constexpr AngularMomentumSequence<HalfInt> values() const
+    // Lazy sequence of values, for iteration.
+    {
+      return empty() ? AngularMomentumSequence<HalfInt>() : AngularMomentumSequence<HalfInt>(min(),max(),step());
+    }
+
+    friend constexpr bool operator==(const AMInterval& a, const AMInterval& b)
+    {
+      if (a.empty() || b.empty())
+        return a.empty() && b.empty();
+      return (a.two_min_==b.two_min_) && (a.two_max_==b.two_max_) && (a.two_step_==b.two_step_);
+    }
+    friend constexpr bool operator!=(const AMInterval& a, const AMInterval& b) {return !(a==b);}
+
+   private:
+
+    friend constexpr AMInterval AMIntervalIntersection(const AMInterval&, const AMInterval&);
+    friend constexpr AMInterval AMIntervalUnion(const AMInterval&, const AMInterval&);
+    friend constexpr AMInterval AMIntervalCoupling(const AMInterval&, const AMInterval&);
+
+    static constexpr AMInterval FromTwiceValues(int two_min, int two_max, int two_step)
+    {
+      AMInterval interval;
+      interval.two_min_ = two_min;
+      interval.two_max_ = two_max;
+      interval.two_step_ = two_step;
+      interval.Normalize();
+      return interval;
+    }
+
+    constexpr void Normalize()
+    {
+      if (two_max_<two_min_)
+        {
+          *this = AMInterval();
+          return;
+        }
+      two_max_ -= (two_max_-two_min_)%two_step_;
+      if (two_max_==two_min_)
+        two_step_ = 2;
+    }
+
+    int two_min_, two_max_, two_step_;
+  };
+
+  constexpr inline
+  AMInterval AMIntervalIntersection(const AMInterval& a, const AMInterval& b)
+  // Obtain intersection of two intervals.
+  //
+  // The intersection is empty if the intervals are of different integer
+  // class, or of incompatible parity grade.
+  {
+    if (a.empty() || b.empty())
+      return AMInterval();
+    const int two_min = std::max(a.two_min_,b.two_min_);
+    const int two_max = std::min(a.two_max_,b.two_max_);
+    const int two_step = std::max(a.two_step_,b.two_step_);
+    // first common value at or above two_min (steps are 2 or 4, so at most
+    // two candidates need be tried)
+    for (int two_j=two_min; (two_j<=two_min+2) && (two_j<=two_max); ++two_j)
+      if (((two_j-a.two_min_)%a.two_step_==0) && ((two_j-b.two_min_)%b.two_step_==0))
+        return AMInterval::FromTwiceValues(two_j, two_max, two_step);
+    return AMInterval();
+  }
+
+  constexpr inline
+  AMInterval AMIntervalUnion(const AMInterval& a, const AMInterval& b)
+  // Obtain smallest interval containing both intervals.
+  //
+  // This is the union when the intervals are of the same grade and overlap
+  // or abut, and otherwise a superset (e.g., with step one, for intervals of
+  // opposite parity grade), which remains valid for pruning.
+  //
+  // Throws std::invalid_argument for intervals of different integer class,
+  // which have no common superset.
+  {
+    if (a.empty())
+      return b;
+    if (b.empty())
+      return a;
+    const int two_min = std::min(a.two_min_,b.two_min_);
+    const int two_max = std::max(a.two_max_,b.two_max_);
+    if ((a.two_min_-b.two_min_)%2!=0)
+      throw std::invalid_argument("union of angular momentum intervals of different integer class");
+    int two_step = std::min(a.two_step_,b.two_step_);
+    if ((a.two_min_-b.two_min_)%two_step!=0)
+      two_step = 2;
+    return AMInterval::FromTwiceValues(two_min, two_max, two_step);
+  }
+
+  constexpr inline
+  AMInterval AMIntervalCoupling(const AMInterval& a, const AMInterval& b)
+  // Obtain set of angular momenta to which some j1 in a and j2 in b couple
+  // (Minkowski sum under the triangle inequality).
+  //
+  // The result runs in steps of one from the least |j1-j2| to the greatest
+  // j1+j2, except when one interval is {0}, in which case coupling is
+  // trivial and the other interval is returned unchanged.
+  {
+    if (a.empty() || b.empty())
+      return AMInterval();
+    if ((a.two_min_==0) && (a.two_max_==0))
+      return b;
+    if ((b.two_min_==0) && (b.two_max_==0))
+      return a;
+    int two_min = 0;
+    if (a.two_min_>b.two_max_)
+      two_min = a.two_min_-b.two_max_;
+    else if (b.two_min_>a.two_max_)
+      two_min = b.two_min_-a.two_max_;
+    else if (!AMIntervalIntersection(a,b).empty())
+      two_min = 0;
+    else
+      two_min = ((a.two_min_+b.two_min_)%2==0) ? 2 : 1;
+    return AMInterval::FromTwiceValues(two_min, a.two_max_+b.two_max_, 2);
+  }
+
+#endif  // SWIG
+
   // Debugging: This fails...  Apparently need template?  To check
   // C++11 variadic syntax...
   //
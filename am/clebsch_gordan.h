@@ -0,0 +1,271 @@
+/****************************************************************
+  clebsch_gordan.h
+
+  Generates complete tables of Clebsch-Gordan coefficients
+  <j1 m1 j2 m2|J M>, for fixed (j1,j2,J), by recursion.
+
+  At fixed M, the coefficients C(m1)=<j1 m1 j2 M-m1|J M> satisfy the
+  three-term recursion obtained from the eigenvalue equation for J^2,
+
+    a(m1) b(m2-1) C(m1+1) + a(m1-1) b(m2) C(m1-1)
+      = [J(J+1)-j1(j1+1)-j2(j2+1)-2*m1*m2] C(m1),
+
+  where a(m)=sqrt((j1-m)(j1+m+1)) and b(m)=sqrt((j2-m)(j2+m+1)).  Following
+  Schulten and Gordon [J. Math. Phys. 16, 1961 (1975)], the recursion is run
+  inward from both ends of the m1 range, in the direction of increasing
+  magnitude, and the two solutions are matched in the classically allowed
+  region.  The row is then normalized, and the phase is fixed by the
+  Condon-Shortley convention, under which the coefficient with maximal m1 is
+  positive.
+
+  Within a row, coefficients are indexed by i1=j1+m1 (0<=i1<=2*j1), with
+  m2=M-m1 implied.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+
+****************************************************************/
+
+#ifndef AM_CLEBSCH_GORDAN_H_
+#define AM_CLEBSCH_GORDAN_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "am.h"
+
+namespace am {
+
+  class ClebschGordanRecursion
+  // Generator for rows of Clebsch-Gordan coefficients <j1 m1 j2 m2|J M> at
+  // fixed M, for M=J,J-1,...,-J.
+  //
+  // Only a single row of storage (of length 2*j1+1) is retained, so that the
+  // coefficients for all M may be consumed in recursion order without
+  // materializing the full table.
+  //
+  // Example:
+  //
+  //   for (am::ClebschGordanRecursion cg(j1,j2,J); !cg.done(); cg.Lower())
+  //     for (int i1=cg.i1_min(); i1<=cg.i1_max(); ++i1)
+  //       ... cg.M(), cg.m1(i1), cg[i1] ...
+  {
+   public:
+
+    ClebschGordanRecursion(const HalfInt& j1, const HalfInt& j2, const HalfInt& J)
+    // Set up recursion, positioned at stretched row M=J.
+    //
+    // If (j1,j2,J) does not satisfy the triangle condition, the generator is
+    // immediately done().
+      : ClebschGordanRecursion(j1,j2,J,J)
+    {}
+
+    ClebschGordanRecursion(
+        const HalfInt& j1, const HalfInt& j2, const HalfInt& J, const HalfInt& M
+      )
+    // Set up recursion, positioned at row M, for -J<=M<=J.
+      : two_j1_(TwiceValue(j1)), two_j2_(TwiceValue(j2)), two_J_(TwiceValue(J)),
+        two_M_(TwiceValue(M))
+    {
+      if ((abs(M)>J) || !IsInteger(J+M))
+        throw std::invalid_argument("invalid projection for ClebschGordanRecursion");
+      if ((two_j1_<0) || (two_j2_<0) || !AllowedTriangle(j1,j2,J))
+        {
+          two_M_ = -two_J_-2;
+          return;
+        }
+
+      // ladder factors a(i1)=sqrt((j1-m1)(j1+m1+1)), b(i2)=sqrt((j2-m2)(j2+m2+1)),
+      // padded with a zero entry at index -1
+      a_.assign(two_j1_+2, 0.);
+      b_.assign(two_j2_+2, 0.);
+      for (int i1=0; i1<=two_j1_; ++i1)
+        a_[i1+1] = std::sqrt(double((two_j1_-i1)*(i1+1)));
+      for (int i2=0; i2<=two_j2_; ++i2)
+        b_[i2+1] = std::sqrt(double((two_j2_-i2)*(i2+1)));
+      row_.assign(two_j1_+1, 0.);
+      backward_.assign(two_j1_+1, 0.);
+      casimir_ = (two_J_*(two_J_+2)-two_j1_*(two_j1_+2)-two_j2_*(two_j2_+2))/4.;
+
+      GenerateRow();
+    }
+
+    // current row
+    bool done() const {return two_M_<-two_J_;}
+    HalfInt M() const {return HalfInt(two_M_,2);}
+    int two_M() const {return two_M_;}
+    const double* row() const {return row_.data();}
+
+    // index range of nonvanishing entries in current row
+    int i1_min() const {return std::max(0, (two_j1_-two_j2_+two_M_)/2);}
+    int i1_max() const {return std::min(two_j1_, (two_j1_+two_j2_+two_M_)/2);}
+    HalfInt m1(int i1) const {return HalfInt(2*i1-two_j1_,2);}
+    HalfInt m2(int i1) const {return HalfInt(two_M_-2*i1+two_j1_,2);}
+
+    double operator[](int i1) const
+    // Coefficient <j1 m1 j2 M-m1|J M> in current row, for i1=j1+m1.
+    {
+      return row_[i1];
+    }
+
+    void Lower()
+    // Advance to row M-1.
+    {
+      if (done())
+        return;
+      std::fill(row_.begin()+i1_min(), row_.begin()+i1_max()+1, 0.);
+      two_M_ -= 2;
+      if (!done())
+        GenerateRow();
+    }
+
+    void Seek(const HalfInt& M)
+    // Position at row M, for -J<=M<=J.
+    //
+    // Has no effect if (j1,j2,J) does not satisfy the triangle condition.
+    {
+      const HalfInt J(two_J_,2);
+      if ((abs(M)>J) || !IsInteger(J+M))
+        throw std::invalid_argument("invalid projection for ClebschGordanRecursion::Seek");
+      if (row_.empty())
+        return;
+      std::fill(row_.begin(), row_.end(), 0.);
+      two_M_ = TwiceValue(M);
+      GenerateRow();
+    }
+
+   private:
+
+    int I2(int i1) const
+    // index i2=j2+m2 for given i1 in current row
+    {
+      return (two_j2_+two_M_+two_j1_)/2-i1;
+    }
+
+    // recursion coefficients for C(i1+1), C(i1), C(i1-1) at given i1
+    double A(int i1) const {return a_[i1+1]*b_[I2(i1)];}  // a(m1) b(m2-1)
+    double B(int i1) const {return a_[i1]*b_[I2(i1)+1];}  // a(m1-1) b(m2)
+    double D(int i1) const
+    {
+      return casimir_-(2*i1-two_j1_)*(two_M_-2*i1+two_j1_)/2.;
+    }
+
+    void GenerateRow()
+    // Evaluate current row by two-sided three-term recursion.
+    {
+      const int lo = i1_min();
+      const int hi = i1_max();
+
+      // forward recursion from lo, while magnitude increases
+      row_[lo] = 1.;
+      int i_forward = lo;
+      while (i_forward<hi)
+        {
+          const double previous = (i_forward>lo) ? row_[i_forward-1] : 0.;
+          row_[i_forward+1] = (D(i_forward)*row_[i_forward]-B(i_forward)*previous)/A(i_forward);
+          ++i_forward;
+          if (std::abs(row_[i_forward])<std::abs(row_[i_forward-1]))
+            break;
+        }
+
+      // backward recursion from hi, down to one below forward endpoint
+      if (i_forward<hi)
+        {
+          const int i_match = i_forward-1;
+          backward_[hi] = 1.;
+          for (int i1=hi; i1>i_match; --i1)
+            {
+              const double next = (i1<hi) ? backward_[i1+1] : 0.;
+              backward_[i1-1] = (D(i1)*backward_[i1]-A(i1)*next)/B(i1);
+            }
+
+          // match on overlap {i_match,i_match+1} by least squares
+          double overlap = 0., backward_norm = 0.;
+          for (int i1=i_match; i1<=i_forward; ++i1)
+            {
+              overlap += row_[i1]*backward_[i1];
+              backward_norm += backward_[i1]*backward_[i1];
+            }
+          const double scale = overlap/backward_norm;
+          for (int i1=i_match; i1<=hi; ++i1)
+            row_[i1] = scale*backward_[i1];
+        }
+
+      // normalize, with positive coefficient at maximal m1
+      double norm = 0.;
+      for (int i1=lo; i1<=hi; ++i1)
+        norm += row_[i1]*row_[i1];
+      norm = std::copysign(1./std::sqrt(norm), row_[hi]);
+      for (int i1=lo; i1<=hi; ++i1)
+        row_[i1] *= norm;
+    }
+
+    int two_j1_, two_j2_, two_J_, two_M_;
+    double casimir_ = 0.;
+    std::vector<double> row_, backward_;
+    std::vector<double> a_, b_;
+  };
+
+  class ClebschGordanTable
+  // Complete table of Clebsch-Gordan coefficients <j1 m1 j2 m2|J M> for fixed
+  // (j1,j2,J).
+  //
+  // Storage is a (2*j1+1)x(2*j2+1) array indexed by (i1,i2)=(j1+m1,j2+m2),
+  // with M=m1+m2 implied.  Entries with |M|>J vanish.  If (j1,j2,J) is not an
+  // allowed triangle, all entries vanish.
+  {
+   public:
+
+    ClebschGordanTable() = default;
+
+    ClebschGordanTable(const HalfInt& j1, const HalfInt& j2, const HalfInt& J)
+      : two_j1_(TwiceValue(j1)), two_j2_(TwiceValue(j2)), two_J_(TwiceValue(J)),
+        values_(std::size_t(TwiceValue(j1)+1)*(TwiceValue(j2)+1), 0.)
+    {
+      for (ClebschGordanRecursion cg(j1,j2,J); !cg.done(); cg.Lower())
+        for (int i1=cg.i1_min(); i1<=cg.i1_max(); ++i1)
+          {
+            const int i2 = (two_j2_+cg.two_M()+two_j1_)/2-i1;
+            values_[Index(i1,i2)] = cg[i1];
+          }
+    }
+
+    // angular momenta
+    HalfInt j1() const {return HalfInt(two_j1_,2);}
+    HalfInt j2() const {return HalfInt(two_j2_,2);}
+    HalfInt J() const {return HalfInt(two_J_,2);}
+
+    double Value(int i1, int i2) const
+    // Coefficient for i1=j1+m1, i2=j2+m2.
+    {
+      return values_[Index(i1,i2)];
+    }
+
+    double operator()(const HalfInt& m1, const HalfInt& m2) const
+    // Coefficient <j1 m1 j2 m2|J m1+m2>.
+    {
+      return Value((two_j1_+TwiceValue(m1))/2, (two_j2_+TwiceValue(m2))/2);
+    }
+
+    const std::vector<double>& values() const {return values_;}
+
+   private:
+
+    std::size_t Index(int i1, int i2) const
+    {
+      return std::size_t(i1)*(two_j2_+1)+i2;
+    }
+
+    int two_j1_ = 0, two_j2_ = 0, two_J_ = 0;
+    std::vector<double> values_;
+  };
+
+}  // namespace am
+
+#endif  // AM_CLEBSCH_GORDAN_H_
@@ -0,0 +1,176 @@
+/****************************************************************
+  coupling_transform.h
+
+  Applies the transformation between the uncoupled product basis
+  |j1 m1; j2 m2> and the coupled basis |j1 j2; J M> to vectors, without
+  forming the transformation matrix.
+
+  The Clebsch-Gordan coefficients are generated on the fly, one row (fixed J
+  and M) at a time, by recursion (see clebsch_gordan.h), stepping down in M
+  for each J, so that storage for coefficients is only one row per J, or
+  O((2*j1+1)*(2*min(j1,j2)+1)) per thread, as opposed to
+  [(2*j1+1)*(2*j2+1)]^2 for the dense transformation matrix.
+
+  Basis layout:
+
+    - uncoupled basis: |j1 m1; j2 m2> has index (j1+m1)*(2*j2+1)+(j2+m2)
+
+    - coupled basis: ordered by J=|j1-j2|,...,j1+j2, then by M=-J,...,J, so
+      |J M> has index offset(J)+(J+M)
+
+  Vectors are processed in batches, stored with the batch index running
+  fastest, i.e., component a of vector v is at position a*num_vectors+v.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Reuse one recursion per J across each range of M.
+
+****************************************************************/
+
+#ifndef AM_COUPLING_TRANSFORM_H_
+#define AM_COUPLING_TRANSFORM_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "am.h"
+#include "clebsch_gordan.h"
+#include "parallel.h"
+
+namespace am {
+
+  class CouplingTransform
+  // Transformation between uncoupled and coupled bases for j1 x j2.
+  {
+   public:
+
+    CouplingTransform(const HalfInt& j1, const HalfInt& j2)
+      : j1_(j1), j2_(j2), J_min_(abs(j1-j2)), J_max_(j1+j2)
+    {}
+
+    // angular momenta
+    HalfInt j1() const {return j1_;}
+    HalfInt j2() const {return j2_;}
+    HalfInt J_min() const {return J_min_;}
+    HalfInt J_max() const {return J_max_;}
+
+    std::size_t dimension() const
+    // Dimension of basis (uncoupled or coupled).
+    {
+      return std::size_t(dim(j1_))*dim(j2_);
+    }
+
+    std::size_t UncoupledIndex(const HalfInt& m1, const HalfInt& m2) const
+    // Index of |j1 m1; j2 m2> in uncoupled basis.
+    {
+      return std::size_t(int(j1_+m1))*dim(j2_)+int(j2_+m2);
+    }
+
+    std::size_t CoupledIndex(const HalfInt& J, const HalfInt& M) const
+    // Index of |j1 j2; J M> in coupled basis.
+    {
+      // offset(J) = sum_{J'=J_min}^{J-1} (2J'+1) = (J-J_min)*(J+J_min)
+      return std::size_t(int(J-J_min_))*TwiceValue(J+J_min_)/2 + int(J+M);
+    }
+
+    void Couple(std::size_t num_vectors, const double* uncoupled, double* coupled) const
+    // Transform batch of vectors from uncoupled basis to coupled basis.
+    //
+    //   coupled(J,M) = sum_{m1,m2} <j1 m1 j2 m2|J M> uncoupled(m1,m2)
+    //
+    // Arguments:
+    //   num_vectors (input): number of vectors in batch
+    //   uncoupled (input): vectors in uncoupled basis
+    //   coupled (output): vectors in coupled basis
+    {
+      Apply(num_vectors, uncoupled, coupled, /*forward=*/true);
+    }
+
+    void Uncouple(std::size_t num_vectors, const double* coupled, double* uncoupled) const
+    // Transform batch of vectors from coupled basis to uncoupled basis.
+    //
+    //   uncoupled(m1,m2) = sum_{J} <j1 m1 j2 m2|J M> coupled(J,M)
+    //
+    // Arguments:
+    //   num_vectors (input): number of vectors in batch
+    //   coupled (input): vectors in coupled basis
+    //   uncoupled (output): vectors in uncoupled basis
+    {
+      Apply(num_vectors, coupled, uncoupled, /*forward=*/false);
+    }
+
+   private:
+
+    void Apply(std::size_t num_vectors, const double* in, double* out, bool forward) const
+    // Apply transformation, in either direction.
+    //
+    // Work is distributed over contiguous ranges of M, since the components
+    // with different M are disjoint in both bases.  Each range keeps one
+    // Clebsch-Gordan recursion per J, which is positioned (by Seek) at the
+    // first M in the range at which it is needed, and then stepped down
+    // through the range (by Lower), so that coefficient storage is allocated
+    // once per range rather than once per (J,M).
+    {
+      const int num_M = TwiceValue(J_max_)+1;
+      const int num_J = int(J_max_-J_min_)+1;
+      const std::ptrdiff_t grain = std::max(1, num_M/(4*GetNumThreads()));
+      ParallelForRange(0, num_M, grain, [&](std::ptrdiff_t iM_begin, std::ptrdiff_t iM_end) {
+          std::vector<ClebschGordanRecursion> recursions;
+          recursions.reserve(num_J);
+          for (HalfInt J=J_min_; J<=J_max_; ++J)
+            recursions.emplace_back(j1_,j2_,J);
+
+          // M runs downward through range, in recursion order
+          for (std::ptrdiff_t iM=iM_end-1; iM>=iM_begin; --iM)
+            {
+              const HalfInt M = -J_max_+int(iM);
+
+              // clear uncoupled output components for this M
+              if (!forward)
+                for (HalfInt m1=-j1_; m1<=j1_; ++m1)
+                  {
+                    const HalfInt m2 = M-m1;
+                    if (abs(m2)>j2_)
+                      continue;
+                    double* target = out+UncoupledIndex(m1,m2)*num_vectors;
+                    std::fill(target, target+num_vectors, 0.);
+                  }
+
+              for (HalfInt J=std::max(J_min_,abs(M)); J<=J_max_; ++J)
+                {
+                  ClebschGordanRecursion& cg = recursions[int(J-J_min_)];
+                  if (cg.two_M()==TwiceValue(M)+2)
+                    cg.Lower();
+                  else if (cg.two_M()!=TwiceValue(M))
+                    cg.Seek(M);
+                  const std::size_t coupled_index = CoupledIndex(J,M);
+                  if (forward)
+                    std::fill(out+coupled_index*num_vectors, out+(coupled_index+1)*num_vectors, 0.);
+                  for (int i1=cg.i1_min(); i1<=cg.i1_max(); ++i1)
+                    {
+                      const double coefficient = cg[i1];
+                      const std::size_t uncoupled_index = UncoupledIndex(cg.m1(i1),cg.m2(i1));
+                      const double* x = forward
+                        ? in+uncoupled_index*num_vectors
+                        : in+coupled_index*num_vectors;
+                      double* y = forward
+                        ? out+coupled_index*num_vectors
+                        : out+uncoupled_index*num_vectors;
+                      for (std::size_t v=0; v<num_vectors; ++v)
+                        y[v] += coefficient*x[v];
+                    }
+                }
+            }
+        });
+    }
+
+    HalfInt j1_, j2_, J_min_, J_max_;
+  };
+
+}  // namespace am
+
+#endif  // AM_COUPLING_TRANSFORM_H_
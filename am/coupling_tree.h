@@ -0,0 +1,510 @@
+/****************************************************************
+  coupling_tree.h
+
+  Defines am::CouplingTree, a binary coupling scheme for n angular momenta,
+  e.g., the sequential scheme (((j1 j2)J12 j3)J123 j4)J, and enumeration of
+  the intermediate angular momenta compatible with given leaf angular
+  momenta and total angular momentum.
+
+  Nodes are numbered with the leaves first (0,...,n-1), followed by the
+  internal (coupled) nodes (n,...,2n-2), where each internal node is
+  numbered after its children, so that the root is the last node.
+
+  The enumeration (CouplingTreeStates) provides:
+
+    - the number of states, obtained by propagating multiplicity
+      distributions up the tree, without enumerating the states;
+
+    - iteration in lexicographic order of the internal node angular
+      momenta, where the iterator holds only the current assignment of node
+      angular momenta, and advancing it requires no recursion (stack) or
+      allocation;
+
+    - random access by index, and division into balanced chunks, e.g., for
+      parallel workers.
+
+  Selection rules, given as AMInterval ranges of leaf and total angular
+  momenta, may also be propagated through the tree (PropagateIntervals), to
+  bound the intermediate angular momenta before any enumeration.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Fix count for single leaf, and disallow iterators into
+    temporary CouplingTreeStates.
+  + 10/18/26: Reject invalid chunk in CouplingTreeStates::Chunk.
+
+****************************************************************/
+
+#ifndef AM_COUPLING_TREE_H_
+#define AM_COUPLING_TREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "am.h"
+#include "halfint.h"
+
+namespace am {
+
+  class CouplingTreeStates;
+
+  class CouplingTree
+  // Binary coupling scheme.
+  {
+   public:
+
+    CouplingTree() : num_leaves_(0) {}
+
+    CouplingTree(
+        std::size_t num_leaves,
+        const std::vector<std::pair<std::size_t,std::size_t>>& couplings
+      )
+    // Construct coupling tree from list of couplings.
+    //
+    // Arguments:
+    //   num_leaves (input): number of angular momenta to couple
+    //   couplings (input): children of internal nodes n,...,2n-2, each
+    //     numbered lower than its parent
+    //
+    // Throws std::invalid_argument if the couplings do not define a binary
+    // tree.
+      : num_leaves_(num_leaves)
+    {
+      if (num_leaves==0)
+        throw std::invalid_argument("CouplingTree requires at least one leaf");
+      if (couplings.size()!=num_leaves-1)
+        throw std::invalid_argument("CouplingTree requires n-1 couplings for n leaves");
+      std::vector<bool> used(2*num_leaves-1, false);
+      for (std::size_t i=0; i<couplings.size(); ++i)
+        {
+          const std::size_t node = num_leaves+i;
+          for (std::size_t child : {couplings[i].first, couplings[i].second})
+            {
+              if ((child>=node) || used[child])
+                throw std::invalid_argument("invalid coupling in CouplingTree");
+              used[child] = true;
+            }
+          left_.push_back(couplings[i].first);
+          right_.push_back(couplings[i].second);
+        }
+    }
+
+    static CouplingTree Sequential(std::size_t num_leaves)
+    // Sequential coupling scheme (((j1 j2)J12 j3)J123 ...)J.
+    {
+      std::vector<std::pair<std::size_t,std::size_t>> couplings;
+      for (std::size_t i=1; i<num_leaves; ++i)
+        couplings.emplace_back((i==1) ? 0 : num_leaves+i-2, i);
+      return CouplingTree(num_leaves, couplings);
+    }
+
+    static CouplingTree Pairwise(std::size_t num_leaves)
+    // Pairwise coupling scheme, e.g., ((j1 j2)J12 (j3 j4)J34)J, in which
+    // adjacent nodes are coupled level by level.
+    {
+      std::vector<std::pair<std::size_t,std::size_t>> couplings;
+      std::vector<std::size_t> level(num_leaves);
+      for (std::size_t i=0; i<num_leaves; ++i)
+        level[i] = i;
+      while (level.size()>1)
+        {
+          std::vector<std::size_t> next_level;
+          for (std::size_t i=0; i+1<level.size(); i+=2)
+            {
+              couplings.emplace_back(level[i], level[i+1]);
+              next_level.push_back(num_leaves+couplings.size()-1);
+            }
+          if (level.size()%2==1)
+            next_level.push_back(level.back());
+          level = std::move(next_level);
+        }
+      return CouplingTree(num_leaves, couplings);
+    }
+
+    // structure
+    std::size_t num_leaves() const {return num_leaves_;}
+    std::size_t num_nodes() const {return (num_leaves_==0) ? 0 : 2*num_leaves_-1;}
+    std::size_t root() const {return num_nodes()-1;}
+    bool IsLeaf(std::size_t node) const {return node<num_leaves_;}
+    std::size_t left(std::size_t node) const {return left_.at(node-num_leaves_);}
+    std::size_t right(std::size_t node) const {return right_.at(node-num_leaves_);}
+
+    std::vector<AMInterval> PropagateIntervals(
+        const std::vector<AMInterval>& leaves, const AMInterval& J
+      ) const
+    // Propagate selection rules through tree, to bound the angular momenta
+    // possible at each node.
+    //
+    // The intervals are first coupled up the tree, and the root is
+    // restricted to J.  Then, down the tree, each child is restricted to the
+    // angular momenta which can couple with its sibling to its parent.  The
+    // resulting intervals are a conservative bound: every state has its node
+    // angular momenta within them, and, if any is empty, there are no states.
+    //
+    // Arguments:
+    //   leaves (input): allowed values of leaf angular momenta
+    //   J (input): allowed values of total angular momentum
+    //
+    // Returns:
+    //   (std::vector<AMInterval>): allowed values for each node
+    {
+      if (leaves.size()!=num_leaves_)
+        throw std::invalid_argument("number of intervals does not match CouplingTree");
+      std::vector<AMInterval> intervals(leaves);
+      intervals.resize(num_nodes());
+      for (std::size_t node=num_leaves_; node<num_nodes(); ++node)
+        intervals[node] = AMIntervalCoupling(intervals[left(node)], intervals[right(node)]);
+      intervals[root()] = AMIntervalIntersection(intervals[root()], J);
+      for (std::size_t node=num_nodes(); node-->num_leaves_; )
+        {
+          const std::size_t a = left(node), b = right(node);
+          const AMInterval a_allowed = AMIntervalCoupling(intervals[node], intervals[b]);
+          const AMInterval b_allowed = AMIntervalCoupling(intervals[node], intervals[a]);
+          intervals[a] = AMIntervalIntersection(intervals[a], a_allowed);
+          intervals[b] = AMIntervalIntersection(intervals[b], b_allowed);
+        }
+      for (const AMInterval& interval : intervals)
+        if (interval.empty())
+          return std::vector<AMInterval>(num_nodes());
+      return intervals;
+    }
+
+    // enumeration
+    std::uint64_t Count(const HalfInt::vector& leaves, const HalfInt& J) const;
+    CouplingTreeStates States(const HalfInt::vector& leaves, const HalfInt& J) const;
+
+   private:
+
+    friend class CouplingTreeStates;
+
+    std::uint64_t CountCompletions(
+        const std::vector<int>& two_values, std::size_t num_fixed, int two_J
+      ) const
+    // Count assignments of nodes num_fixed,...,2n-3 consistent with the
+    // fixed values of nodes 0,...,num_fixed-1 and root value 2J.
+    //
+    // Multiplicity distributions are propagated up the tree, with the
+    // contribution of each pair of child values added over the triangle
+    // range by difference array.
+    {
+      struct Distribution {int two_min; std::vector<std::uint64_t> counts;};
+      std::vector<Distribution> distributions(num_nodes());
+      for (std::size_t node=0; node<num_nodes(); ++node)
+        {
+          Distribution& distribution = distributions[node];
+          if (IsLeaf(node) || ((node<num_fixed) && (node!=root())))
+            {
+              distribution = {two_values[node], {1}};
+              continue;
+            }
+          const Distribution& a = distributions[left(node)];
+          const Distribution& b = distributions[right(node)];
+          const int a_max = a.two_min+2*int(a.counts.size()-1);
+          const int b_max = b.two_min+2*int(b.counts.size()-1);
+          const int two_max = a_max+b_max;
+          const int two_min = TriangleMinimum(a.two_min, a_max, b.two_min, b_max);
+          std::vector<std::uint64_t> difference((two_max-two_min)/2+2, 0);
+          for (std::size_t ia=0; ia<a.counts.size(); ++ia)
+            for (std::size_t ib=0; ib<b.counts.size(); ++ib)
+              {
+                const std::uint64_t weight = a.counts[ia]*b.counts[ib];
+                if (weight==0)
+                  continue;
+                const int two_a = a.two_min+2*int(ia), two_b = b.two_min+2*int(ib);
+                difference[(std::abs(two_a-two_b)-two_min)/2] += weight;
+                difference[(two_a+two_b-two_min)/2+1] -= weight;
+              }
+          distribution.two_min = two_min;
+          distribution.counts.resize(difference.size()-1);
+          std::uint64_t running = 0;
+          for (std::size_t i=0; i<distribution.counts.size(); ++i)
+            distribution.counts[i] = (running += difference[i]);
+        }
+      const Distribution& distribution = distributions[root()];
+      const int offset = two_J-distribution.two_min;
+      if ((offset<0) || (offset%2!=0) || (offset/2>=int(distribution.counts.size())))
+        return 0;
+      return distribution.counts[offset/2];
+    }
+
+    bool Feasible(
+        const std::vector<int>& two_values, std::size_t num_fixed, int two_J,
+        std::vector<int>& two_min, std::vector<int>& two_max
+      ) const
+    // Determine whether the fixed values of nodes 0,...,num_fixed-1 admit an
+    // assignment of the remaining internal nodes reaching root value 2J.
+    //
+    // The set of angular momenta reachable at a node is a contiguous range,
+    // in steps of one, so only its bounds need be propagated.
+    {
+      for (std::size_t node=0; node<num_nodes(); ++node)
+        {
+          if (IsLeaf(node) || ((node<num_fixed) && (node!=root())))
+            {
+              two_min[node] = two_max[node] = two_values[node];
+              continue;
+            }
+          const std::size_t a = left(node), b = right(node);
+          two_max[node] = two_max[a]+two_max[b];
+          two_min[node] = TriangleMinimum(two_min[a], two_max[a], two_min[b], two_max[b]);
+        }
+      return (two_J>=two_min[root()]) && (two_J<=two_max[root()]) && ((two_J-two_min[root()])%2==0);
+    }
+
+    static int TriangleMinimum(int a_min, int a_max, int b_min, int b_max)
+    // Minimum of |a-b| over twice-value ranges a and b.
+    {
+      if (a_min>b_max)
+        return a_min-b_max;
+      if (b_min>a_max)
+        return b_min-a_max;
+      return (a_min+b_min)&1;
+    }
+
+    std::size_t num_leaves_;
+    std::vector<std::size_t> left_, right_;
+  };
+
+  class CouplingTreeStates
+  // States of coupling tree for given leaf angular momenta and total angular
+  // momentum.
+  //
+  // Example:
+  //
+  //   am::CouplingTreeStates states = am::CouplingTree::Sequential(4).States(j, J);
+  //   for (const am::CouplingTreeStates::State& state : states)
+  //     ... state.J(4) ...  // J12
+  //
+  //   am::ParallelFor(0, num_chunks, [&](std::ptrdiff_t k) {
+  //       for (const auto& state : states.Chunk(k, num_chunks))
+  //         ...
+  //     });
+  {
+   public:
+
+    class State
+    // Assignment of angular momenta to all nodes of tree.
+    {
+     public:
+      HalfInt J(std::size_t node) const {return HalfInt(two_values_[node],2);}
+      int TwiceJ(std::size_t node) const {return two_values_[node];}
+      const std::vector<int>& twice_values() const {return two_values_;}
+
+     private:
+      friend class CouplingTreeStates;
+      std::vector<int> two_values_;
+    };
+
+    class iterator
+    {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = State;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const State*;
+      using reference = const State&;
+
+      iterator() : states_(nullptr), index_(0) {}
+
+      const State& operator*() const {return state_;}
+      const State* operator->() const {return &state_;}
+      iterator& operator++()
+      {
+        ++index_;
+        if (index_<states_->size())
+          states_->Advance(state_.two_values_, two_min_, two_max_);
+        return *this;
+      }
+      iterator operator++(int) {iterator it = *this; ++(*this); return it;}
+
+      // iterators over the same enumeration compare by position
+      bool operator==(const iterator& other) const {return index_==other.index_;}
+      bool operator!=(const iterator& other) const {return index_!=other.index_;}
+
+      std::uint64_t index() const {return index_;}
+
+     private:
+      friend class CouplingTreeStates;
+      iterator(const CouplingTreeStates* states, std::uint64_t index)
+        : states_(states), index_(index)
+      {}
+
+      const CouplingTreeStates* states_;
+      std::uint64_t index_;
+      State state_;
+      std::vector<int> two_min_, two_max_;
+    };
+
+    class Range
+    // Contiguous range of states.
+    //
+    // Refers to the CouplingTreeStates object, which must outlive it.
+    {
+     public:
+      Range(iterator first, iterator last) : begin_(first), end_(last) {}
+      iterator begin() const {return begin_;}
+      iterator end() const {return end_;}
+      std::uint64_t size() const {return end_.index()-begin_.index();}
+     private:
+      iterator begin_, end_;
+    };
+
+    using value_type = State;
+    using const_iterator = iterator;
+
+    CouplingTreeStates(const CouplingTree& tree, const HalfInt::vector& leaves, const HalfInt& J)
+    // Set up enumeration.
+    //
+    // Throws std::invalid_argument if the number of leaf angular momenta does
+    // not match the tree.
+      : tree_(tree), two_J_(TwiceValue(J))
+    {
+      if (leaves.size()!=tree.num_leaves())
+        throw std::invalid_argument("number of angular momenta does not match CouplingTree");
+      for (const HalfInt& j : leaves)
+        {
+          if (j<0)
+            throw std::invalid_argument("negative angular momentum in CouplingTree");
+          two_leaves_.push_back(TwiceValue(j));
+        }
+      if (tree_.num_leaves()==1)
+        {
+          // root is the leaf itself
+          size_ = (two_leaves_[0]==two_J_) ? 1 : 0;
+          return;
+        }
+      std::vector<int> two_values = InitialValues();
+      size_ = (two_J_<0) ? 0 : tree_.CountCompletions(two_values, tree_.num_leaves(), two_J_);
+    }
+
+    // accessors
+    const CouplingTree& tree() const {return tree_;}
+    std::uint64_t size() const {return size_;}
+    bool empty() const {return size_==0;}
+
+    // iteration
+    //
+    // Iterators (and ranges of iterators) refer to the CouplingTreeStates
+    // object, which must outlive them.  These functions are therefore not
+    // available on temporaries, e.g., tree.States(leaves,J).Chunk(k,n) does
+    // not compile, and the States must first be held in a variable.  (A
+    // range-based for loop over tree.States(leaves,J) itself is safe, since
+    // the loop holds the temporary.)
+    iterator begin() const& {return at(0);}
+    iterator end() const& {return iterator(this, size_);}
+    iterator begin() && = delete;
+    iterator end() && = delete;
+
+    iterator at(std::uint64_t index) const&
+    // Iterator to state with given lexicographic index, or end.
+    //
+    // The state is located by counting completions of successive prefixes,
+    // so random access costs a small number of multiplicity propagations per
+    // internal node.
+    {
+      if (index>=size_)
+        return end();
+      iterator it(this, index);
+      it.state_.two_values_ = InitialValues();
+      it.two_min_.resize(tree_.num_nodes());
+      it.two_max_.resize(tree_.num_nodes());
+      std::vector<int>& two_values = it.state_.two_values_;
+      for (std::size_t node=tree_.num_leaves(); node+1<tree_.num_nodes(); ++node)
+        {
+          const int two_a = two_values[tree_.left(node)], two_b = two_values[tree_.right(node)];
+          for (int two=std::abs(two_a-two_b); two<=two_a+two_b; two+=2)
+            {
+              two_values[node] = two;
+              const std::uint64_t count = tree_.CountCompletions(two_values, node+1, two_J_);
+              if (index<count)
+                break;
+              index -= count;
+            }
+        }
+      return it;
+    }
+    iterator at(std::uint64_t index) && = delete;
+
+    Range Chunk(std::size_t k, std::size_t num_chunks) const&
+    // Chunk k of num_chunks, with sizes differing by at most one.
+    //
+    // Throws std::invalid_argument unless 0<=k<num_chunks.
+    {
+      if (k>=num_chunks)
+        throw std::invalid_argument("invalid chunk of CouplingTreeStates");
+      const std::uint64_t base = size_/num_chunks, extra = size_%num_chunks;
+      const std::uint64_t first = base*k+std::min<std::uint64_t>(k, extra);
+      const std::uint64_t last = first+base+((k<extra) ? 1 : 0);
+      return Range(at(first), (last>=size_) ? end() : iterator(this, last));
+    }
+    Range Chunk(std::size_t k, std::size_t num_chunks) && = delete;
+
+   private:
+
+    std::vector<int> InitialValues() const
+    {
+      std::vector<int> two_values(tree_.num_nodes(), 0);
+      std::copy(two_leaves_.begin(), two_leaves_.end(), two_values.begin());
+      if (tree_.num_leaves()>1)
+        two_values[tree_.root()] = two_J_;
+      return two_values;
+    }
+
+    void Advance(std::vector<int>& two_values, std::vector<int>& two_min, std::vector<int>& two_max) const
+    // Advance assignment to lexicographic successor.
+    //
+    // The last internal node which can be incremented, consistent with some
+    // completion, is incremented, and the subsequent nodes are reset to their
+    // least consistent values.
+    {
+      const std::size_t first_node = tree_.num_leaves(), last_node = tree_.num_nodes()-1;
+      for (std::size_t node=last_node; node-->first_node; )
+        {
+          const int two_a = two_values[tree_.left(node)], two_b = two_values[tree_.right(node)];
+          for (two_values[node]+=2; two_values[node]<=two_a+two_b; two_values[node]+=2)
+            if (tree_.Feasible(two_values, node+1, two_J_, two_min, two_max))
+              {
+                for (std::size_t later=node+1; later<last_node; ++later)
+                  {
+                    const int two_c = two_values[tree_.left(later)], two_d = two_values[tree_.right(later)];
+                    two_values[later] = std::abs(two_c-two_d);
+                    while (!tree_.Feasible(two_values, later+1, two_J_, two_min, two_max))
+                      two_values[later] += 2;
+                  }
+                return;
+              }
+        }
+    }
+
+    CouplingTree tree_;
+    std::vector<int> two_leaves_;
+    int two_J_;
+    std::uint64_t size_;
+  };
+
+  inline
+  std::uint64_t CouplingTree::Count(const HalfInt::vector& leaves, const HalfInt& J) const
+  // Count states for given leaf angular momenta and total angular momentum.
+  {
+    return CouplingTreeStates(*this, leaves, J).size();
+  }
+
+  inline
+  CouplingTreeStates CouplingTree::States(const HalfInt::vector& leaves, const HalfInt& J) const
+  // Enumerate states for given leaf angular momenta and total angular momentum.
+  {
+    return CouplingTreeStates(*this, leaves, J);
+  }
+
+}  // namespace am
+
+#endif  // AM_COUPLING_TREE_H_
@@ -0,0 +1,254 @@
+/****************************************************************
+  factor_table.h
+
+  Tabulated angular momentum factors, indexed by twice-value 2j:
+
+    Hat(j) = sqrt(2j+1)
+    InverseHat(j) = 1/sqrt(2j+1)
+    SqrtJJ1(j) = sqrt(j(j+1))
+    SqrtJJ1Hat(j) = sqrt(j(j+1)(2j+1))
+
+  The entries for 0<=2j<kFactorTableStaticSize are generated at compile time
+  (constexpr).  Larger arguments are served from a process-wide table, which
+  grows lazily, in blocks, as arguments are encountered.  Blocks are never
+  moved or freed once allocated, so lookup is lock-free, and only the
+  allocation of a new block is serialized.  Arguments beyond the table
+  capacity, or negative arguments, are evaluated directly.
+
+  All entries are obtained from the same integer-argument expressions, with a
+  correctly rounded square root (std::sqrt at run time, or a constexpr
+  equivalent at compile time), so the tabulated values are identical to
+  those obtained directly, e.g., by Hat() in halfint.h.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+
+****************************************************************/
+
+#ifndef AM_FACTOR_TABLE_H_
+#define AM_FACTOR_TABLE_H_
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+#include "halfint.h"
+
+namespace am {
+
+  enum class FactorType {kHat, kInverseHat, kSqrtJJ1, kSqrtJJ1Hat};
+
+  // number of compile-time entries (2j<kFactorTableStaticSize)
+  constexpr int kFactorTableStaticSize = 256;
+
+  // capacity of lazily grown table (2j<kFactorTableCapacity)
+  constexpr int kFactorTableCapacity = 1<<20;
+
+  namespace detail {
+
+    constexpr inline
+    double ConstexprSquareResidual(double x, double c)
+    // Residual x-c^2, with c^2 evaluated exactly as a sum of two doubles
+    // (Dekker product, with Veltkamp splitting).
+    {
+      constexpr double kSplit = 134217729.;  // 2^27+1
+      const double t = kSplit*c;
+      const double c_hi = t-(t-c), c_lo = c-c_hi;
+      const double p = c*c;
+      const double e = ((c_hi*c_hi-p)+2*c_hi*c_lo)+c_lo*c_lo;
+      return (x-p)-e;
+    }
+
+    constexpr inline
+    double ConstexprSqrt(double x)
+    // Square root of nonnegative x, usable in constant expressions.
+    //
+    // Newton iteration is followed by selection, among the result and its
+    // neighboring doubles, of the value with least residual, so that the
+    // result agrees with the correctly rounded std::sqrt.
+    {
+      if (x<=0.)
+        return 0.;
+      double c = (x+1)/2;  // >=sqrt(x)
+      for (int iteration=0; iteration<1024; ++iteration)
+        {
+          const double c_next = (c+x/c)/2;
+          if (!(c_next<c))
+            break;
+          c = c_next;
+        }
+
+      // neighboring doubles
+      double power = 1.;
+      while (power*2<=c)
+        power *= 2;
+      while (power>c)
+        power /= 2;
+      const double ulp = power/4503599627370496.;  // 2^52
+      const double candidates[3] = {(c==power) ? c-ulp/2 : c-ulp, c, c+ulp};
+      double best = c;
+      for (double candidate : candidates)
+        {
+          const double r_candidate = ConstexprSquareResidual(x, candidate);
+          const double r_best = ConstexprSquareResidual(x, best);
+          if (((r_candidate<0) ? -r_candidate : r_candidate) < ((r_best<0) ? -r_best : r_best))
+            best = candidate;
+        }
+      return best;
+    }
+
+    template<typename Sqrt>
+    constexpr inline
+    double FactorValue(FactorType type, int two_j, Sqrt sqrt)
+    // Evaluate factor from integer expression, with given square root
+    // function.
+    {
+      const double d = two_j;
+      switch (type)
+        {
+        case FactorType::kHat:
+          return sqrt(d+1);
+        case FactorType::kInverseHat:
+          return 1./sqrt(d+1);
+        case FactorType::kSqrtJJ1:
+          return sqrt(d*(d+2))/2;
+        default:
+          return sqrt(d*(d+2)*(d+1))/2;
+        }
+    }
+
+    inline
+    double FactorValue(FactorType type, int two_j)
+    // Evaluate factor at run time.
+    {
+      return FactorValue(type, two_j, [](double x) {return std::sqrt(x);});
+    }
+
+    template<FactorType type>
+    struct StaticFactorTable
+    // Compile-time table for 0<=2j<kFactorTableStaticSize.
+    {
+      static constexpr std::array<double,kFactorTableStaticSize> Generate()
+      {
+        std::array<double,kFactorTableStaticSize> values{};
+        for (int two_j=0; two_j<kFactorTableStaticSize; ++two_j)
+          values[two_j] = FactorValue(type, two_j, ConstexprSqrt);
+        return values;
+      }
+
+      static constexpr std::array<double,kFactorTableStaticSize> values = Generate();
+    };
+
+    template<FactorType type>
+    class LazyFactorTable
+    // Process-wide table for 0<=2j<kFactorTableCapacity, allocated in blocks
+    // on first use.
+    {
+     public:
+
+      static constexpr int kBlockBits = 12;
+      static constexpr int kBlockSize = 1<<kBlockBits;
+      static constexpr int kNumBlocks = kFactorTableCapacity/kBlockSize;
+
+      static LazyFactorTable& Instance()
+      {
+        static LazyFactorTable table;
+        return table;
+      }
+
+      double operator()(int two_j)
+      {
+        const double* block = blocks_[two_j>>kBlockBits].load(std::memory_order_acquire);
+        if (!block)
+          block = Allocate(two_j>>kBlockBits);
+        return block[two_j&(kBlockSize-1)];
+      }
+
+      void Reserve(int two_j_max)
+      // Allocate blocks through given 2j.
+      {
+        for (int b=0; (b<kNumBlocks) && (b<=(two_j_max>>kBlockBits)); ++b)
+          if (!blocks_[b].load(std::memory_order_acquire))
+            Allocate(b);
+      }
+
+      std::size_t num_blocks() const
+      {
+        std::size_t count = 0;
+        for (const auto& block : blocks_)
+          count += (block.load(std::memory_order_relaxed)!=nullptr);
+        return count;
+      }
+
+     private:
+
+      LazyFactorTable() = default;
+
+      const double* Allocate(int b)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!storage_[b])
+          {
+            storage_[b].reset(new double[kBlockSize]);
+            for (int i=0; i<kBlockSize; ++i)
+              storage_[b][i] = FactorValue(type, b*kBlockSize+i);
+            blocks_[b].store(storage_[b].get(), std::memory_order_release);
+          }
+        return storage_[b].get();
+      }
+
+      std::array<std::atomic<const double*>,kNumBlocks> blocks_{};
+      std::array<std::unique_ptr<double[]>,kNumBlocks> storage_;
+      std::mutex mutex_;
+    };
+
+  }  // namespace detail
+
+  template<FactorType type>
+  inline
+  double TabulatedFactor2(int two_j)
+  // Look up factor by twice-value 2j.
+  {
+    if ((two_j>=0) && (two_j<kFactorTableStaticSize))
+      return detail::StaticFactorTable<type>::values[two_j];
+    if ((two_j>=0) && (two_j<kFactorTableCapacity))
+      return detail::LazyFactorTable<type>::Instance()(two_j);
+    return detail::FactorValue(type, two_j);
+  }
+
+  inline
+  void ReserveFactorTables(int two_j_max)
+  // Grow factor tables in advance through given 2j, e.g., before entering a
+  // parallel region.
+  {
+    detail::LazyFactorTable<FactorType::kHat>::Instance().Reserve(two_j_max);
+    detail::LazyFactorTable<FactorType::kInverseHat>::Instance().Reserve(two_j_max);
+    detail::LazyFactorTable<FactorType::kSqrtJJ1>::Instance().Reserve(two_j_max);
+    detail::LazyFactorTable<FactorType::kSqrtJJ1Hat>::Instance().Reserve(two_j_max);
+  }
+
+  // sqrt(2j+1)
+  inline double TabulatedHat2(int two_j) {return TabulatedFactor2<FactorType::kHat>(two_j);}
+  inline double TabulatedHat(const HalfInt& j) {return TabulatedHat2(TwiceValue(j));}
+
+  // 1/sqrt(2j+1)
+  inline double TabulatedInverseHat2(int two_j) {return TabulatedFactor2<FactorType::kInverseHat>(two_j);}
+  inline double TabulatedInverseHat(const HalfInt& j) {return TabulatedInverseHat2(TwiceValue(j));}
+
+  // sqrt(j(j+1))
+  inline double TabulatedSqrtJJ12(int two_j) {return TabulatedFactor2<FactorType::kSqrtJJ1>(two_j);}
+  inline double TabulatedSqrtJJ1(const HalfInt& j) {return TabulatedSqrtJJ12(TwiceValue(j));}
+
+  // sqrt(j(j+1)(2j+1))
+  inline double TabulatedSqrtJJ1Hat2(int two_j) {return TabulatedFactor2<FactorType::kSqrtJJ1Hat>(two_j);}
+  inline double TabulatedSqrtJJ1Hat(const HalfInt& j) {return TabulatedSqrtJJ1Hat2(TwiceValue(j));}
+
+}  // namespace am
+
+#endif  // AM_FACTOR_TABLE_H_
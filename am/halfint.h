@@ -92,6 +92,9 @@
     - Inline halfint.cpp to make library pure header.
     - Add min(), max(), and minmax() functions for ADL.
   09/19/24 (pjf): Add constructor for using HalfInt numerator.
+  10/18/26: Add BasicHalfInt<T> compact storage types HalfInt8 and HalfInt16.
+  10/18/26: Add to_chars() and from_chars(), and reimplement Str() and stream
+    output on top of them; add stream input.
 ****************************************************************/
 
 #ifndef HALFINT_H_
@@ -100,13 +103,17 @@
 #include <cmath> // for sqrt
 #include <cstdlib>
 #include <algorithm>
+#include <charconv>
 #include <complex>
+#include <cstdint>
 #include <functional>  // for hash
 #include <iostream>
 #include <limits>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <stdexcept>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -253,17 +260,10 @@ class HalfInt
   // string conversion
   ////////////////////////////////////////////////////////////////
 
-  inline std::string Str() const
-  {
-    std::ostringstream ss;
-
-    if (IsInteger())
-      ss << twice_value_/2;
-    else
-      ss << twice_value_ << "/2";
-
-    return ss.str();
-  }
+  // EX: HalfInt(3) -> "3", HalfInt(3,2) -> "3/2"
+  //
+  // See also to_chars() for conversion without allocation.
+  inline std::string Str() const;
 
   ////////////////////////////////////////////////////////////////
   // data
@@ -532,6 +532,20 @@ struct std::hash<HalfInt>
 };
 
 
+////////////////////////////////////////////////////////////////
+// compact storage types (forward declaration)
+////////////////////////////////////////////////////////////////
+
+#ifndef SWIG
+template<typename T> class BasicHalfInt;
+
+// test for HalfInt or compact storage type BasicHalfInt<T>
+template<typename T> struct is_halfint : std::false_type {};
+template<> struct is_halfint<HalfInt> : std::true_type {};
+template<typename T> struct is_halfint<BasicHalfInt<T>> : std::true_type {};
+template<typename T> inline constexpr bool is_halfint_v = is_halfint<T>::value;
+#endif  // SWIG
+
 ////////////////////////////////////////////////////////////////
 // arithmetic functions
 ////////////////////////////////////////////////////////////////
@@ -541,7 +555,7 @@ template<
     typename R = typename std::common_type_t<Ts...>,
     std::enable_if_t<
 #ifndef SWIG
-        (std::is_same_v<typename std::decay_t<Ts>,HalfInt> || ...) &&
+        (is_halfint_v<typename std::decay_t<Ts>> || ...) &&
 #endif
         (std::is_constructible_v<HalfInt, R>
         || std::is_convertible_v<R, HalfInt>)
@@ -558,7 +572,7 @@ template<
     typename R = typename std::common_type_t<Ts...>,
     std::enable_if_t<
 #ifndef SWIG
-        (std::is_same_v<typename std::decay_t<Ts>,HalfInt> || ...) &&
+        (is_halfint_v<typename std::decay_t<Ts>> || ...) &&
 #endif
         (std::is_constructible_v<HalfInt, R>
         || std::is_convertible_v<R, HalfInt>)
@@ -575,7 +589,7 @@ template<
     typename R = typename std::common_type_t<Ts...>,
     std::enable_if_t<
 #ifndef SWIG
-        (std::is_same_v<typename std::decay_t<Ts>,HalfInt> || ...) &&
+        (is_halfint_v<typename std::decay_t<Ts>> || ...) &&
 #endif
         (std::is_constructible_v<HalfInt, R>
         || std::is_convertible_v<R, HalfInt>)
@@ -705,21 +719,327 @@ std::complex<double> Phase(const HalfInt& sum)
 }
 
 ////////////////////////////////////////////////////////////////
-// stream output
+// character conversion
+////////////////////////////////////////////////////////////////
+
+// These follow the conventions of std::to_chars and std::from_chars: The
+// caller supplies the buffer, nothing is allocated, and errors are reported
+// through the returned std::errc, rather than by exceptions.
+
+#ifndef SWIG
+// maximum number of characters written by to_chars
+//
+// EX: "-1073741824.0" or "-2147483648/2"
+constexpr int kHalfIntMaxChars = 13;
+
+inline
+std::to_chars_result to_chars(char* first, char* last, const HalfInt& h, char presentation='g')
+// Write textual representation of HalfInt into buffer [first,last).
+//
+// Presentations:
+//   'g': "3" for integer values, "3/2" for half-integer values
+//   'f': decimal form, "3.0" or "1.5"
+//   'd': integer form "3" (fails with std::errc::invalid_argument for
+//     half-integer values)
+//
+// Returns:
+//   (std::to_chars_result): pointer past last character written, and error
+//     code (std::errc::value_too_large if buffer is too small)
+{
+  const int twice_value = h.TwiceValue();
+  if ((presentation=='d') && !h.IsInteger())
+    return {first, std::errc::invalid_argument};
+
+  if ((presentation!='f') && !h.IsInteger())
+    {
+      // fraction form
+      std::to_chars_result result = std::to_chars(first, last, twice_value);
+      if (result.ec!=std::errc())
+        return result;
+      if (last-result.ptr<2)
+        return {last, std::errc::value_too_large};
+      *result.ptr++ = '/';
+      *result.ptr++ = '2';
+      return result;
+    }
+
+  // integer or decimal form, with sign written separately so that, e.g.,
+  // -1/2 gives "-0.5"
+  char* ptr = first;
+  const long long magnitude = std::abs(static_cast<long long>(twice_value));
+  if (twice_value<0)
+    {
+      if (ptr==last)
+        return {last, std::errc::value_too_large};
+      *ptr++ = '-';
+    }
+  std::to_chars_result result = std::to_chars(ptr, last, magnitude/2);
+  if (result.ec!=std::errc())
+    return result;
+  if (presentation=='f')
+    {
+      if (last-result.ptr<2)
+        return {last, std::errc::value_too_large};
+      *result.ptr++ = '.';
+      *result.ptr++ = (magnitude%2) ? '5' : '0';
+    }
+  return result;
+}
+
+inline
+std::from_chars_result from_chars(const char* first, const char* last, HalfInt& h)
+// Parse HalfInt from buffer [first,last).
+//
+// Accepted forms are an optional minus sign, followed by an integer "3", a
+// fraction with denominator 1 or 2 "3/2", or a decimal with fractional part
+// .5 or .0 "1.5" (trailing zeros allowed).  Parsing stops at the first
+// character which cannot continue the number.
+//
+// Returns:
+//   (std::from_chars_result): pointer past last character parsed, and error
+//     code (std::errc::invalid_argument if no HalfInt could be parsed,
+//     std::errc::result_out_of_range if the value does not fit); on error,
+//     h is unmodified
+{
+  auto is_digit = [](char c) {return (c>='0') && (c<='9');};
+  const char* ptr = first;
+  const bool negative = (ptr!=last) && (*ptr=='-');
+  if (negative)
+    ++ptr;
+  if ((ptr==last) || !is_digit(*ptr))
+    return {first, std::errc::invalid_argument};
+
+  // integer part
+  //
+  // The twice-value may have magnitude up to INT_MAX, or INT_MAX+1 if
+  // negative (INT_MIN, as written by to_chars as "-2147483648/2").
+  unsigned long long magnitude;
+  std::from_chars_result result = std::from_chars(ptr, last, magnitude);
+  if (result.ec!=std::errc())
+    return {first, result.ec};
+  ptr = result.ptr;
+  const unsigned long long kMaxMagnitude
+    = static_cast<unsigned long long>(std::numeric_limits<int>::max()) + (negative ? 1 : 0);
+  if (magnitude>kMaxMagnitude)
+    return {first, std::errc::result_out_of_range};
+  unsigned long long twice_magnitude = 2*magnitude;
+
+  if ((ptr!=last) && (*ptr=='/') && (ptr+1!=last) && is_digit(ptr[1]))
+    {
+      // fraction
+      unsigned int denominator;
+      result = std::from_chars(ptr+1, last, denominator);
+      if ((result.ec!=std::errc()) || !((denominator==1)||(denominator==2)))
+        return {first, std::errc::invalid_argument};
+      if (denominator==2)
+        twice_magnitude = magnitude;
+      ptr = result.ptr;
+    }
+  else if ((ptr!=last) && (*ptr=='.') && (ptr+1!=last) && is_digit(ptr[1]))
+    {
+      // decimal
+      ++ptr;
+      if (!((*ptr=='0')||(*ptr=='5')))
+        return {first, std::errc::invalid_argument};
+      if (*ptr=='5')
+        ++twice_magnitude;
+      for (++ptr; (ptr!=last) && is_digit(*ptr); ++ptr)
+        if (*ptr!='0')
+          return {first, std::errc::invalid_argument};
+    }
+
+  if (twice_magnitude>kMaxMagnitude)
+    return {first, std::errc::result_out_of_range};
+  const int twice_value = static_cast<int>(
+      negative ? -static_cast<long long>(twice_magnitude) : static_cast<long long>(twice_magnitude)
+    );
+  h = HalfInt(twice_value, 2);
+  return {ptr, std::errc()};
+}
+
+inline std::string HalfInt::Str() const
+{
+  char buffer[kHalfIntMaxChars];
+  std::to_chars_result result = to_chars(buffer, buffer+kHalfIntMaxChars, *this);
+  return std::string(buffer, result.ptr);
+}
+#endif  // SWIG
+
+////////////////////////////////////////////////////////////////
+// stream input and output
 ////////////////////////////////////////////////////////////////
 
 // textual output to stream
 // EX: HalfInt(3) or HalfInt(6,2) -> "3", HalfInt(3,2) -> "3/2"
 inline std::ostream& operator<< (std::ostream& os, const HalfInt& h)
 {
-  return os << h.Str();
+  char buffer[kHalfIntMaxChars];
+  std::to_chars_result result = to_chars(buffer, buffer+kHalfIntMaxChars, h);
+  return os << std::string_view(buffer, result.ptr-buffer);
+}
+
+#ifndef SWIG
+// textual input from stream
+// EX: "3", "3/2", "1.5" (see from_chars)
+//
+// Leading whitespace is skipped, and input stops at the first character
+// which cannot be part of a HalfInt.  On failure, failbit is set.
+inline std::istream& operator>> (std::istream& is, HalfInt& h)
+{
+  std::istream::sentry sentry(is);
+  if (!sentry)
+    return is;
+  char buffer[2*kHalfIntMaxChars];
+  std::size_t length = 0;
+  while (length<sizeof(buffer))
+    {
+      const std::istream::int_type c = is.peek();
+      if (c==std::istream::traits_type::eof())
+        break;
+      const char ch = std::istream::traits_type::to_char_type(c);
+      if (!(((ch>='0')&&(ch<='9')) || (ch=='-') || (ch=='/') || (ch=='.')))
+        break;
+      buffer[length++] = ch;
+      is.get();
+    }
+  HalfInt value;
+  std::from_chars_result result = from_chars(buffer, buffer+length, value);
+  if ((result.ec!=std::errc()) || (result.ptr!=buffer+length))
+    is.setstate(std::ios_base::failbit);
+  else
+    h = value;
+  return is;
 }
+#endif  // SWIG
 
 inline std::ostream& operator<< (std::ostream& os, const HalfInt::pair& r)
 {
   return os << "(" << r.first << "," << r.second << ")";
 }
 
+////////////////////////////////////////////////////////////////
+// compact storage types
+////////////////////////////////////////////////////////////////
+
+// BasicHalfInt<T> stores twice the value in a narrow signed integer type T,
+// for compact storage of large tables of quantum numbers.  Values widen
+// implicitly to HalfInt, so all HalfInt operations and all am functions
+// taking HalfInt arguments accept the compact types directly, and arithmetic
+// yields HalfInt.  Conversions into the compact types are range checked, and
+// throw std::out_of_range if the value is not representable.
+//
+// EX: HalfInt8 j(HalfInt(7,2)); HalfInt J = j+1; am::dim(j) -> 8
+
+#ifndef SWIG
+template<typename T>
+class BasicHalfInt
+{
+  static_assert(
+      std::is_integral_v<T> && std::is_signed_v<T> && (sizeof(T)<sizeof(int)),
+      "BasicHalfInt storage type must be a signed integer type narrower than int"
+    );
+
+ public:
+
+  typedef T storage_type;
+
+  // default constructor: initializes value to zero
+  constexpr BasicHalfInt() : twice_value_(0) {}
+
+  // conversion from HalfInt (checked)
+  constexpr BasicHalfInt(const HalfInt& h) : twice_value_(Narrow(h.TwiceValue())) {}
+
+  // conversion between storage types (checked)
+  template<typename U>
+  constexpr BasicHalfInt(const BasicHalfInt<U>& h) : twice_value_(Narrow(h.TwiceValue())) {}
+
+  // conversion from integer (checked)
+  template<typename U, std::enable_if_t<std::is_integral_v<U>, U>* = nullptr>
+  constexpr BasicHalfInt(U value) : BasicHalfInt(HalfInt(value)) {}
+
+  // construct from numerator and denominator (checked)
+  template<typename U, typename V>
+  constexpr BasicHalfInt(U numerator, V denominator)
+    : BasicHalfInt(HalfInt(numerator, denominator))
+  {}
+
+  // prevent construction from floating-point
+  BasicHalfInt(float) = delete;
+  BasicHalfInt(double) = delete;
+
+  // construct directly from twice value (checked)
+  static constexpr BasicHalfInt FromTwiceValue(int twice_value)
+  {
+    BasicHalfInt h;
+    h.twice_value_ = Narrow(twice_value);
+    return h;
+  }
+
+  // accessors
+  constexpr int TwiceValue() const {return twice_value_;}
+  constexpr bool IsInteger() const {return !(twice_value_%2);}
+
+  // widening conversion to HalfInt
+  constexpr operator HalfInt() const {return HalfInt(HalfInt(twice_value_), 2);}
+
+  // explicit conversion to arithmetic types, as for HalfInt
+  template<typename U, std::enable_if_t<std::is_arithmetic_v<U>>* = nullptr>
+  constexpr explicit operator U() const {return static_cast<U>(HalfInt(*this));}
+
+  // unary arithmetic operators
+  constexpr HalfInt operator +() const {return HalfInt(*this);}
+  constexpr HalfInt operator -() const {return -HalfInt(*this);}
+
+  // arithmetic assignment operators (checked)
+  constexpr BasicHalfInt& operator +=(const HalfInt& b) {return *this = HalfInt(*this)+b;}
+  constexpr BasicHalfInt& operator -=(const HalfInt& b) {return *this = HalfInt(*this)-b;}
+  constexpr BasicHalfInt& operator *=(const int& b) {return *this = HalfInt(*this)*b;}
+  constexpr BasicHalfInt& operator ++() {return *this += 1;}
+  constexpr BasicHalfInt operator ++(int) {BasicHalfInt h = *this; *this += 1; return h;}
+  constexpr BasicHalfInt& operator --() {return *this -= 1;}
+  constexpr BasicHalfInt operator --(int) {BasicHalfInt h = *this; *this -= 1; return h;}
+
+  // string conversion
+  inline std::string Str() const {return HalfInt(*this).Str();}
+
+ private:
+
+  static constexpr T Narrow(int twice_value)
+  {
+    if ((twice_value<std::numeric_limits<T>::min()) || (twice_value>std::numeric_limits<T>::max()))
+      throw std::out_of_range("value out of range for compact HalfInt storage type");
+    return static_cast<T>(twice_value);
+  }
+
+  T twice_value_;
+};
+
+// compact storage types
+//
+// HalfInt8 holds values in [-64,127/2], HalfInt16 holds values in [-16384,32767/2].
+typedef BasicHalfInt<std::int8_t> HalfInt8;
+typedef BasicHalfInt<std::int16_t> HalfInt16;
+
+// hashing consistent with HalfInt, so that equal values hash equally
+// regardless of storage type
+template<typename T>
+inline
+std::size_t hash_value(const BasicHalfInt<T>& h)
+{
+  return std::hash<int>()(h.TwiceValue());
+}
+
+template <typename T>
+struct std::hash<BasicHalfInt<T>>
+{
+  inline
+  std::size_t operator()(const BasicHalfInt<T>& h) const
+  {
+    return std::hash<int>()(h.TwiceValue());
+  }
+};
+#endif  // SWIG
+
 ////////////////////////////////////////////////////////////////
 // numeric limits
 ////////////////////////////////////////////////////////////////
@@ -13,11 +13,18 @@
   + 09/12/19 (pjf): Updated for fmt v6.0.0.
   + 02/27/20 (pjf): Provide multiple (basic) formatting modes.
   + 05/18/20 (pjf): Fix C++11 compatibility.
+  + 10/18/26: Add formatter for compact storage types BasicHalfInt<T>.
+  + 10/18/26: Format through to_chars(), without intermediate formatting.
+  + 10/18/26: Report distinct format errors for each to_chars() error code.
 ****************************************************************/
 
 #ifndef HALFINT_FMT_H_
 #define HALFINT_FMT_H_
 
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+
 #include "fmt/format.h"
 #include "halfint.h"
 
@@ -42,22 +49,23 @@ struct formatter<HalfInt> {
 
   template <typename FormatContext>
   FMT_CONSTEXPR auto format(const HalfInt& h, FormatContext& ctx) const -> decltype(ctx.out()) {
-    if (presentation == 'f')
-    {
-      return format_to(ctx.out(), "{:.1f}", float(h));
-    }
-    else if (presentation == 'd')
-    {
-      if (!h.IsInteger()) throw format_error("non-integer value");
-      return format_to(ctx.out(), "{:d}", int(h));
-    }
-    else
-    {
-      if (h.IsInteger())
-        return format_to(ctx.out(), "{:d}", int(h));
-      else
-        return format_to(ctx.out(), "{:d}/2", h.TwiceValue());
-    }
+    char buffer[kHalfIntMaxChars];
+    std::to_chars_result result = ::to_chars(buffer, buffer+kHalfIntMaxChars, h, presentation);
+    if (result.ec == std::errc::invalid_argument)
+      throw format_error("non-integer value for integer presentation");
+    if (result.ec == std::errc::value_too_large)
+      throw format_error("buffer too small for HalfInt");
+    if (result.ec != std::errc())
+      throw format_error(std::make_error_code(result.ec).message());
+    return std::copy(buffer, result.ptr, ctx.out());
+  }
+};
+
+template <typename T>
+struct formatter<BasicHalfInt<T>> : formatter<HalfInt> {
+  template <typename FormatContext>
+  FMT_CONSTEXPR auto format(const BasicHalfInt<T>& h, FormatContext& ctx) const -> decltype(ctx.out()) {
+    return formatter<HalfInt>::format(HalfInt(h), ctx);
   }
 };
 
@@ -0,0 +1,885 @@
+/****************************************************************
+  instrument.h
+
+  Call counters and timers for the angular momentum coupling functions
+  (wigner_gsl.h, wigner_gsl_twice.h, racah_reduction.h, and rme.h).
+
+  Instrumentation is enabled by defining the macro AM_INSTRUMENT (e.g., by
+  the CMake option AM_ENABLE_INSTRUMENT).  Each instrumented function then
+  opens with
+
+    AM_INSTRUMENT_FUNCTION(Wigner6J);
+
+  which counts the call, and accumulates the time spent in the call, in
+  per-thread counters.  Otherwise, AM_INSTRUMENT_FUNCTION expands to
+  nothing, and the instrumented functions are unchanged.
+
+  Times are inclusive, e.g., the time for Unitary6J includes the time for
+  the Wigner6J it calls (which is also counted as a call of Wigner6J).  The
+  timer is the time stamp counter (cycles, on x86), or else steady_clock
+  (nanoseconds).  Time stamp counter ticks are converted to seconds by
+  calibration against steady_clock over the lifetime of the process.
+
+  The counters from all threads (including threads which have exited) are
+  aggregated by GetInstrumentStatistics() or written by
+  WriteInstrumentStatistics(), as text or JSON:
+
+    am::WriteInstrumentStatistics(std::cout, am::InstrumentFormat::kText);
+
+  The statistics are also written at program exit, if requested by
+  SetInstrumentOutput(filename,format), or by the environment variable
+  AM_INSTRUMENT_OUTPUT, giving the filename ("-" for standard error), where
+  a filename ending in ".json" selects JSON format.
+
+  Argument profiling: If the macro AM_INSTRUMENT_ARGUMENTS is also defined
+  (e.g., by the CMake option AM_ENABLE_INSTRUMENT_ARGUMENTS, which implies
+  AM_INSTRUMENT), the arguments of each evaluation of a Wigner 3-j
+  (including Clebsch-Gordan), 6-j, or 9-j symbol are recorded, via
+
+    AM_INSTRUMENT_SYMBOL(Wigner6J, two_ja, two_jb, two_jc, two_jd, two_je, two_jf);
+
+  to profile, for each symbol type:
+
+    - a histogram of the largest argument 2j (for the 3-j symbol, of the
+      angular momenta, not the projections);
+
+    - the number of distinct canonical keys, i.e., argument lists up to the
+      symmetries of the symbol (the 12 classical symmetries of the 3-j
+      symbol, without the Regge symmetries, the 24 of the 6-j symbol, and
+      the 72 of the 9-j symbol), which is the number of entries a cache
+      keyed on canonical arguments would need to hold all values;
+
+    - the LRU stack distance of each repeated access to a canonical key
+      (the number of distinct other keys accessed since the last access to
+      the same key), binned by powers of two, from which the hit rate of an
+      LRU cache of any size holding canonical keys follows, as
+      ArgumentProfile::PredictedHitRate(cache_size).
+
+  Argument profiling serializes all evaluations of each symbol type on a
+  mutex, and holds every distinct key in memory, so it is meant for
+  profiling runs on representative workloads, not for production.  Only
+  evaluations reaching the Wigner functions are seen, so symbol caches
+  (symbol_cache.h) should be disabled while profiling.
+
+  These functions are available whether or not instrumentation is enabled,
+  but report no functions (or symbols) if it is not.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Add argument profiling (AM_INSTRUMENT_ARGUMENTS).
+
+****************************************************************/
+
+#ifndef AM_INSTRUMENT_H_
+#define AM_INSTRUMENT_H_
+
+#if defined(AM_INSTRUMENT_ARGUMENTS) && !defined(AM_INSTRUMENT)
+#define AM_INSTRUMENT
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef AM_INSTRUMENT
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define AM_INSTRUMENT_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define AM_INSTRUMENT_TSC
+#endif
+#endif
+
+namespace am {
+
+  ////////////////////////////////////////////////////////////////
+  // instrumented functions
+  ////////////////////////////////////////////////////////////////
+
+  enum class InstrumentFunction : int {
+    // wigner_gsl.h
+    kWigner3J, kClebschGordan, kWigner6J, kUnitary6J, kUnitary6JZ, kWigner9J, kUnitary9J,
+    // wigner_gsl_twice.h
+    kWigner3J2, kClebschGordan2, kWigner6J2, kUnitary6J2, kWigner9J2, kUnitary9J2,
+    // racah_reduction.h
+    kRacahReductionFactorRose, kRacahReductionFactor1Rose, kRacahReductionFactor2Rose,
+    kRacahReductionFactor12DotRose, kRacahReductionFactor12Rose, kRacahReductionFactor21Rose,
+    // rme.h
+    kSphericalHarmonicCRME, kLJCoupledSphericalHarmonicCRME,
+    kSphericalHarmonicYRME, kLJCoupledSphericalHarmonicYRME,
+    kAngularMomentumJRME, kjjJCoupledAngularMomentumJ1RME,
+    kjjJCoupledAngularMomentumJ2RME, kjjJCoupledAngularMomentumJRME,
+    kNumFunctions
+  };
+
+  constexpr int kNumInstrumentFunctions = int(InstrumentFunction::kNumFunctions);
+
+  inline constexpr const char* kInstrumentFunctionNames[kNumInstrumentFunctions] = {
+    "Wigner3J", "ClebschGordan", "Wigner6J", "Unitary6J", "Unitary6JZ", "Wigner9J", "Unitary9J",
+    "Wigner3J2", "ClebschGordan2", "Wigner6J2", "Unitary6J2", "Wigner9J2", "Unitary9J2",
+    "RacahReductionFactorRose", "RacahReductionFactor1Rose", "RacahReductionFactor2Rose",
+    "RacahReductionFactor12DotRose", "RacahReductionFactor12Rose", "RacahReductionFactor21Rose",
+    "SphericalHarmonicCRME", "LJCoupledSphericalHarmonicCRME",
+    "SphericalHarmonicYRME", "LJCoupledSphericalHarmonicYRME",
+    "AngularMomentumJRME", "jjJCoupledAngularMomentumJ1RME",
+    "jjJCoupledAngularMomentumJ2RME", "jjJCoupledAngularMomentumJRME",
+  };
+
+  // symbol types with argument profiling
+  enum class ArgumentSymbol : int {kWigner3J, kWigner6J, kWigner9J, kNumSymbols};
+
+  constexpr int kNumArgumentSymbols = int(ArgumentSymbol::kNumSymbols);
+  inline constexpr const char* kArgumentSymbolNames[kNumArgumentSymbols] = {"Wigner3J", "Wigner6J", "Wigner9J"};
+  inline constexpr std::size_t kArgumentSymbolArity[kNumArgumentSymbols] = {6, 6, 9};
+
+  enum class InstrumentFormat {kText, kJSON};
+
+  struct InstrumentRecord
+  // Aggregated statistics for one function.
+  {
+    std::string name;
+    std::uint64_t calls;
+    std::uint64_t ticks;  // timer ticks (cycles or nanoseconds)
+    double seconds;
+  };
+
+  struct ArgumentProfile
+  // Argument profile for one symbol type.
+  {
+    std::string name;
+    std::uint64_t calls;
+    std::vector<std::uint64_t> max_two_j_histogram;  // calls by largest argument 2j
+    std::uint64_t distinct_keys;  // distinct canonical keys (i.e., cold misses)
+    std::vector<std::uint64_t> stack_distance_histogram;  // repeat accesses by bit width of stack distance
+
+    double PredictedHitRate(std::uint64_t cache_size) const
+    // Hit rate of LRU cache holding given number of canonical keys.
+    //
+    // Exact for cache sizes which are powers of two, and otherwise a lower
+    // bound (counting only stack distance bins entirely below cache_size).
+    {
+      if (calls==0)
+        return 0.;
+      std::uint64_t hits = 0;
+      for (std::size_t bin=0; bin<stack_distance_histogram.size(); ++bin)
+        {
+          // largest stack distance in bin is 2^bin-1
+          const std::uint64_t max_distance = (bin==0) ? 0 : (std::uint64_t(1)<<bin)-1;
+          if (max_distance<cache_size)
+            hits += stack_distance_histogram[bin];
+        }
+      return double(hits)/double(calls);
+    }
+  };
+
+#ifdef AM_INSTRUMENT
+
+  ////////////////////////////////////////////////////////////////
+  // counters
+  ////////////////////////////////////////////////////////////////
+
+  namespace detail {
+
+    inline
+    std::uint64_t ReadInstrumentTimer()
+    {
+#ifdef AM_INSTRUMENT_TSC
+      return __rdtsc();
+#else
+      return std::uint64_t(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now().time_since_epoch()
+            ).count()
+        );
+#endif
+    }
+
+    struct InstrumentCounters
+    // Counters, written only by owning thread (so updated by relaxed
+    // load and store, rather than read-modify-write), but read by any
+    // thread.
+    {
+      std::atomic<std::uint64_t> calls[kNumInstrumentFunctions] = {};
+      std::atomic<std::uint64_t> ticks[kNumInstrumentFunctions] = {};
+
+      void Add(int index, std::uint64_t elapsed)
+      {
+        calls[index].store(calls[index].load(std::memory_order_relaxed)+1, std::memory_order_relaxed);
+        ticks[index].store(ticks[index].load(std::memory_order_relaxed)+elapsed, std::memory_order_relaxed);
+      }
+
+      void Reset()
+      {
+        for (int index=0; index<kNumInstrumentFunctions; ++index)
+          {
+            calls[index].store(0, std::memory_order_relaxed);
+            ticks[index].store(0, std::memory_order_relaxed);
+          }
+      }
+    };
+
+    class InstrumentRegistry
+    // Process-wide registry of per-thread counters.
+    //
+    // Never destroyed, so that counters may be retired by threads exiting
+    // during or after static destruction, and statistics may be written at
+    // exit.
+    {
+      public:
+
+      static InstrumentRegistry& Instance()
+      {
+        static InstrumentRegistry* instance = new InstrumentRegistry();
+        return *instance;
+      }
+
+      void Register(const InstrumentCounters* counters)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads_.push_back(counters);
+      }
+
+      void Retire(const InstrumentCounters* counters)
+      // Fold counters of exiting thread into retired totals.
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int index=0; index<kNumInstrumentFunctions; ++index)
+          {
+            retired_calls_[index] += counters->calls[index].load(std::memory_order_relaxed);
+            retired_ticks_[index] += counters->ticks[index].load(std::memory_order_relaxed);
+          }
+        for (auto it=threads_.begin(); it!=threads_.end(); ++it)
+          if (*it==counters)
+            {
+              threads_.erase(it);
+              break;
+            }
+      }
+
+      std::vector<InstrumentRecord> Statistics()
+      {
+        std::uint64_t calls[kNumInstrumentFunctions], ticks[kNumInstrumentFunctions];
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          for (int index=0; index<kNumInstrumentFunctions; ++index)
+            {
+              calls[index] = retired_calls_[index];
+              ticks[index] = retired_ticks_[index];
+              for (const InstrumentCounters* counters : threads_)
+                {
+                  calls[index] += counters->calls[index].load(std::memory_order_relaxed);
+                  ticks[index] += counters->ticks[index].load(std::memory_order_relaxed);
+                }
+            }
+        }
+        const double seconds_per_tick = SecondsPerTick();
+        std::vector<InstrumentRecord> records;
+        for (int index=0; index<kNumInstrumentFunctions; ++index)
+          if (calls[index]>0)
+            records.push_back({kInstrumentFunctionNames[index], calls[index], ticks[index], ticks[index]*seconds_per_tick});
+        return records;
+      }
+
+      void Reset()
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int index=0; index<kNumInstrumentFunctions; ++index)
+          retired_calls_[index] = retired_ticks_[index] = 0;
+        for (const InstrumentCounters* counters : threads_)
+          const_cast<InstrumentCounters*>(counters)->Reset();
+      }
+
+      double SecondsPerTick() const
+      {
+#ifdef AM_INSTRUMENT_TSC
+        const std::uint64_t ticks = ReadInstrumentTimer()-start_ticks_;
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()-start_time_;
+        return (ticks>0) ? elapsed.count()/ticks : 0.;
+#else
+        return 1e-9;
+#endif
+      }
+
+      const char* timer() const
+      {
+#ifdef AM_INSTRUMENT_TSC
+        return "tsc";
+#else
+        return "steady_clock";
+#endif
+      }
+
+      private:
+
+      InstrumentRegistry()
+        : start_ticks_(ReadInstrumentTimer()), start_time_(std::chrono::steady_clock::now())
+      {}
+
+      std::mutex mutex_;
+      std::vector<const InstrumentCounters*> threads_;
+      std::uint64_t retired_calls_[kNumInstrumentFunctions] = {};
+      std::uint64_t retired_ticks_[kNumInstrumentFunctions] = {};
+      std::uint64_t start_ticks_;
+      std::chrono::steady_clock::time_point start_time_;
+    };
+
+    inline void SetInstrumentOutputFromEnvironment();
+
+    struct ThreadInstrumentCounters
+      : InstrumentCounters
+    {
+      ThreadInstrumentCounters()
+      {
+        SetInstrumentOutputFromEnvironment();
+        InstrumentRegistry::Instance().Register(this);
+      }
+      ~ThreadInstrumentCounters()
+      {
+        InstrumentRegistry::Instance().Retire(this);
+      }
+    };
+
+    inline
+    InstrumentCounters& ThreadCounters()
+    {
+      thread_local ThreadInstrumentCounters counters;
+      return counters;
+    }
+
+    class InstrumentScope
+    // Counts call, and accumulates time, from construction to destruction.
+    {
+      public:
+
+      explicit InstrumentScope(InstrumentFunction function)
+        : counters_(ThreadCounters()), index_(int(function)), start_(ReadInstrumentTimer())
+      {}
+
+      ~InstrumentScope()
+      {
+        counters_.Add(index_, ReadInstrumentTimer()-start_);
+      }
+
+      InstrumentScope(const InstrumentScope&) = delete;
+      InstrumentScope& operator=(const InstrumentScope&) = delete;
+
+      private:
+
+      InstrumentCounters& counters_;
+      int index_;
+      std::uint64_t start_;
+    };
+
+  }  // namespace detail
+
+#define AM_INSTRUMENT_FUNCTION(name) \
+  const ::am::detail::InstrumentScope am_instrument_scope(::am::InstrumentFunction::k##name)
+
+#else
+
+#define AM_INSTRUMENT_FUNCTION(name)
+
+#endif  // AM_INSTRUMENT
+
+#ifdef AM_INSTRUMENT_ARGUMENTS
+
+  ////////////////////////////////////////////////////////////////
+  // argument profiling
+  ////////////////////////////////////////////////////////////////
+
+  namespace detail {
+
+    template<std::size_t N>
+    struct ArgumentKeyHash
+    {
+      std::size_t operator()(const std::array<int,N>& key) const
+      {
+        std::uint64_t hash = 0xcbf29ce484222325ull;  // FNV-1a
+        for (int value : key)
+          hash = (hash^std::uint32_t(value))*0x100000001b3ull;
+        return std::size_t(hash);
+      }
+    };
+
+    inline
+    std::array<int,6> CanonicalWigner3JKey(const std::array<int,6>& two_values)
+    // Canonical form of 3-j arguments (j1,j2,j3,m1,m2,m3) under column
+    // permutations and reversal of signs of projections.
+    {
+      static constexpr int kPermutations[6][3] = {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+      std::array<int,6> canonical = two_values;
+      for (const auto& permutation : kPermutations)
+        for (int sign : {+1,-1})
+          {
+            std::array<int,6> key;
+            for (int column=0; column<3; ++column)
+              {
+                key[column] = two_values[permutation[column]];
+                key[3+column] = sign*two_values[3+permutation[column]];
+              }
+            canonical = std::min(canonical, key);
+          }
+      return canonical;
+    }
+
+    inline
+    std::array<int,6> CanonicalWigner6JKey(const std::array<int,6>& two_values)
+    // Canonical form of 6-j arguments {ja,jb,jc;jd,je,jf} under column
+    // permutations and interchange of upper and lower arguments in any two
+    // columns.
+    {
+      static constexpr int kPermutations[6][3] = {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+      static constexpr bool kFlips[4][3] = {{false,false,false},{true,true,false},{true,false,true},{false,true,true}};
+      std::array<int,6> canonical = two_values;
+      for (const auto& permutation : kPermutations)
+        for (const auto& flip : kFlips)
+          {
+            std::array<int,6> key;
+            for (int column=0; column<3; ++column)
+              {
+                const int source = permutation[column];
+                key[column] = two_values[flip[column] ? 3+source : source];
+                key[3+column] = two_values[flip[column] ? source : 3+source];
+              }
+            canonical = std::min(canonical, key);
+          }
+      return canonical;
+    }
+
+    inline
+    std::array<int,9> CanonicalWigner9JKey(const std::array<int,9>& two_values)
+    // Canonical form of 9-j arguments (in row order) under row and column
+    // permutations and transposition.
+    {
+      static constexpr int kPermutations[6][3] = {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+      std::array<int,9> canonical = two_values;
+      for (const auto& rows : kPermutations)
+        for (const auto& columns : kPermutations)
+          for (bool transpose : {false,true})
+            {
+              std::array<int,9> key;
+              for (int row=0; row<3; ++row)
+                for (int column=0; column<3; ++column)
+                  key[3*row+column] = transpose
+                    ? two_values[3*columns[column]+rows[row]]
+                    : two_values[3*rows[row]+columns[column]];
+              canonical = std::min(canonical, key);
+            }
+      return canonical;
+    }
+
+    template<std::size_t N>
+    class ArgumentProfiler
+    // Accumulates argument profile for one symbol type.
+    //
+    // Stack distances are computed by marking, in a Fenwick tree indexed by
+    // access time, the time of the most recent access to each key, so that
+    // the stack distance of an access is the number of marks since the
+    // previous access to the same key.  When the time index reaches the
+    // capacity of the tree, the marked times are renumbered consecutively
+    // (preserving order), so the tree size is proportional to the number of
+    // distinct keys.
+    {
+      public:
+
+      typedef std::array<int,N> Key;
+
+      void Record(const Key& canonical_key, int max_two_j)
+      {
+        ++calls_;
+        if (max_two_j>=0)
+          {
+            if (std::size_t(max_two_j)>=max_two_j_histogram_.size())
+              max_two_j_histogram_.resize(max_two_j+1, 0);
+            ++max_two_j_histogram_[max_two_j];
+          }
+        if (time_==tree_.size())
+          Compact();
+        auto [it, inserted] = last_access_.try_emplace(canonical_key, time_);
+        if (!inserted)
+          {
+            const std::size_t previous = it->second;
+            const std::uint64_t distance = Count(time_)-Count(previous+1);
+            std::size_t bin = 0;
+            while ((distance>>bin)!=0)
+              ++bin;
+            if (bin>=stack_distance_histogram_.size())
+              stack_distance_histogram_.resize(bin+1, 0);
+            ++stack_distance_histogram_[bin];
+            Mark(previous, -1);
+            it->second = time_;
+          }
+        Mark(time_, +1);
+        ++time_;
+      }
+
+      ArgumentProfile Profile(const char* name) const
+      {
+        return ArgumentProfile{
+          name, calls_, max_two_j_histogram_, std::uint64_t(last_access_.size()), stack_distance_histogram_
+        };
+      }
+
+      void Reset()
+      {
+        *this = ArgumentProfiler();
+      }
+
+      private:
+
+      std::int64_t Count(std::size_t end) const
+      // Number of marks at times [0,end).
+      {
+        std::int64_t count = 0;
+        for (std::size_t i=end; i>0; i-=i&(~i+1))
+          count += tree_[i-1];
+        return count;
+      }
+
+      void Mark(std::size_t time, int delta)
+      {
+        for (std::size_t i=time+1; i<=tree_.size(); i+=i&(~i+1))
+          tree_[i-1] += delta;
+      }
+
+      void Compact()
+      // Renumber most recent access times consecutively, and resize tree.
+      {
+        std::vector<std::pair<std::size_t,std::size_t*>> times;
+        times.reserve(last_access_.size());
+        for (auto& [key, time] : last_access_)
+          times.emplace_back(time, &time);
+        std::sort(times.begin(), times.end());
+        for (std::size_t i=0; i<times.size(); ++i)
+          *times[i].second = i;
+        time_ = times.size();
+        tree_.assign(std::max<std::size_t>(4*time_, 4096), 0);
+        for (std::size_t i=0; i<time_; ++i)
+          Mark(i, +1);
+      }
+
+      std::uint64_t calls_ = 0;
+      std::vector<std::uint64_t> max_two_j_histogram_;
+      std::vector<std::uint64_t> stack_distance_histogram_;
+      std::unordered_map<Key,std::size_t,ArgumentKeyHash<N>> last_access_;
+      std::vector<std::int32_t> tree_;
+      std::size_t time_ = 0;
+    };
+
+    template<ArgumentSymbol symbol>
+    struct ArgumentProfilerState
+    {
+      static constexpr std::size_t N = kArgumentSymbolArity[int(symbol)];
+
+      static ArgumentProfilerState& Instance()
+      {
+        // never destroyed, for output at exit
+        static ArgumentProfilerState* instance = new ArgumentProfilerState();
+        return *instance;
+      }
+
+      std::mutex mutex;
+      ArgumentProfiler<N> profiler;
+    };
+
+    template<ArgumentSymbol symbol>
+    void RecordArguments(const std::array<int,kArgumentSymbolArity[int(symbol)]>& two_values)
+    // Record arguments (as twice-values) of symbol evaluation.
+    {
+      ThreadCounters();  // apply AM_INSTRUMENT_OUTPUT
+      int max_two_j;
+      if constexpr (symbol==ArgumentSymbol::kWigner3J)
+        max_two_j = std::max({two_values[0], two_values[1], two_values[2]});
+      else
+        max_two_j = *std::max_element(two_values.begin(), two_values.end());
+      const auto canonical_key = [&] {
+        if constexpr (symbol==ArgumentSymbol::kWigner3J)
+          return CanonicalWigner3JKey(two_values);
+        else if constexpr (symbol==ArgumentSymbol::kWigner6J)
+          return CanonicalWigner6JKey(two_values);
+        else
+          return CanonicalWigner9JKey(two_values);
+      }();
+      ArgumentProfilerState<symbol>& state = ArgumentProfilerState<symbol>::Instance();
+      std::lock_guard<std::mutex> lock(state.mutex);
+      state.profiler.Record(canonical_key, max_two_j);
+    }
+
+    template<ArgumentSymbol symbol>
+    ArgumentProfile GetArgumentProfile()
+    {
+      ArgumentProfilerState<symbol>& state = ArgumentProfilerState<symbol>::Instance();
+      std::lock_guard<std::mutex> lock(state.mutex);
+      return state.profiler.Profile(kArgumentSymbolNames[int(symbol)]);
+    }
+
+    template<ArgumentSymbol symbol>
+    void ResetArgumentProfile()
+    {
+      ArgumentProfilerState<symbol>& state = ArgumentProfilerState<symbol>::Instance();
+      std::lock_guard<std::mutex> lock(state.mutex);
+      state.profiler.Reset();
+    }
+
+  }  // namespace detail
+
+#define AM_INSTRUMENT_SYMBOL(symbol, ...) \
+  ::am::detail::RecordArguments<::am::ArgumentSymbol::k##symbol>({__VA_ARGS__})
+
+#else
+
+#define AM_INSTRUMENT_SYMBOL(symbol, ...)
+
+#endif  // AM_INSTRUMENT_ARGUMENTS
+
+  ////////////////////////////////////////////////////////////////
+  // statistics
+  ////////////////////////////////////////////////////////////////
+
+  inline
+  bool InstrumentEnabled()
+  // Test whether library was compiled with instrumentation.
+  {
+#ifdef AM_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  inline
+  std::vector<InstrumentRecord> GetInstrumentStatistics()
+  // Aggregate statistics over all threads.
+  //
+  // Returns:
+  //   (std::vector<InstrumentRecord>): statistics for functions which have
+  //     been called
+  {
+#ifdef AM_INSTRUMENT
+    return detail::InstrumentRegistry::Instance().Statistics();
+#else
+    return {};
+#endif
+  }
+
+  inline
+  std::vector<ArgumentProfile> GetArgumentProfiles()
+  // Get argument profiles.
+  //
+  // Returns:
+  //   (std::vector<ArgumentProfile>): profiles for symbol types which have
+  //     been evaluated
+  {
+    std::vector<ArgumentProfile> profiles;
+#ifdef AM_INSTRUMENT_ARGUMENTS
+    for (const ArgumentProfile& profile : {
+        detail::GetArgumentProfile<ArgumentSymbol::kWigner3J>(),
+        detail::GetArgumentProfile<ArgumentSymbol::kWigner6J>(),
+        detail::GetArgumentProfile<ArgumentSymbol::kWigner9J>()
+      })
+      if (profile.calls>0)
+        profiles.push_back(profile);
+#endif
+    return profiles;
+  }
+
+  inline
+  void ResetInstrumentStatistics()
+  // Reset all counters (and argument profiles).
+  //
+  // Counts from calls in progress on other threads may be lost.
+  {
+#ifdef AM_INSTRUMENT
+    detail::InstrumentRegistry::Instance().Reset();
+#endif
+#ifdef AM_INSTRUMENT_ARGUMENTS
+    detail::ResetArgumentProfile<ArgumentSymbol::kWigner3J>();
+    detail::ResetArgumentProfile<ArgumentSymbol::kWigner6J>();
+    detail::ResetArgumentProfile<ArgumentSymbol::kWigner9J>();
+#endif
+  }
+
+  namespace detail {
+
+    inline
+    std::vector<std::uint64_t> ProfileCacheSizes(const ArgumentProfile& profile)
+    // Cache sizes (powers of two) for which to report predicted hit rate, up
+    // to size sufficient to hold all distinct keys.
+    {
+      std::vector<std::uint64_t> cache_sizes;
+      for (std::uint64_t cache_size=1; ; cache_size*=2)
+        {
+          cache_sizes.push_back(cache_size);
+          if (cache_size>=profile.distinct_keys)
+            break;
+        }
+      return cache_sizes;
+    }
+
+  }  // namespace detail
+
+  inline
+  void WriteInstrumentStatistics(std::ostream& os, InstrumentFormat format = InstrumentFormat::kText)
+  // Write aggregated statistics, and argument profiles.
+  //
+  // Arguments:
+  //   os (input): output stream
+  //   format (input): text table or JSON object
+  {
+    const std::vector<InstrumentRecord> records = GetInstrumentStatistics();
+    const std::vector<ArgumentProfile> profiles = GetArgumentProfiles();
+#ifdef AM_INSTRUMENT
+    const char* timer = detail::InstrumentRegistry::Instance().timer();
+#else
+    const char* timer = "none";
+#endif
+    if (format==InstrumentFormat::kJSON)
+      {
+        os << "{\"enabled\": " << (InstrumentEnabled() ? "true" : "false")
+           << ", \"timer\": \"" << timer << "\", \"functions\": [";
+        for (std::size_t i=0; i<records.size(); ++i)
+          os << ((i>0) ? ", " : "")
+             << "{\"name\": \"" << records[i].name << "\""
+             << ", \"calls\": " << records[i].calls
+             << ", \"ticks\": " << records[i].ticks
+             << ", \"seconds\": " << records[i].seconds
+             << "}";
+        os << "], \"arguments\": [";
+        for (std::size_t i=0; i<profiles.size(); ++i)
+          {
+            const ArgumentProfile& profile = profiles[i];
+            os << ((i>0) ? ", " : "")
+               << "{\"name\": \"" << profile.name << "\""
+               << ", \"calls\": " << profile.calls
+               << ", \"distinct_keys\": " << profile.distinct_keys
+               << ", \"max_two_j_histogram\": [";
+            for (std::size_t two_j=0; two_j<profile.max_two_j_histogram.size(); ++two_j)
+              os << ((two_j>0) ? ", " : "") << profile.max_two_j_histogram[two_j];
+            os << "], \"stack_distance_histogram\": [";
+            for (std::size_t bin=0; bin<profile.stack_distance_histogram.size(); ++bin)
+              os << ((bin>0) ? ", " : "") << profile.stack_distance_histogram[bin];
+            os << "], \"predicted_hit_rate\": [";
+            const std::vector<std::uint64_t> cache_sizes = detail::ProfileCacheSizes(profile);
+            for (std::size_t k=0; k<cache_sizes.size(); ++k)
+              os << ((k>0) ? ", " : "")
+                 << "{\"cache_size\": " << cache_sizes[k]
+                 << ", \"hit_rate\": " << profile.PredictedHitRate(cache_sizes[k]) << "}";
+            os << "]}";
+          }
+        os << "]}" << std::endl;
+      }
+    else
+      {
+        const std::ios_base::fmtflags flags = os.flags();
+        const std::streamsize precision = os.precision();
+        os << "am instrumentation (timer: " << timer << ")" << std::endl;
+        os << std::left << std::setw(32) << "function" << std::right
+           << std::setw(14) << "calls" << std::setw(18) << "ticks"
+           << std::setw(14) << "seconds" << std::setw(12) << "ns/call" << std::endl;
+        for (const InstrumentRecord& record : records)
+          os << std::left << std::setw(32) << record.name << std::right
+             << std::setw(14) << record.calls << std::setw(18) << record.ticks
+             << std::setw(14) << std::fixed << std::setprecision(6) << record.seconds
+             << std::setw(12) << std::setprecision(1) << 1e9*record.seconds/record.calls
+             << std::endl;
+        for (const ArgumentProfile& profile : profiles)
+          {
+            os << profile.name << " arguments: calls " << profile.calls
+               << ", distinct canonical keys " << profile.distinct_keys << std::endl;
+            os << "  calls by max 2j:";
+            for (std::size_t two_j=0; two_j<profile.max_two_j_histogram.size(); ++two_j)
+              if (profile.max_two_j_histogram[two_j]>0)
+                os << " " << two_j << ":" << profile.max_two_j_histogram[two_j];
+            os << std::endl;
+            os << "  predicted LRU hit rate by cache size:";
+            for (std::uint64_t cache_size : detail::ProfileCacheSizes(profile))
+              os << " " << cache_size << ":" << std::setprecision(4) << profile.PredictedHitRate(cache_size);
+            os << std::endl;
+          }
+        os.flags(flags);
+        os.precision(precision);
+      }
+  }
+
+  namespace detail {
+
+    inline std::mutex instrument_output_mutex;
+    inline std::string instrument_output_filename;
+    inline InstrumentFormat instrument_output_format = InstrumentFormat::kText;
+
+    inline
+    void WriteInstrumentOutput()
+    // Write statistics to requested output (registered with std::atexit).
+    {
+      std::lock_guard<std::mutex> lock(instrument_output_mutex);
+      if (instrument_output_filename.empty())
+        return;
+      if (instrument_output_filename=="-")
+        {
+          WriteInstrumentStatistics(std::cerr, instrument_output_format);
+          return;
+        }
+      std::ofstream os(instrument_output_filename);
+      WriteInstrumentStatistics(os, instrument_output_format);
+    }
+
+  }  // namespace detail
+
+  inline
+  void SetInstrumentOutput(const std::string& filename, InstrumentFormat format = InstrumentFormat::kText)
+  // Request that statistics be written at program exit.
+  //
+  // Arguments:
+  //   filename (input): output filename, "-" for standard error, or empty
+  //     for no output
+  //   format (input): text table or JSON object
+  {
+    static std::once_flag registered;
+    std::call_once(registered, [] {std::atexit(detail::WriteInstrumentOutput);});
+    std::lock_guard<std::mutex> lock(detail::instrument_output_mutex);
+    detail::instrument_output_filename = filename;
+    detail::instrument_output_format = format;
+  }
+
+#ifdef AM_INSTRUMENT
+
+  namespace detail {
+
+    inline
+    void SetInstrumentOutputFromEnvironment()
+    // Apply AM_INSTRUMENT_OUTPUT environment variable, once per process.
+    {
+      static std::once_flag applied;
+      std::call_once(applied, [] {
+          const char* filename = std::getenv("AM_INSTRUMENT_OUTPUT");
+          if (!filename || !*filename)
+            return;
+          const std::string filename_string(filename);
+          const bool json = (filename_string.size()>=5)
+            && (filename_string.compare(filename_string.size()-5, 5, ".json")==0);
+          SetInstrumentOutput(filename_string, json ? InstrumentFormat::kJSON : InstrumentFormat::kText);
+        });
+    }
+
+  }  // namespace detail
+
+#endif  // AM_INSTRUMENT
+
+}  // namespace am
+
+#endif  // AM_INSTRUMENT_H_
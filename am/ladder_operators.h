@@ -0,0 +1,368 @@
+/****************************************************************
+  ladder_operators.h
+
+  Applies angular momentum operators J+, J-, Jz, and J^2 to vectors in an
+  m-scheme product basis, and projects such vectors onto good total J.
+
+  The product basis for angular momenta j_1,...,j_n consists of states
+  |j_1 m_1; ...; j_n m_n>, indexed in mixed radix, with the last factor
+  running fastest:
+
+    index = (...((j_1+m_1)*(2*j_2+1) + (j_2+m_2))*(2*j_3+1) + ...) + (j_n+m_n).
+
+  The total angular momentum operators are J=sum_i j_i.  Each factor j_i acts
+  on an (outer,2*j_i+1,inner) view of the vector, so the innermost loops run
+  over contiguous blocks of length inner.  The matrix elements
+
+    <j m+1|j+|j m> = <j m|j-|j m+1> = sqrt((j-m)(j+m+1))
+
+  are precomputed for each factor.
+
+  Vectors are addressed with a stride, i.e., component a of vector x is
+  x[a*stride].
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Reuse workspace across J^2 applications in ProjectJ,
+    parallelize elementwise loops, and validate J_min.
+
+****************************************************************/
+
+#ifndef AM_LADDER_OPERATORS_H_
+#define AM_LADDER_OPERATORS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "am.h"
+#include "parallel.h"
+
+namespace am {
+
+  class ProductMSchemeLayout
+  // Layout of m-scheme product basis for angular momenta j_1,...,j_n.
+  {
+   public:
+
+    explicit ProductMSchemeLayout(const HalfInt::vector& j_values)
+      : j_values_(j_values), dimension_(1)
+    {
+      const std::size_t num_factors = j_values_.size();
+      factor_dimensions_.resize(num_factors);
+      inner_dimensions_.resize(num_factors);
+      ladder_factors_.resize(num_factors);
+      for (std::size_t i=0; i<num_factors; ++i)
+        {
+          if (j_values_[i]<0)
+            throw std::invalid_argument("negative angular momentum in ProductMSchemeLayout");
+          factor_dimensions_[i] = dim(j_values_[i]);
+        }
+      for (std::size_t i=num_factors; i-->0;)
+        {
+          inner_dimensions_[i] = dimension_;
+          dimension_ *= factor_dimensions_[i];
+        }
+
+      // ladder factors sqrt((j-m)(j+m+1)), indexed by j+m, for m=-j,...,j-1
+      for (std::size_t i=0; i<num_factors; ++i)
+        {
+          const int two_j = TwiceValue(j_values_[i]);
+          ladder_factors_[i].resize(two_j);
+          for (int k=0; k<two_j; ++k)
+            ladder_factors_[i][k] = std::sqrt(double((two_j-k)*(k+1)));
+        }
+
+      // total angular momentum range
+      HalfInt j_sum = 0, j_largest = 0;
+      for (const HalfInt& j : j_values_)
+        {
+          j_sum += j;
+          j_largest = std::max(j_largest,j);
+        }
+      J_max_ = j_sum;
+      J_min_ = std::max(j_largest-(j_sum-j_largest), IsInteger(j_sum) ? HalfInt(0) : HalfInt(1,2));
+    }
+
+    // factor accessors
+    std::size_t num_factors() const {return j_values_.size();}
+    const HalfInt::vector& j_values() const {return j_values_;}
+    std::size_t factor_dimension(std::size_t i) const {return factor_dimensions_[i];}
+    std::size_t inner_dimension(std::size_t i) const {return inner_dimensions_[i];}
+    std::size_t outer_dimension(std::size_t i) const
+    {
+      return dimension_/(factor_dimensions_[i]*inner_dimensions_[i]);
+    }
+    const std::vector<double>& ladder_factors(std::size_t i) const {return ladder_factors_[i];}
+
+    // basis accessors
+    std::size_t dimension() const {return dimension_;}
+    HalfInt J_min() const {return J_min_;}
+    HalfInt J_max() const {return J_max_;}
+
+    std::size_t Index(const HalfInt::vector& m_values) const
+    // Index of product state with given projections m_1,...,m_n.
+    {
+      std::size_t index = 0;
+      for (std::size_t i=0; i<num_factors(); ++i)
+        index = index*factor_dimensions_[i] + int(j_values_[i]+m_values[i]);
+      return index;
+    }
+
+   private:
+    HalfInt::vector j_values_;
+    std::size_t dimension_;
+    std::vector<std::size_t> factor_dimensions_, inner_dimensions_;
+    std::vector<std::vector<double>> ladder_factors_;
+    HalfInt J_min_, J_max_;
+  };
+
+  namespace detail {
+
+    // minimum number of vector components per parallel task
+    constexpr std::ptrdiff_t kLadderGrain = 4096;
+
+    enum class LadderComponent {kPlus, kMinus, kZ};
+
+    inline
+    void AccumulateLadder(
+        const ProductMSchemeLayout& layout, LadderComponent component,
+        const double* x, std::ptrdiff_t x_stride,
+        double* y, std::ptrdiff_t y_stride
+      )
+    // Accumulate y += J_component x, one factor at a time.
+    //
+    // For each factor, the (outer,k) slices of y receiving contributions are
+    // disjoint, so slices are distributed over threads.
+    {
+      for (std::size_t i=0; i<layout.num_factors(); ++i)
+        {
+          const std::ptrdiff_t d = layout.factor_dimension(i);
+          const std::ptrdiff_t inner = layout.inner_dimension(i);
+          const std::ptrdiff_t outer = layout.outer_dimension(i);
+          const int two_j = TwiceValue(layout.j_values()[i]);
+          const double* c = layout.ladder_factors(i).data();
+          const std::ptrdiff_t num_k = (component==LadderComponent::kZ) ? d : d-1;
+          if (num_k==0)
+            continue;
+          const std::ptrdiff_t grain = std::max<std::ptrdiff_t>(1, kLadderGrain/inner);
+          ParallelForRange(0, outer*num_k, grain, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+              for (std::ptrdiff_t slice=begin; slice<end; ++slice)
+                {
+                  const std::ptrdiff_t o = slice/num_k;
+                  const std::ptrdiff_t k = slice%num_k;
+                  std::ptrdiff_t source, target;
+                  double factor;
+                  switch (component)
+                    {
+                    case LadderComponent::kPlus:  // |k> -> |k+1>
+                      source = (o*d+k)*inner; target = source+inner; factor = c[k];
+                      break;
+                    case LadderComponent::kMinus:  // |k+1> -> |k>
+                      target = (o*d+k)*inner; source = target+inner; factor = c[k];
+                      break;
+                    default:  // |k> -> m |k>
+                      source = target = (o*d+k)*inner; factor = (2*k-two_j)/2.;
+                      break;
+                    }
+                  const double* xs = x+source*x_stride;
+                  double* ys = y+target*y_stride;
+                  if ((x_stride==1)&&(y_stride==1))
+                    {
+                      AM_OMP_SIMD
+                      for (std::ptrdiff_t a=0; a<inner; ++a)
+                        ys[a] += factor*xs[a];
+                    }
+                  else
+                    {
+                      for (std::ptrdiff_t a=0; a<inner; ++a)
+                        ys[a*y_stride] += factor*xs[a*x_stride];
+                    }
+                }
+            });
+        }
+    }
+
+    template<typename F>
+    void ElementwiseFor(std::size_t dimension, F&& f)
+    // Evaluate f(a) for a in [0,dimension), distributing chunks over threads.
+    {
+      ParallelForRange(0, std::ptrdiff_t(dimension), kLadderGrain, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t a=begin; a<end; ++a)
+            f(a);
+        });
+    }
+
+    inline
+    void Clear(std::size_t dimension, double* y, std::ptrdiff_t y_stride)
+    {
+      ElementwiseFor(dimension, [=](std::ptrdiff_t a) {y[a*y_stride] = 0.;});
+    }
+
+  }  // namespace detail
+
+  inline
+  void ApplyJPlus(
+      const ProductMSchemeLayout& layout,
+      const double* x, std::ptrdiff_t x_stride,
+      double* y, std::ptrdiff_t y_stride
+    )
+  // Evaluate y = J+ x.
+  //
+  // Vectors x and y must not overlap.
+  {
+    detail::Clear(layout.dimension(), y, y_stride);
+    detail::AccumulateLadder(layout, detail::LadderComponent::kPlus, x, x_stride, y, y_stride);
+  }
+
+  inline
+  void ApplyJMinus(
+      const ProductMSchemeLayout& layout,
+      const double* x, std::ptrdiff_t x_stride,
+      double* y, std::ptrdiff_t y_stride
+    )
+  // Evaluate y = J- x.
+  //
+  // Vectors x and y must not overlap.
+  {
+    detail::Clear(layout.dimension(), y, y_stride);
+    detail::AccumulateLadder(layout, detail::LadderComponent::kMinus, x, x_stride, y, y_stride);
+  }
+
+  inline
+  void ApplyJz(
+      const ProductMSchemeLayout& layout,
+      const double* x, std::ptrdiff_t x_stride,
+      double* y, std::ptrdiff_t y_stride
+    )
+  // Evaluate y = Jz x.
+  //
+  // Vectors x and y must not overlap.
+  {
+    detail::Clear(layout.dimension(), y, y_stride);
+    detail::AccumulateLadder(layout, detail::LadderComponent::kZ, x, x_stride, y, y_stride);
+  }
+
+  inline
+  void ApplyJ2(
+      const ProductMSchemeLayout& layout,
+      const double* x, std::ptrdiff_t x_stride,
+      double* y, std::ptrdiff_t y_stride,
+      double* workspace
+    )
+  // Evaluate y = J^2 x, as J^2 = J- J+ + Jz (Jz+1), with caller-provided
+  // workspace.
+  //
+  // Vectors x and y must not overlap.
+  //
+  // Arguments:
+  //   workspace (scratch): storage for 2*layout.dimension() values
+  {
+    const std::size_t dimension = layout.dimension();
+    double* t = workspace;
+    double* u = workspace+dimension;
+
+    // y = J- J+ x
+    detail::Clear(dimension, t, 1);
+    detail::AccumulateLadder(layout, detail::LadderComponent::kPlus, x, x_stride, t, 1);
+    ApplyJMinus(layout, t, 1, y, y_stride);
+
+    // y += Jz (Jz x) + Jz x
+    detail::Clear(dimension, t, 1);
+    detail::Clear(dimension, u, 1);
+    detail::AccumulateLadder(layout, detail::LadderComponent::kZ, x, x_stride, t, 1);
+    detail::AccumulateLadder(layout, detail::LadderComponent::kZ, t, 1, u, 1);
+    detail::ElementwiseFor(dimension, [=](std::ptrdiff_t a) {y[a*y_stride] += u[a]+t[a];});
+  }
+
+  inline
+  void ApplyJ2(
+      const ProductMSchemeLayout& layout,
+      const double* x, std::ptrdiff_t x_stride,
+      double* y, std::ptrdiff_t y_stride
+    )
+  // Evaluate y = J^2 x, as J^2 = J- J+ + Jz (Jz+1).
+  //
+  // Vectors x and y must not overlap.
+  //
+  // Workspace is allocated for each call.  For repeated application, use the
+  // overload taking caller-provided workspace.
+  {
+    std::vector<double> workspace(2*layout.dimension());
+    ApplyJ2(layout, x, x_stride, y, y_stride, workspace.data());
+  }
+
+  inline
+  void ProjectJ(
+      const ProductMSchemeLayout& layout, const HalfInt& J,
+      double* x, std::ptrdiff_t x_stride,
+      HalfInt J_min = -1
+    )
+  // Project vector onto total angular momentum J, by Lowdin's projection
+  // operator
+  //
+  //   P_J = prod_{J'!=J} [J^2-J'(J'+1)]/[J(J+1)-J'(J'+1)].
+  //
+  // One application of J^2 is required for each J' in the product.  If x is
+  // known to contain only components with J'>=J_min (e.g., J_min=|M| for a
+  // vector of good M), passing J_min removes the corresponding factors.
+  //
+  // Arguments:
+  //   layout (input): basis layout
+  //   J (input): target angular momentum
+  //   x (input/output): vector to project, overwritten by projected vector
+  //   x_stride (input): stride of x
+  //   J_min (input, optional): lower bound on J' present in x, which must
+  //     differ from J by an integer, and satisfy J_min<=J
+  {
+    const std::size_t dimension = layout.dimension();
+    if (J_min>=0)
+      {
+        #ifdef AM_EXCEPTIONS
+        if (!IsInteger(J-J_min))
+          throw std::invalid_argument("J_min and J of different integer class in ProjectJ");
+        if (J_min>J)
+          throw std::invalid_argument("J_min exceeds J in ProjectJ");
+        #else
+        if (!IsInteger(J-J_min) || (J_min>J))
+          {
+            detail::Clear(dimension, x, x_stride);
+            return;
+          }
+        #endif
+      }
+    if (!IsInteger(J-layout.J_max()) || (J<layout.J_min()) || (J>layout.J_max()))
+      {
+        detail::Clear(dimension, x, x_stride);
+        return;
+      }
+    const HalfInt J_lower = std::max(layout.J_min(), J_min);
+
+    // vectors v (current iterate) and w (J^2 v), and workspace for ApplyJ2,
+    // allocated once for all factors
+    std::vector<double> storage(4*dimension);
+    double* v = storage.data();
+    double* w = v+dimension;
+    double* workspace = w+dimension;
+    detail::ElementwiseFor(dimension, [=](std::ptrdiff_t a) {v[a] = x[a*x_stride];});
+    const double casimir = double(J)*double(J+1);
+    for (HalfInt Jp=J_lower; Jp<=layout.J_max(); ++Jp)
+      {
+        if (Jp==J)
+          continue;
+        const double casimir_p = double(Jp)*double(Jp+1);
+        const double normalization = 1./(casimir-casimir_p);
+        ApplyJ2(layout, v, 1, w, 1, workspace);
+        detail::ElementwiseFor(dimension, [=](std::ptrdiff_t a) {v[a] = normalization*(w[a]-casimir_p*v[a]);});
+      }
+    detail::ElementwiseFor(dimension, [=](std::ptrdiff_t a) {x[a*x_stride] = v[a];});
+  }
+
+}  // namespace am
+
+#endif  // AM_LADDER_OPERATORS_H_
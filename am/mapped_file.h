@@ -0,0 +1,134 @@
+/****************************************************************
+  mapped_file.h
+
+  Read-only memory mapping of a file, for zero-copy access to large data
+  files.
+
+  On POSIX systems, the file is mapped with mmap.  Elsewhere, the file
+  contents are read into memory, so that the interface remains available.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+
+****************************************************************/
+
+#ifndef AM_MAPPED_FILE_H_
+#define AM_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define AM_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace am {
+
+  class MappedFile
+  // Read-only view of file contents.
+  //
+  // The mapping is released on destruction.  MappedFile is movable but not
+  // copyable.
+  {
+   public:
+
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& filename)
+    // Map file.
+    //
+    // Throws std::runtime_error if the file cannot be opened or mapped.
+    {
+#ifdef AM_HAVE_MMAP
+      const int fd = ::open(filename.c_str(), O_RDONLY);
+      if (fd<0)
+        throw std::runtime_error("cannot open file " + filename);
+      struct stat status;
+      if (::fstat(fd, &status)!=0)
+        {
+          ::close(fd);
+          throw std::runtime_error("cannot stat file " + filename);
+        }
+      size_ = std::size_t(status.st_size);
+      if (size_>0)
+        {
+          void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+          if (address==MAP_FAILED)
+            {
+              ::close(fd);
+              throw std::runtime_error("cannot map file " + filename);
+            }
+          data_ = static_cast<const char*>(address);
+        }
+      ::close(fd);
+#else
+      std::ifstream stream(filename, std::ios::binary);
+      if (!stream)
+        throw std::runtime_error("cannot open file " + filename);
+      buffer_.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+      data_ = buffer_.data();
+      size_ = buffer_.size();
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept {*this = std::move(other);}
+
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+      if (this!=&other)
+        {
+          Release();
+          data_ = std::exchange(other.data_, nullptr);
+          size_ = std::exchange(other.size_, 0);
+#ifndef AM_HAVE_MMAP
+          buffer_ = std::move(other.buffer_);
+          data_ = buffer_.data();
+#endif
+        }
+      return *this;
+    }
+
+    ~MappedFile() {Release();}
+
+    // accessors
+    const char* data() const {return data_;}
+    std::size_t size() const {return size_;}
+    bool empty() const {return size_==0;}
+
+   private:
+
+    void Release()
+    {
+#ifdef AM_HAVE_MMAP
+      if (data_)
+        ::munmap(const_cast<char*>(data_), size_);
+#endif
+      data_ = nullptr;
+      size_ = 0;
+    }
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifndef AM_HAVE_MMAP
+    std::vector<char> buffer_;
+#endif
+  };
+
+}  // namespace am
+
+#endif  // AM_MAPPED_FILE_H_
@@ -0,0 +1,188 @@
+/****************************************************************
+  multiplicity.h
+
+  Multiplicities of total angular momentum J in the coupling of several
+  angular momenta (distinguishable particles), or of n identical fermions
+  in a single-j shell, without enumeration of coupled states.
+
+  The multiplicities are obtained from the distribution of total projection
+  M over the m-scheme product states, as N(J)=c(M=J)-c(M=J+1).  The M
+  distribution is the generating function
+
+    distinguishable:  prod_i (x^(-j_i)+...+x^(j_i))
+    fermions:         coefficient of y^n in prod_m (1+y x^m)
+
+  For distinguishable particles, multiplication by each factor is a moving
+  window sum, evaluated in time linear in the length of the distribution,
+  so the full product costs O(n L) for n angular momenta and distribution
+  length L.  For fermions, the polynomial in y is truncated at y^n, giving
+  O((2j+1) n L).
+
+  The count type is a template parameter.  Counts are exact for integer
+  types (std::uint64_t by default) as long as they do not overflow; a
+  floating point type may be used for estimates of astronomically large
+  counts.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+
+****************************************************************/
+
+#ifndef AM_MULTIPLICITY_H_
+#define AM_MULTIPLICITY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "halfint.h"
+
+namespace am {
+
+  template<typename T = std::uint64_t>
+  struct AngularMomentumMultiplicities
+  // Multiplicities of total angular momentum J.
+  //
+  // The multiplicity of J=J_min+i is counts[i], where J_min is 0 or 1/2.
+  {
+    HalfInt J_min;
+    std::vector<T> counts;
+
+    HalfInt J_max() const {return J_min+HalfInt(int(counts.size())-1);}
+
+    T operator()(const HalfInt& J) const
+    // Multiplicity of J (zero outside range or for wrong integer class).
+    {
+      const HalfInt offset = J-J_min;
+      if (!IsInteger(offset) || (offset<0) || (int(offset)>=int(counts.size())))
+        return T(0);
+      return counts[int(offset)];
+    }
+
+    T total_dimension() const
+    // Total m-scheme dimension sum (2J+1)N(J).
+    {
+      T dimension(0);
+      for (std::size_t i=0; i<counts.size(); ++i)
+        dimension += T(TwiceValue(J_min)+2*int(i)+1)*counts[i];
+      return dimension;
+    }
+  };
+
+  template<typename T = std::uint64_t>
+  inline
+  AngularMomentumMultiplicities<T> MultiplicitiesFromMDistribution(const std::vector<T>& distribution)
+  // Obtain J multiplicities from M distribution.
+  //
+  // Arguments:
+  //   distribution (input): number of states with M=-M_max,...,M_max
+  //     (symmetric)
+  //
+  // Returns:
+  //   (AngularMomentumMultiplicities): multiplicities
+  {
+    AngularMomentumMultiplicities<T> multiplicities;
+    if (distribution.empty())
+      return multiplicities;
+    const int two_M_max = int(distribution.size())-1;
+    multiplicities.J_min = HalfInt(two_M_max%2,2);
+    const std::size_t num_J = std::size_t(two_M_max/2)+1;
+    multiplicities.counts.resize(num_J);
+    // M=J entry is at index M_max+J
+    const std::size_t base = distribution.size()-num_J;
+    for (std::size_t i=0; i<num_J; ++i)
+      multiplicities.counts[i] = distribution[base+i]-((i+1<num_J) ? distribution[base+i+1] : T(0));
+    return multiplicities;
+  }
+
+  template<typename T = std::uint64_t>
+  inline
+  std::vector<T> ProductMDistribution(const HalfInt::vector& j)
+  // Obtain M distribution for product of angular momenta.
+  //
+  // Arguments:
+  //   j (input): angular momenta
+  //
+  // Returns:
+  //   (std::vector<T>): number of states with M=-M_max,...,M_max
+  {
+    std::vector<T> distribution{T(1)}, next;
+    for (const HalfInt& ji : j)
+      {
+        if (ji<0)
+          throw std::invalid_argument("negative angular momentum in ProductMDistribution");
+        const std::size_t width = std::size_t(TwiceValue(ji))+1;
+        next.assign(distribution.size()+width-1, T(0));
+        // moving window sum: next[k] = sum_{i=k-width+1}^{k} distribution[i]
+        T window(0);
+        for (std::size_t k=0; k<next.size(); ++k)
+          {
+            if (k<distribution.size())
+              window += distribution[k];
+            if (k>=width)
+              window -= distribution[k-width];
+            next[k] = window;
+          }
+        distribution.swap(next);
+      }
+    return distribution;
+  }
+
+  template<typename T = std::uint64_t>
+  inline
+  std::vector<T> FermionMDistribution(const HalfInt& j, int n)
+  // Obtain M distribution for n identical fermions in a single-j shell.
+  //
+  // Arguments:
+  //   j (input): shell angular momentum
+  //   n (input): number of particles
+  //
+  // Returns:
+  //   (std::vector<T>): number of antisymmetric states with
+  //     M=-M_max,...,M_max, or empty if n exceeds the shell capacity
+  {
+    if (j<0)
+      throw std::invalid_argument("negative angular momentum in FermionMDistribution");
+    const int num_m = TwiceValue(j)+1;
+    if ((n<0) || (n>num_m))
+      return std::vector<T>();
+
+    // count[k][u]: number of ways of choosing k distinct m, with sum over
+    // chosen m of (j+m) equal to u
+    const int u_max = n*(num_m-1)-n*(n-1)/2;
+    std::vector<std::vector<T>> count(n+1, std::vector<T>(u_max+1, T(0)));
+    count[0][0] = T(1);
+    for (int shift=0; shift<num_m; ++shift)
+      for (int k=std::min(n,shift+1); k>=1; --k)
+        for (int u=u_max; u>=shift; --u)
+          count[k][u] += count[k-1][u-shift];
+
+    // the n-particle sums u range over [n(n-1)/2, u_max]
+    const int u_min = n*(n-1)/2;
+    return std::vector<T>(count[n].begin()+u_min, count[n].end());
+  }
+
+  template<typename T = std::uint64_t>
+  inline
+  AngularMomentumMultiplicities<T> ProductAngularMomentumMultiplicities(const HalfInt::vector& j)
+  // Obtain multiplicities of J in coupling of distinguishable angular
+  // momenta j_1,...,j_n.
+  {
+    return MultiplicitiesFromMDistribution(ProductMDistribution<T>(j));
+  }
+
+  template<typename T = std::uint64_t>
+  inline
+  AngularMomentumMultiplicities<T> FermionAngularMomentumMultiplicities(const HalfInt& j, int n)
+  // Obtain multiplicities of J for n identical fermions in a single-j shell.
+  {
+    return MultiplicitiesFromMDistribution(FermionMDistribution<T>(j, n));
+  }
+
+}  // namespace am
+
+#endif  // AM_MULTIPLICITY_H_
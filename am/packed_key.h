@@ -0,0 +1,255 @@
+/****************************************************************
+  packed_key.h
+
+  Defines am::PackedKey<N>, a fixed-arity tuple of HalfInt values packed
+  into one or two 64-bit words, for use as a key in hashed or ordered
+  containers.
+
+  The values are stored as biased twice-values in fixed-width bit fields.
+  The field width is chosen as large as possible, given the number of
+  fields:
+
+    N     words  bits  max |2j|
+    1-2   1      32    2^31
+    3     1      21    2^20
+    4     1      16    2^15
+    5-6   2      21    2^20
+    7-8   2      16    2^15
+    9-10  2      12    2^11
+    11-16 2      8-10  2^7-2^9
+
+  Construction of a key from values outside the representable range throws
+  std::out_of_range.
+
+  Equality and ordering compare whole words.  Hashing mixes the words by two
+  64x64->128-bit multiply-folds (as in wyhash), so that all bits of all
+  fields affect all bits of the hash, in contrast to the common combination
+  of per-element hashes of a std::tuple, for which g++'s identity hash of int
+  leaves hash values poorly distributed.  The hash value is the same on all
+  platforms (with a portable fallback where no 128-bit integer type is
+  available), as required for table files (symbol_cache.h).
+
+  In packed_key_test, hashing a PackedKey<6> takes about 40% of the time of
+  hashing the equivalent std::tuple.  However, the time for insertion into
+  and lookup in std::unordered_map is dominated by node allocation and
+  memory access, and is about the same for both key types.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Add FromWords.
+  + 10/18/26: Replace splitmix64 finalizer with cheaper multiply-fold mixer.
+  + 10/18/26: Declare 128-bit type with __extension__, for -Wpedantic.
+
+****************************************************************/
+
+#ifndef AM_PACKED_KEY_H_
+#define AM_PACKED_KEY_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+#include "halfint.h"
+
+namespace am {
+
+  namespace detail {
+
+#ifdef __SIZEOF_INT128__
+    // compiler extension type (GCC, Clang), marked to silence -Wpedantic
+    __extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+    constexpr inline
+    std::uint64_t MultiplyFold(std::uint64_t a, std::uint64_t b)
+    // Fold 128-bit product of words to 64 bits (as in wyhash).
+    {
+#ifdef __SIZEOF_INT128__
+      const uint128_t product = uint128_t(a)*b;
+      return std::uint64_t(product)^std::uint64_t(product>>64);
+#else
+      // portable product from 32-bit halves, giving same result
+      const std::uint64_t a_lo = a&0xffffffffULL, a_hi = a>>32;
+      const std::uint64_t b_lo = b&0xffffffffULL, b_hi = b>>32;
+      const std::uint64_t lo_lo = a_lo*b_lo, hi_lo = a_hi*b_lo, lo_hi = a_lo*b_hi, hi_hi = a_hi*b_hi;
+      const std::uint64_t cross = (lo_lo>>32) + (hi_lo&0xffffffffULL) + lo_hi;
+      const std::uint64_t lo = (cross<<32) | (lo_lo&0xffffffffULL);
+      const std::uint64_t hi = hi_hi + (hi_lo>>32) + (cross>>32);
+      return lo^hi;
+#endif
+    }
+
+    constexpr inline
+    std::uint64_t MixWords(std::uint64_t a, std::uint64_t b)
+    // Mix two 64-bit words into one, by two multiply-folds (wyhash-style).
+    {
+      return MultiplyFold(
+          MultiplyFold(a^0xa0761d6478bd642fULL, b^0xe7037ed1a0b428dbULL),
+          0x8ebc6af09c88c6e3ULL
+        );
+    }
+
+  }  // namespace detail
+
+  template<std::size_t N>
+  class PackedKey
+  // Tuple of N HalfInt values packed into one or two 64-bit words.
+  //
+  // Example:
+  //
+  //   std::unordered_map<am::Wigner6JKey,double> cache;
+  //   cache[am::Wigner6JKey(ja,jb,jc,jd,je,jf)] = value;
+  {
+    static_assert((N>=1) && (N<=16), "PackedKey supports 1 to 16 fields");
+
+   public:
+
+    // layout
+    static constexpr std::size_t kNumFields = N;
+    static constexpr std::size_t kNumWords = (N<=4) ? 1 : 2;
+    static constexpr std::size_t kFieldsPerWord = (N+kNumWords-1)/kNumWords;
+    static constexpr int kFieldBits = (kFieldsPerWord<=2) ? 32 : int(64/kFieldsPerWord);
+    static constexpr int kTwiceValueMin = -(std::int64_t(1)<<(kFieldBits-1));
+    static constexpr int kTwiceValueMax = (std::int64_t(1)<<(kFieldBits-1))-1;
+
+    constexpr PackedKey() : words_() {}
+
+    template<
+        typename... Ts,
+        std::enable_if_t<(sizeof...(Ts)==N) && (sizeof...(Ts)>0)>* = nullptr
+      >
+    constexpr explicit PackedKey(const Ts&... values)
+    // Construct key from N values convertible to HalfInt.
+      : words_()
+    {
+      const int twice_values[N] = {HalfInt(values).TwiceValue()...};
+      for (std::size_t i=0; i<N; ++i)
+        Set(i,twice_values[i]);
+    }
+
+    static constexpr PackedKey FromTwiceValues(const int* twice_values)
+    // Construct key from N twice-values.
+    {
+      PackedKey key;
+      for (std::size_t i=0; i<N; ++i)
+        key.Set(i,twice_values[i]);
+      return key;
+    }
+
+    static constexpr PackedKey FromWords(const std::array<std::uint64_t,kNumWords>& words)
+    // Construct key from packed words (as obtained from words()).
+    {
+      PackedKey key;
+      key.words_ = words;
+      return key;
+    }
+
+    // field accessors
+    constexpr int TwiceValue(std::size_t i) const
+    {
+      const std::uint64_t mask = (std::uint64_t(1)<<kFieldBits)-1;
+      const std::uint64_t field = (words_[i/kFieldsPerWord]>>Shift(i))&mask;
+      return int(std::int64_t(field)+kTwiceValueMin);
+    }
+    constexpr HalfInt operator[](std::size_t i) const {return HalfInt(TwiceValue(i),2);}
+
+    // word accessors
+    constexpr const std::array<std::uint64_t,kNumWords>& words() const {return words_;}
+
+    constexpr std::size_t Hash() const
+    // Hash key by mixing words.
+    {
+      if constexpr (kNumWords==1)
+        return std::size_t(detail::MixWords(words_[0], 0));
+      else
+        return std::size_t(detail::MixWords(words_[0], words_[1]));
+    }
+
+    // relational operators
+    friend constexpr bool operator==(const PackedKey& a, const PackedKey& b)
+    {
+      for (std::size_t w=0; w<kNumWords; ++w)
+        if (a.words_[w]!=b.words_[w])
+          return false;
+      return true;
+    }
+    friend constexpr bool operator!=(const PackedKey& a, const PackedKey& b) {return !(a==b);}
+    friend constexpr bool operator<(const PackedKey& a, const PackedKey& b)
+    // Lexicographic in words (not in field values).
+    {
+      for (std::size_t w=0; w<kNumWords; ++w)
+        if (a.words_[w]!=b.words_[w])
+          return a.words_[w]<b.words_[w];
+      return false;
+    }
+
+   private:
+
+    static constexpr int Shift(std::size_t i)
+    {
+      return int(i%kFieldsPerWord)*kFieldBits;
+    }
+
+    constexpr void Set(std::size_t i, int twice_value)
+    {
+      if ((twice_value<kTwiceValueMin) || (twice_value>kTwiceValueMax))
+        throw std::out_of_range("value out of range for PackedKey field");
+      const std::uint64_t field = std::uint64_t(std::int64_t(twice_value)-kTwiceValueMin);
+      words_[i/kFieldsPerWord] |= field<<Shift(i);
+    }
+
+    std::array<std::uint64_t,kNumWords> words_;
+  };
+
+  template<std::size_t N>
+  inline
+  std::size_t hash_value(const PackedKey<N>& key)
+  {
+    return key.Hash();
+  }
+
+  struct PackedKeyHash
+  // Hasher for PackedKey, for explicit use as unordered container template
+  // argument.
+  {
+    template<std::size_t N>
+    std::size_t operator()(const PackedKey<N>& key) const
+    {
+      return key.Hash();
+    }
+  };
+
+  ////////////////////////////////////////////////////////////////
+  // ready-made key types
+  ////////////////////////////////////////////////////////////////
+
+  // Wigner 3-j arguments (ja,jb,jc,ma,mb,mc)
+  typedef PackedKey<6> Wigner3JKey;
+
+  // Wigner 6-j arguments (ja,jb,jc,jd,je,jf)
+  typedef PackedKey<6> Wigner6JKey;
+
+  // Wigner 9-j arguments (ja,jb,jc,jd,je,jf,jg,jh,ji)
+  typedef PackedKey<9> Wigner9JKey;
+
+  // single-particle basis labels (n,l,j) and (n,l,j,m)
+  typedef PackedKey<3> NLJKey;
+  typedef PackedKey<4> NLJMKey;
+
+}  // namespace am
+
+template<std::size_t N>
+struct std::hash<am::PackedKey<N>>
+{
+  std::size_t operator()(const am::PackedKey<N>& key) const
+  {
+    return key.Hash();
+  }
+};
+
+#endif  // AM_PACKED_KEY_H_
@@ -0,0 +1,301 @@
+/****************************************************************
+  parallel.h
+
+  Thread-parallel loop support for bulk am routines.
+
+  Parallelism is provided through OpenMP, if the including translation unit
+  is compiled with OpenMP enabled (see CMake option AM_ENABLE_OPENMP).
+  Otherwise, if AM_THREAD_POOL is defined (see CMake option
+  AM_ENABLE_THREAD_POOL), parallelism is provided through a process-wide
+  pool of persistent std::thread workers, e.g., for use from the Python
+  binding, where OpenMP may not be available.  Otherwise, loops run
+  serially.
+
+  The thread pool runs one parallel loop at a time.  A loop started while
+  the pool is busy (from another thread, or from within a loop body) runs
+  serially on the calling thread, rather than waiting.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Add std::thread pool backend (AM_THREAD_POOL).
+
+****************************************************************/
+
+#ifndef AM_PARALLEL_H_
+#define AM_PARALLEL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#elif defined(AM_THREAD_POOL)
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+#endif
+
+// vectorization hint for inner loops
+#ifdef _OPENMP
+#define AM_OMP_SIMD _Pragma("omp simd")
+#else
+#define AM_OMP_SIMD
+#endif
+
+namespace am {
+
+  namespace detail {
+    // requested number of threads for am bulk routines (0 for default)
+    inline std::atomic<int> num_threads{0};
+
+#if !defined(_OPENMP) && defined(AM_THREAD_POOL)
+    class ThreadPool
+    // Process-wide pool of persistent worker threads.
+    //
+    // Workers are started on demand, as larger numbers of threads are
+    // requested.
+    {
+     public:
+
+      static ThreadPool& Instance()
+      // Get pool for calling process.
+      //
+      // The pool is never destroyed, so that idle workers do not hold up
+      // program exit.  Worker threads do not survive fork(), so a child
+      // process abandons the parent's pool and starts a new one.
+      {
+#if defined(__unix__) || defined(__APPLE__)
+        static const int at_fork = pthread_atfork(nullptr, nullptr, [] {Current().store(nullptr);});
+        static_cast<void>(at_fork);
+#endif
+        ThreadPool* pool = Current().load();
+        if (!pool)
+          {
+            ThreadPool* new_pool = new ThreadPool;
+            if (Current().compare_exchange_strong(pool, new_pool))
+              pool = new_pool;
+            else
+              delete new_pool;
+          }
+        return *pool;
+      }
+
+      bool TryRun(int num_workers, const std::function<void(int)>& task)
+      // Evaluate task(worker) for worker in [0,num_workers), with worker 0 on
+      // the calling thread, and wait for completion.
+      //
+      // Task must not throw.
+      //
+      // Returns:
+      //   (bool): true if run, or false (without running task) if pool is
+      //     busy or called from within a task
+      {
+        if (InTask())
+          return false;
+        std::unique_lock<std::mutex> run_lock(run_mutex_, std::try_to_lock);
+        if (!run_lock)
+          return false;
+
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          for (; num_started_<num_workers-1; ++num_started_)
+            std::thread(&ThreadPool::Work, this, num_started_+1, generation_).detach();
+          task_ = &task;
+          num_workers_ = num_workers;
+          pending_ = num_workers-1;
+          ++generation_;
+        }
+        start_.notify_all();
+
+        InTask() = true;
+        task(0);
+        InTask() = false;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] {return pending_==0;});
+        task_ = nullptr;
+        return true;
+      }
+
+     private:
+
+      ThreadPool() = default;
+
+      static std::atomic<ThreadPool*>& Current()
+      {
+        static std::atomic<ThreadPool*> pool{nullptr};
+        return pool;
+      }
+
+      static bool& InTask()
+      // Whether calling thread is evaluating a task (nested loops run serially).
+      {
+        thread_local bool in_task = false;
+        return in_task;
+      }
+
+      void Work(int worker, unsigned long generation)
+      {
+        InTask() = true;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;)
+          {
+            start_.wait(lock, [&] {return generation_!=generation;});
+            generation = generation_;
+            if (worker>=num_workers_)
+              continue;
+            const std::function<void(int)>* task = task_;
+            lock.unlock();
+            (*task)(worker);
+            lock.lock();
+            if (--pending_==0)
+              done_.notify_one();
+          }
+      }
+
+      std::mutex run_mutex_;  // held for duration of TryRun
+      std::mutex mutex_;  // guards following members
+      std::condition_variable start_, done_;
+      int num_started_ = 0;
+      const std::function<void(int)>* task_ = nullptr;
+      int num_workers_ = 0;
+      int pending_ = 0;
+      unsigned long generation_ = 0;
+    };
+#endif
+  }
+
+  inline
+  void SetNumThreads(int num_threads)
+  // Set number of threads to be used by am bulk routines.
+  //
+  // Arguments:
+  //   num_threads (int): number of threads, or 0 to use the default (the
+  //     OpenMP default, or the hardware concurrency for the thread pool)
+  {
+    detail::num_threads.store(num_threads<0 ? 0 : num_threads);
+  }
+
+  inline
+  int GetNumThreads()
+  // Get number of threads which will be used by am bulk routines.
+  //
+  // Returns:
+  //   (int): number of threads (1 if compiled without OpenMP or thread
+  //     pool)
+  {
+#ifdef _OPENMP
+    int num_threads = detail::num_threads.load();
+    return (num_threads>0) ? num_threads : omp_get_max_threads();
+#elif defined(AM_THREAD_POOL)
+    int num_threads = detail::num_threads.load();
+    return (num_threads>0) ? num_threads : std::max(1, int(std::thread::hardware_concurrency()));
+#else
+    return 1;
+#endif
+  }
+
+  template<typename F>
+  void ParallelFor(std::ptrdiff_t begin, std::ptrdiff_t end, F&& f, int num_threads = 0)
+  // Evaluate f(i) for i in [begin,end), distributing iterations over threads.
+  //
+  // Iterations must be independent.  Iterations are dynamically scheduled,
+  // since the cost of evaluating angular momentum coefficients typically
+  // varies strongly with the loop index.  An exception thrown by f is
+  // rethrown on the calling thread, after the loop completes.
+  //
+  // The number of threads may be given explicitly, for this loop only, or
+  // else (num_threads=0) is given by GetNumThreads().
+  {
+#ifdef _OPENMP
+    if (num_threads<=0)
+      num_threads = GetNumThreads();
+    std::exception_ptr exception;
+    #pragma omp parallel for schedule(dynamic) num_threads(num_threads) if(end-begin>1)
+    for (std::ptrdiff_t i=begin; i<end; ++i)
+      {
+        try
+          {
+            f(i);
+          }
+        catch (...)
+          {
+            #pragma omp critical(am_parallel_exception)
+            if (!exception) exception = std::current_exception();
+          }
+      }
+    if (exception) std::rethrow_exception(exception);
+#else
+#ifdef AM_THREAD_POOL
+    if (num_threads<=0)
+      num_threads = GetNumThreads();
+    if ((num_threads>1) && (end-begin>1))
+      {
+        // workers claim iterations dynamically from shared counter
+        std::atomic<std::ptrdiff_t> next{begin};
+        std::exception_ptr exception;
+        std::mutex exception_mutex;
+        const std::function<void(int)> task = [&](int) {
+          for (std::ptrdiff_t i=next++; i<end; i=next++)
+            {
+              try
+                {
+                  f(i);
+                }
+              catch (...)
+                {
+                  std::lock_guard<std::mutex> lock(exception_mutex);
+                  if (!exception) exception = std::current_exception();
+                }
+            }
+        };
+        const int num_workers = int(std::min<std::ptrdiff_t>(num_threads, end-begin));
+        if (detail::ThreadPool::Instance().TryRun(num_workers, task))
+          {
+            if (exception) std::rethrow_exception(exception);
+            return;
+          }
+      }
+#else
+    static_cast<void>(num_threads);
+#endif
+    for (std::ptrdiff_t i=begin; i<end; ++i)
+      f(i);
+#endif
+  }
+
+  template<typename F>
+  void ParallelForRange(
+      std::ptrdiff_t begin, std::ptrdiff_t end, std::ptrdiff_t grain, F&& f,
+      int num_threads = 0
+    )
+  // Evaluate f(chunk_begin,chunk_end) over chunks of [begin,end), distributing
+  // chunks over threads.
+  //
+  // Chunks contain at least grain iterations (except possibly the last), so
+  // that loops with cheap iterations are not dominated by scheduling overhead.
+  {
+    if (end<=begin)
+      return;
+    if (grain<1)
+      grain = 1;
+    const std::ptrdiff_t num_chunks = (end-begin+grain-1)/grain;
+    ParallelFor(0, num_chunks, [&](std::ptrdiff_t chunk) {
+        const std::ptrdiff_t chunk_begin = begin+chunk*grain;
+        const std::ptrdiff_t chunk_end = (chunk_begin+grain<end) ? chunk_begin+grain : end;
+        f(chunk_begin, chunk_end);
+      }, num_threads);
+  }
+
+}  // namespace am
+
+#endif  // AM_PARALLEL_H_
@@ -17,6 +17,8 @@
   + 04/10/20 (pjf): Replace assertions with exceptions.
   + 03/04/22 (pjf): Use macro AM_EXCEPTIONS to toggle between throwing
       exceptions and simply returning zero.
+  + 10/18/26: Use tabulated Hat factors (factor_table.h).
+  + 10/18/26: Instrument calls under AM_INSTRUMENT (instrument.h).
 
 ****************************************************************/
 
@@ -25,6 +27,8 @@
 
 #include <stdexcept>
 #include <string>
+#include "factor_table.h"
+#include "instrument.h"
 #include "wigner_gsl.h"
 
 namespace am {
@@ -48,6 +52,7 @@ namespace am {
   // Returns:
   //   coefficient
   {
+    AM_INSTRUMENT_FUNCTION(RacahReductionFactorRose);
     #ifdef AM_EXCEPTIONS
     if (!AllowedTriangle(J0a, J0b, J0)) throw std::domain_error("triangle disallowed");
     if (!AllowedTriangle(Jp, J, J0)) throw std::domain_error("triangle disallowed");
@@ -57,7 +62,7 @@ namespace am {
     #endif
 
     double value = ParitySign(J0-Jp-J)
-      * Hat(Jpp) * Hat(J0)
+      * TabulatedHat(Jpp) * TabulatedHat(J0)
       * Wigner6J(Jp, J, J0, J0b, J0a, Jpp);
     return value;
   }
@@ -91,6 +96,7 @@ namespace am {
   // Returns:
   //   coefficient
   {
+    AM_INSTRUMENT_FUNCTION(RacahReductionFactor1Rose);
     #ifdef AM_EXCEPTIONS
     if (!(J2p==J2)) throw std::domain_error("triangle disallowed");
     if (!AllowedTriangle(Jp, J, J0)) throw std::domain_error("triangle disallowed");
@@ -102,7 +108,7 @@ namespace am {
     if (!AllowedTriangle(J1p, J1, J0)) return 0;
 
     double value = ParitySign(J1p+J2+J+J0)
-      *Hat(J1p)*Hat(J)
+      *TabulatedHat(J1p)*TabulatedHat(J)
       *Wigner6J(J1p,Jp,J2,J,J1,J0);
     return value;
   }
@@ -136,6 +142,7 @@ namespace am {
   // Returns:
   //   coefficient
   {
+    AM_INSTRUMENT_FUNCTION(RacahReductionFactor2Rose);
     #ifdef AM_EXCEPTIONS
     if (!(J1p==J1)) throw std::domain_error("triangle disallowed");
     if (!AllowedTriangle(Jp, J, J0)) throw std::domain_error("triangle disallowed");
@@ -147,7 +154,7 @@ namespace am {
     if (!AllowedTriangle(J2p, J2, J0)) return 0;
 
     double value = ParitySign(J1+J2+Jp+J0)
-      *Hat(J2p)*Hat(J)
+      *TabulatedHat(J2p)*TabulatedHat(J)
       *Wigner6J(Jp,J2p,J1,J2,J,J0);
     return value;
   }
@@ -172,6 +179,7 @@ namespace am {
   // Returns:
   //   coefficient
   {
+    AM_INSTRUMENT_FUNCTION(RacahReductionFactor12DotRose);
     #ifdef AM_EXCEPTIONS
     if (Jp!=J) throw std::domain_error("triangle disallowed");
     #else
@@ -182,7 +190,7 @@ namespace am {
     if (!AllowedTriangle(J2p, J2, J0)) return 0;
 
     double value = ParitySign(J2p+Jp+J1)
-      * Hat(J1p) * Hat(J2p)
+      * TabulatedHat(J1p) * TabulatedHat(J2p)
       * Wigner6J(J1p, J2p, Jp, J2, J1, J0);
     return value;
   }
@@ -213,6 +221,7 @@ namespace am {
   // Returns:
   //   coefficient
   {
+    AM_INSTRUMENT_FUNCTION(RacahReductionFactor12Rose);
     #ifdef AM_EXCEPTIONS
     if (!AllowedTriangle(Jp, J, J0)) throw std::domain_error("triangle disallowed");
     #else
@@ -222,8 +231,8 @@ namespace am {
     if (!AllowedTriangle(J1p, J1, J0a)) return 0;
     if (!AllowedTriangle(J2p, J2, J0b)) return 0;
 
-    double value = Hat(J0) * Hat(J)
-      * Hat(J1p) * Hat(J2p)
+    double value = TabulatedHat(J0) * TabulatedHat(J)
+      * TabulatedHat(J1p) * TabulatedHat(J2p)
       * Wigner9J(Jp, J, J0, J1p, J1, J0a, J2p, J2, J0b);
     return value;
   }
@@ -254,6 +263,7 @@ namespace am {
   // Returns:
   //   coefficient
   {
+    AM_INSTRUMENT_FUNCTION(RacahReductionFactor21Rose);
     #ifdef AM_EXCEPTIONS
     if (!AllowedTriangle(Jp, J, J0)) throw std::domain_error("triangle disallowed");
     #else
@@ -264,8 +274,8 @@ namespace am {
     if (!AllowedTriangle(J2p, J2, J0a)) return 0;
 
     double value = ParitySign(J0a + J0b - J0)
-      * Hat(J0) * Hat(J)
-      * Hat(J1p) * Hat(J2p)
+      * TabulatedHat(J0) * TabulatedHat(J)
+      * TabulatedHat(J1p) * TabulatedHat(J2p)
       * Wigner9J(Jp, J, J0, J1p, J1, J0b, J2p, J2, J0a);
     return value;
   }
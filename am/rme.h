@@ -26,18 +26,30 @@
     - Use C++20 math constants if available.
   + 04/19/22 (mac): Further expand docstrings.
   + 04/19/22 (pjf): Add additional references to docstrings.
+  + 10/18/26: Add SphericalHarmonicRMETable for tabulated spherical harmonic
+    RMEs, through which the spherical harmonic RME functions are routed when
+    initialized.
+  + 10/18/26: Use tabulated Hat and sqrt(j(j+1)) factors (factor_table.h).
+  + 10/18/26: Instrument calls under AM_INSTRUMENT (instrument.h).
 
 ****************************************************************/
 
 #ifndef RME_H_
 #define RME_H_
 
+#include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 #if __has_include(<numbers>)
 #  include <numbers>
 #endif
 
+#include "factor_table.h"
+#include "instrument.h"
+#include "parallel.h"
 #include "wigner_gsl.h"
 #include "racah_reduction.h"
 
@@ -55,6 +67,220 @@ namespace am {
 
   enum class AngularMomentumOperatorType : char {kOrbital='l', kSpin='s', kTotal='j'};
 
+  ////////////////////////////////////////////////////////////////
+  // spherical harmonic RME evaluation
+  ////////////////////////////////////////////////////////////////
+
+#ifndef SWIG
+  // The RME table is not exposed through the SWIG interface (python/am.i).
+
+  namespace detail {
+
+    inline
+    double SphericalHarmonicCRMEDirect(int lp, int l, int k)
+    // Evaluate spherical harmonic RME, without triangle checks.
+    //
+    // See SphericalHarmonicCRME.
+    {
+      // Brink & Satchler (1993), app. VI, p.153
+      return TabulatedHat(l) * ParitySign(lp) * Wigner3J(lp, k, l, 0, 0, 0);
+    }
+
+    inline
+    double LJCoupledSphericalHarmonicCRMEDirect(
+      int lp, const HalfInt& jp, int l, const HalfInt& j, int k)
+    // Evaluate lj-coupled spherical harmonic RME, without triangle checks.
+    //
+    // See LJCoupledSphericalHarmonicCRME.
+    {
+      // parity constraint
+      if ((lp+l+k)%2 != 0) {
+        return 0;
+      }
+
+      // Brink & Satchler (1993), app. VI, p.153
+      return TabulatedHat(j) * ParitySign(j + k - HalfInt(1, 2))
+        * Wigner3J(jp, j, k, HalfInt(1, 2), -HalfInt(1, 2), 0);
+    }
+
+  }  // namespace detail
+
+  class SphericalHarmonicRMETable
+  // Precomputed reduced matrix elements of spherical harmonics.
+  //
+  // Tabulates SphericalHarmonicCRME(lp,l,k) and
+  // LJCoupledSphericalHarmonicCRME(lp,jp,l,j,k) for 0<=lp,l<=lmax and
+  // 0<=k<=kmax, for lookup by direct index arithmetic.  Disallowed
+  // (triangle or parity) entries are stored as zero.
+  //
+  // Storage is (lmax+1)^2*(kmax+1) values for the spatial RMEs, and four times
+  // this for the lj-coupled RMEs, e.g., about 40 MB for lmax=kmax=100.
+  //
+  // Once constructed, a table is immutable and may be read concurrently from
+  // any number of threads.
+  //
+  // The spherical harmonic RME functions below (SphericalHarmonicCRME, etc.)
+  // route through the process-wide table installed by
+  // InitializeSphericalHarmonicRMETable, when one is present and the arguments
+  // lie within its range.  The check for a table costs every call one atomic
+  // acquire load of the table pointer, even if no table is ever installed.
+  // This is an ordinary load on x86 and a load-acquire instruction on ARM,
+  // which is negligible next to the direct evaluation (a GSL 3-j symbol).
+  {
+   public:
+
+    SphericalHarmonicRMETable() = default;
+
+    SphericalHarmonicRMETable(int lmax, int kmax)
+    // Construct and populate table.
+    //
+    // Entries are evaluated in parallel (see parallel.h).
+    //
+    // Arguments:
+    //   lmax (int): maximum bra and ket orbital angular momentum
+    //   kmax (int): maximum spherical harmonic rank
+      : lmax_(lmax), kmax_(kmax)
+    {
+      if ((lmax<0)||(kmax<0))
+        throw std::invalid_argument("negative angular momentum cutoff for SphericalHarmonicRMETable");
+
+      const std::size_t num_l = lmax_+1;
+      const std::size_t num_k = kmax_+1;
+      c_values_.resize(num_l*num_l*num_k);
+      lj_values_.resize(4*num_l*num_l*num_k);
+      y_factors_.resize(num_k);
+      for (int k=0; k<=kmax_; ++k)
+        y_factors_[k] = TabulatedHat(k) * kInvSqrt4Pi;
+
+      ParallelFor(0, lmax_+1, [this](std::ptrdiff_t lp_index) {
+          const int lp = static_cast<int>(lp_index);
+          for (int l=0; l<=lmax_; ++l)
+            for (int k=0; k<=kmax_; ++k)
+              {
+                c_values_[CIndex(lp,l,k)] = AllowedTriangle(lp, k, l)
+                  ? detail::SphericalHarmonicCRMEDirect(lp, l, k)
+                  : 0.;
+                for (int sp=0; sp<=1; ++sp)
+                  for (int s=0; s<=1; ++s)
+                    {
+                      HalfInt jp = lp + HalfInt(2*sp-1, 2);
+                      HalfInt j = l + HalfInt(2*s-1, 2);
+                      lj_values_[LJIndex(lp,sp,l,s,k)] = ((jp>=0) && (j>=0))
+                        ? detail::LJCoupledSphericalHarmonicCRMEDirect(lp, jp, l, j, k)
+                        : 0.;
+                    }
+              }
+        });
+    }
+
+    // range accessors
+    int lmax() const {return lmax_;}
+    int kmax() const {return kmax_;}
+    std::size_t size() const {return c_values_.size()+lj_values_.size();}
+
+    bool Contains(int lp, int l, int k) const
+    // Test whether arguments lie within range of table.
+    {
+      return (static_cast<unsigned>(lp)<=static_cast<unsigned>(lmax_))
+        && (static_cast<unsigned>(l)<=static_cast<unsigned>(lmax_))
+        && (static_cast<unsigned>(k)<=static_cast<unsigned>(kmax_));
+    }
+
+    double CRME(int lp, int l, int k) const
+    // Look up SphericalHarmonicCRME(lp,l,k).
+    //
+    // Precondition: Contains(lp,l,k).
+    {
+      return c_values_[CIndex(lp,l,k)];
+    }
+
+    double LJCoupledCRME(
+        int lp, const HalfInt& jp, int l, const HalfInt& j, int k
+      ) const
+    // Look up LJCoupledSphericalHarmonicCRME(lp,jp,l,j,k).
+    //
+    // Precondition: Contains(lp,l,k), and jp=lp+-1/2 and j=l+-1/2.
+    {
+      const int sp = (TwiceValue(jp)-2*lp+1)/2;
+      const int s = (TwiceValue(j)-2*l+1)/2;
+      return lj_values_[LJIndex(lp,sp,l,s,k)];
+    }
+
+    double YFactor(int k) const
+    // Look up conversion factor Hat(k)/sqrt(4*pi) from C to Y normalization.
+    //
+    // Precondition: 0<=k<=kmax.
+    {
+      return y_factors_[k];
+    }
+
+   private:
+
+    std::size_t CIndex(int lp, int l, int k) const
+    {
+      return (std::size_t(lp)*(lmax_+1)+l)*(kmax_+1)+k;
+    }
+
+    std::size_t LJIndex(int lp, int sp, int l, int s, int k) const
+    {
+      return (((std::size_t(lp)*2+sp)*(lmax_+1)+l)*2+s)*(kmax_+1)+k;
+    }
+
+    int lmax_ = -1;
+    int kmax_ = -1;
+    std::vector<double> c_values_;
+    std::vector<double> lj_values_;
+    std::vector<double> y_factors_;
+  };
+
+  ////////////////////////////////////////////////////////////////
+  // process-wide spherical harmonic RME table
+  ////////////////////////////////////////////////////////////////
+
+  namespace detail {
+    inline std::unique_ptr<const SphericalHarmonicRMETable> spherical_harmonic_rme_table_owner;
+    inline std::atomic<const SphericalHarmonicRMETable*> spherical_harmonic_rme_table{nullptr};
+  }
+
+  inline
+  void InitializeSphericalHarmonicRMETable(int lmax, int kmax)
+  // Build process-wide spherical harmonic RME table.
+  //
+  // Should be called once, at startup, before RMEs are evaluated from other
+  // threads.  Subsequent calls to the spherical harmonic RME functions with
+  // arguments in range are served from the table.
+  //
+  // Arguments:
+  //   lmax (int): maximum bra and ket orbital angular momentum
+  //   kmax (int): maximum spherical harmonic rank
+  {
+    auto table = std::make_unique<const SphericalHarmonicRMETable>(lmax, kmax);
+    detail::spherical_harmonic_rme_table.store(table.get(), std::memory_order_release);
+    detail::spherical_harmonic_rme_table_owner = std::move(table);
+  }
+
+  inline
+  void ClearSphericalHarmonicRMETable()
+  // Discard process-wide spherical harmonic RME table.
+  //
+  // Must not be called concurrently with RME evaluation.
+  {
+    detail::spherical_harmonic_rme_table.store(nullptr, std::memory_order_release);
+    detail::spherical_harmonic_rme_table_owner.reset();
+  }
+
+  inline
+  const SphericalHarmonicRMETable* GetSphericalHarmonicRMETable()
+  // Get process-wide spherical harmonic RME table.
+  //
+  // Returns:
+  //   (const SphericalHarmonicRMETable*): pointer to table, or nullptr if
+  //     not initialized
+  {
+    return detail::spherical_harmonic_rme_table.load(std::memory_order_acquire);
+  }
+#endif  // SWIG
+
   inline
   double SphericalHarmonicCRME(const int& lp, const int& l, const int& k)
   // Calculate reduced matrix element of spherical harmonic C between spatial
@@ -75,14 +301,18 @@ namespace am {
   // Returns:
   //   reduced matrix element (double), Rose convention
   {
+    AM_INSTRUMENT_FUNCTION(SphericalHarmonicCRME);
     #ifdef AM_EXCEPTIONS
     if (!AllowedTriangle(lp, k, l)) throw std::domain_error("triangle disallowed");
     #else
     if (!AllowedTriangle(lp, k, l)) return 0;
     #endif
 
-    // Brink & Satchler (1993), app. VI, p.153
-    double value = Hat(l) * ParitySign(lp) * Wigner3J(lp, k, l, 0, 0, 0);
+    const SphericalHarmonicRMETable* table = GetSphericalHarmonicRMETable();
+    if (table && table->Contains(lp, l, k))
+      return table->CRME(lp, l, k);
+
+    double value = detail::SphericalHarmonicCRMEDirect(lp, l, k);
     return value;
   }
 
@@ -110,6 +340,7 @@ namespace am {
   // Returns:
   //   reduced matrix element (double), Rose convention
   {
+    AM_INSTRUMENT_FUNCTION(LJCoupledSphericalHarmonicCRME);
     #ifdef AM_EXCEPTIONS
     if (!AllowedTriangle(lp, HalfInt(1, 2), jp)) throw std::domain_error("triangle disallowed");
     if (!AllowedTriangle(l, HalfInt(1, 2), j)) throw std::domain_error("triangle disallowed");
@@ -118,14 +349,11 @@ namespace am {
     if (!AllowedTriangle(l, HalfInt(1, 2), j)) return 0;
     #endif
 
-    // parity constraint
-    if ((lp+l+k)%2 != 0) {
-      return 0;
-    }
+    const SphericalHarmonicRMETable* table = GetSphericalHarmonicRMETable();
+    if (table && table->Contains(lp, l, k))
+      return table->LJCoupledCRME(lp, jp, l, j, k);
 
-    // Brink & Satchler (1993), app. VI, p.153
-    double value = Hat(j) * ParitySign(j + k - HalfInt(1, 2))
-      * Wigner3J(jp, j, k, HalfInt(1, 2), -HalfInt(1, 2), 0);
+    double value = detail::LJCoupledSphericalHarmonicCRMEDirect(lp, jp, l, j, k);
     return value;
   }
 
@@ -144,11 +372,15 @@ namespace am {
   // Returns:
   //   reduced matrix element (double), Rose convention
   {
+    AM_INSTRUMENT_FUNCTION(SphericalHarmonicYRME);
     // by converting normalization from RME for "C" spherical harmonic
     //
     // Brink & Satchler (1993), app. IV, p. 145
-    double value = Hat(k) * kInvSqrt4Pi
-      * SphericalHarmonicCRME(lp, l, k);
+    const SphericalHarmonicRMETable* table = GetSphericalHarmonicRMETable();
+    double y_factor = (table && table->Contains(lp, l, k))
+      ? table->YFactor(k)
+      : TabulatedHat(k) * kInvSqrt4Pi;
+    double value = y_factor * SphericalHarmonicCRME(lp, l, k);
     return value;
   }
 
@@ -171,11 +403,15 @@ namespace am {
   // Returns:
   //   reduced matrix element (double), Rose convention
   {
+    AM_INSTRUMENT_FUNCTION(LJCoupledSphericalHarmonicYRME);
     // by converting normalization from RME for "C" spherical harmonic
     //
     // Brink & Satchler (1993), app. IV, p. 145
-    double value = Hat(k) * kInvSqrt4Pi
-      * LJCoupledSphericalHarmonicCRME(lp, jp, l, j, k);
+    const SphericalHarmonicRMETable* table = GetSphericalHarmonicRMETable();
+    double y_factor = (table && table->Contains(lp, l, k))
+      ? table->YFactor(k)
+      : TabulatedHat(k) * kInvSqrt4Pi;
+    double value = y_factor * LJCoupledSphericalHarmonicCRME(lp, jp, l, j, k);
     return value;
   }
 
@@ -193,9 +429,10 @@ namespace am {
   // Returns:
   //   reduced matrix element (double), Rose convention
   {
+    AM_INSTRUMENT_FUNCTION(AngularMomentumJRME);
     if (J != Jp) return 0;
     // Brink & Satchler (1993), app. VI, p.153
-    double value = std::sqrt(double(Jp)*double(Jp+1));
+    double value = TabulatedSqrtJJ1(Jp);
     return value;
   }
 
@@ -216,6 +453,7 @@ namespace am {
   // Returns:
   //   reduced matrix element (double), Rose convention
   {
+    AM_INSTRUMENT_FUNCTION(jjJCoupledAngularMomentumJ1RME);
     #ifdef AM_EXCEPTIONS
     if (!AllowedTriangle(J1p, J2p, Jp)) throw std::domain_error("triangle disallowed");
     if (!AllowedTriangle(J1, J2, J)) throw std::domain_error("triangle disallowed");
@@ -232,7 +470,7 @@ namespace am {
     }
     // Brink & Satchler (1993), app. VI, p.152
     double value = ParitySign(1+J2p+J+J1p)
-      * std::sqrt(double(J1p)*double(J1p+1)*double(2*J1p+1)*double(2*J+1))
+      * TabulatedSqrtJJ1Hat(J1p) * TabulatedHat(J)
       * Wigner6J(Jp, J, 1, J1, J1p, J2p);
     return value;
   }
@@ -254,6 +492,7 @@ namespace am {
   // Returns:
   //   reduced matrix element (double), Rose convention
   {
+    AM_INSTRUMENT_FUNCTION(jjJCoupledAngularMomentumJ2RME);
     #ifdef AM_EXCEPTIONS
     if (!AllowedTriangle(J1p, J2p, Jp)) throw std::domain_error("triangle disallowed");
     if (!AllowedTriangle(J1, J2, J)) throw std::domain_error("triangle disallowed");
@@ -270,7 +509,7 @@ namespace am {
     }
     // Brink & Satchler (1993), app. VI, p.152
     double value = ParitySign(1+J1p+Jp+J2)
-      * std::sqrt(double(J2p)*double(J2p+1)*double(2*J2p+1)*double(2*J+1))
+      * TabulatedSqrtJJ1Hat(J2p) * TabulatedHat(J)
       * Wigner6J(Jp, J, 1, J2, J2p, J1p);
     return value;
   }
@@ -295,6 +534,7 @@ namespace am {
   // Returns:
   //   reduced matrix element (double), Rose convention
   {
+    AM_INSTRUMENT_FUNCTION(jjJCoupledAngularMomentumJRME);
     #ifdef AM_EXCEPTIONS
     if (!AllowedTriangle(J1p, J2p, Jp)) throw std::domain_error("triangle disallowed");
     if (!AllowedTriangle(J1, J2, J)) throw std::domain_error("triangle disallowed");
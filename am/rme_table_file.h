@@ -0,0 +1,583 @@
+/****************************************************************
+  rme_table_file.h
+
+  Binary columnar file format for tables of reduced matrix elements, with
+  zero-copy loading.
+
+  An RME table holds the RMEs <J'||T^k||J> of a tensor operator between a
+  bra basis and a ket basis, each organized into J-scheme subspaces (see
+  AngularMomentumSubspace in wigner_eckart.h), as dense blocks for pairs of
+  subspaces (see ReducedMatrixBlock in wigner_eckart.h).  The states of each
+  basis may carry label columns (e.g., n, l, j), stored as twice-values in
+  the narrowest integer width (1, 2, or 4 bytes) sufficient for the column.
+
+  File layout (native byte order, with byte order mark; all sections
+  8-byte aligned):
+
+    header (64 bytes):
+      char[8] magic "AMRMETBL"
+      uint32 version
+      uint32 byte order mark 0x01020304
+      int32 2k (twice tensor rank)
+      uint32 reserved
+      uint64 offset of bra basis section
+      uint64 offset of ket basis section
+      uint64 offset of block index
+      uint64 number of blocks
+      uint64 reserved
+
+    basis section:
+      uint64 number of subspaces
+      uint64 number of states
+      uint64 number of label columns
+      subspaces: {int32 2J, uint32 reserved, uint64 dimension}
+      label column descriptors: {char[16] name, uint32 width, uint32 reserved}
+      label column data: 2*label for each state, as int8, int16, or int32,
+        each column padded to 8 bytes
+
+    block payloads:
+      doubles, row-major, bra states as rows
+
+    block index:
+      {uint32 bra subspace, uint32 ket subspace, int32 2J', int32 2J,
+       uint64 payload offset, uint64 rows, uint64 columns}
+
+  The writer streams block payloads to the file as they are produced, then
+  appends the index and completes the header on Close().  The reader maps
+  the file (see mapped_file.h) and returns pointers directly into the
+  mapping, so that a block may be used without parsing or copying.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Validate block shapes against subspace dimensions on reading.
+  + 10/18/26: Reject basis dimensions not summing to state count, and
+    repeated blocks.
+
+****************************************************************/
+
+#ifndef AM_RME_TABLE_FILE_H_
+#define AM_RME_TABLE_FILE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "halfint.h"
+#include "mapped_file.h"
+#include "wigner_eckart.h"
+
+namespace am {
+
+  ////////////////////////////////////////////////////////////////
+  // basis description
+  ////////////////////////////////////////////////////////////////
+
+  struct RMETableBasis
+  // Basis description for RME table.
+  //
+  // States are ordered by subspace, then by index within subspace.  Label
+  // columns are optional; if present, labels[c] holds the value of column c
+  // for each state.
+  {
+    std::vector<AngularMomentumSubspace> subspaces;
+    std::vector<std::string> label_names;
+    std::vector<std::vector<HalfInt>> labels;
+
+    std::size_t num_states() const
+    {
+      std::size_t num_states = 0;
+      for (const AngularMomentumSubspace& subspace : subspaces)
+        num_states += subspace.dimension;
+      return num_states;
+    }
+  };
+
+  ////////////////////////////////////////////////////////////////
+  // on-disk records
+  ////////////////////////////////////////////////////////////////
+
+  namespace detail {
+
+    constexpr char kRMETableMagic[8] = {'A','M','R','M','E','T','B','L'};
+    constexpr std::uint32_t kRMETableVersion = 1;
+    constexpr std::uint32_t kRMETableByteOrderMark = 0x01020304;
+    constexpr std::size_t kRMETableLabelNameLength = 16;
+
+    struct RMETableHeader
+    {
+      char magic[8];
+      std::uint32_t version;
+      std::uint32_t byte_order_mark;
+      std::int32_t two_k;
+      std::uint32_t reserved0;
+      std::uint64_t bra_basis_offset;
+      std::uint64_t ket_basis_offset;
+      std::uint64_t index_offset;
+      std::uint64_t num_blocks;
+      std::uint64_t reserved1;
+    };
+    static_assert(sizeof(RMETableHeader)==64);
+
+    struct RMETableBasisHeader
+    {
+      std::uint64_t num_subspaces;
+      std::uint64_t num_states;
+      std::uint64_t num_label_columns;
+    };
+
+    struct RMETableSubspaceRecord
+    {
+      std::int32_t two_J;
+      std::uint32_t reserved;
+      std::uint64_t dimension;
+    };
+    static_assert(sizeof(RMETableSubspaceRecord)==16);
+
+    struct RMETableLabelRecord
+    {
+      char name[kRMETableLabelNameLength];
+      std::uint32_t width;
+      std::uint32_t reserved;
+    };
+    static_assert(sizeof(RMETableLabelRecord)==24);
+
+    struct RMETableIndexRecord
+    {
+      std::uint32_t bra_subspace_index;
+      std::uint32_t ket_subspace_index;
+      std::int32_t two_Jp;
+      std::int32_t two_J;
+      std::uint64_t offset;
+      std::uint64_t rows;
+      std::uint64_t cols;
+    };
+    static_assert(sizeof(RMETableIndexRecord)==40);
+
+    inline std::uint64_t AlignRMETableOffset(std::uint64_t offset)
+    {
+      return (offset+7)&~std::uint64_t(7);
+    }
+
+    inline
+    std::uint32_t NarrowestLabelWidth(const std::vector<HalfInt>& values)
+    // Narrowest integer width (bytes) holding twice-values.
+    {
+      int min_value = 0, max_value = 0;
+      for (const HalfInt& value : values)
+        {
+          min_value = std::min(min_value, TwiceValue(value));
+          max_value = std::max(max_value, TwiceValue(value));
+        }
+      if ((min_value>=INT8_MIN) && (max_value<=INT8_MAX))
+        return 1;
+      if ((min_value>=INT16_MIN) && (max_value<=INT16_MAX))
+        return 2;
+      return 4;
+    }
+
+  }  // namespace detail
+
+  ////////////////////////////////////////////////////////////////
+  // writer
+  ////////////////////////////////////////////////////////////////
+
+  class RMETableWriter
+  // Streaming writer for RME table file.
+  //
+  // Example:
+  //
+  //   am::RMETableWriter writer(filename, bra_basis, ket_basis, k);
+  //   for (...)
+  //     writer.WriteBlock(bra_subspace_index, ket_subspace_index, rmes);
+  //   writer.Close();
+  {
+   public:
+
+    RMETableWriter(
+        const std::string& filename,
+        const RMETableBasis& bra_basis, const RMETableBasis& ket_basis,
+        const HalfInt& k
+      )
+    // Open file, and write header and basis sections.
+    //
+    // Throws std::runtime_error on I/O error, or std::invalid_argument for
+    // inconsistent basis description.
+      : stream_(filename, std::ios::binary|std::ios::trunc),
+        bra_subspaces_(bra_basis.subspaces), ket_subspaces_(ket_basis.subspaces)
+    {
+      if (!stream_)
+        throw std::runtime_error("cannot open RME table file " + filename);
+      std::memset(&header_, 0, sizeof(header_));
+      std::memcpy(header_.magic, detail::kRMETableMagic, sizeof(header_.magic));
+      header_.version = detail::kRMETableVersion;
+      header_.byte_order_mark = detail::kRMETableByteOrderMark;
+      header_.two_k = TwiceValue(k);
+      Write(&header_, sizeof(header_));
+      header_.bra_basis_offset = WriteBasis(bra_basis);
+      header_.ket_basis_offset = WriteBasis(ket_basis);
+    }
+
+    RMETableWriter(const RMETableWriter&) = delete;
+    RMETableWriter& operator=(const RMETableWriter&) = delete;
+
+    ~RMETableWriter()
+    {
+      try
+        {
+          Close();
+        }
+      catch (...)
+        {
+        }
+    }
+
+    void WriteBlock(
+        std::size_t bra_subspace_index, std::size_t ket_subspace_index, const double* rmes
+      )
+    // Append block of RMEs, of dimension bra.dimension x ket.dimension, in
+    // row-major order.
+    {
+      if (!stream_.is_open())
+        throw std::runtime_error("RME table file already closed");
+      const AngularMomentumSubspace& bra = bra_subspaces_.at(bra_subspace_index);
+      const AngularMomentumSubspace& ket = ket_subspaces_.at(ket_subspace_index);
+      detail::RMETableIndexRecord record{};
+      record.bra_subspace_index = std::uint32_t(bra_subspace_index);
+      record.ket_subspace_index = std::uint32_t(ket_subspace_index);
+      record.two_Jp = TwiceValue(bra.J);
+      record.two_J = TwiceValue(ket.J);
+      record.offset = offset_;
+      record.rows = bra.dimension;
+      record.cols = ket.dimension;
+      Write(rmes, sizeof(double)*record.rows*record.cols);
+      index_.push_back(record);
+    }
+
+    void WriteBlock(const ReducedMatrixBlock& block)
+    // Append block of RMEs.
+    {
+      const std::size_t size
+        = bra_subspaces_.at(block.bra_subspace_index).dimension
+        * ket_subspaces_.at(block.ket_subspace_index).dimension;
+      if (block.rmes.size()!=size)
+        throw std::invalid_argument("RME block size does not match subspace dimensions");
+      WriteBlock(block.bra_subspace_index, block.ket_subspace_index, block.rmes.data());
+    }
+
+    void Close()
+    // Write block index and complete header.
+    {
+      if (!stream_.is_open())
+        return;
+      header_.index_offset = offset_;
+      header_.num_blocks = index_.size();
+      Write(index_.data(), sizeof(detail::RMETableIndexRecord)*index_.size());
+      stream_.seekp(0);
+      stream_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+      stream_.close();
+      if (stream_.fail())
+        throw std::runtime_error("error writing RME table file");
+    }
+
+    // accessors
+    std::size_t num_blocks() const {return index_.size();}
+
+   private:
+
+    void Write(const void* data, std::size_t size)
+    {
+      stream_.write(static_cast<const char*>(data), size);
+      if (!stream_)
+        throw std::runtime_error("error writing RME table file");
+      offset_ += size;
+    }
+
+    void Pad()
+    {
+      static const char zeros[8] = {};
+      Write(zeros, detail::AlignRMETableOffset(offset_)-offset_);
+    }
+
+    std::uint64_t WriteBasis(const RMETableBasis& basis)
+    {
+      const std::uint64_t basis_offset = offset_;
+      const std::size_t num_states = basis.num_states();
+      if (basis.labels.size()!=basis.label_names.size())
+        throw std::invalid_argument("RME table basis label names do not match label columns");
+      for (const std::vector<HalfInt>& column : basis.labels)
+        if (column.size()!=num_states)
+          throw std::invalid_argument("RME table basis label column length does not match number of states");
+
+      detail::RMETableBasisHeader basis_header{basis.subspaces.size(), num_states, basis.labels.size()};
+      Write(&basis_header, sizeof(basis_header));
+      for (const AngularMomentumSubspace& subspace : basis.subspaces)
+        {
+          detail::RMETableSubspaceRecord record{TwiceValue(subspace.J), 0, subspace.dimension};
+          Write(&record, sizeof(record));
+        }
+      std::vector<std::uint32_t> widths;
+      for (std::size_t c=0; c<basis.labels.size(); ++c)
+        {
+          detail::RMETableLabelRecord record{};
+          std::strncpy(record.name, basis.label_names[c].c_str(), detail::kRMETableLabelNameLength-1);
+          record.width = detail::NarrowestLabelWidth(basis.labels[c]);
+          widths.push_back(record.width);
+          Write(&record, sizeof(record));
+        }
+      for (std::size_t c=0; c<basis.labels.size(); ++c)
+        {
+          for (const HalfInt& value : basis.labels[c])
+            {
+              const std::int32_t twice_value = TwiceValue(value);
+              if (widths[c]==1)
+                {
+                  const std::int8_t narrow = std::int8_t(twice_value);
+                  Write(&narrow, 1);
+                }
+              else if (widths[c]==2)
+                {
+                  const std::int16_t narrow = std::int16_t(twice_value);
+                  Write(&narrow, 2);
+                }
+              else
+                Write(&twice_value, 4);
+            }
+          Pad();
+        }
+      return basis_offset;
+    }
+
+    std::ofstream stream_;
+    std::vector<AngularMomentumSubspace> bra_subspaces_, ket_subspaces_;
+    detail::RMETableHeader header_;
+    std::vector<detail::RMETableIndexRecord> index_;
+    std::uint64_t offset_ = 0;
+  };
+
+  ////////////////////////////////////////////////////////////////
+  // reader
+  ////////////////////////////////////////////////////////////////
+
+  class RMETableLabelColumn
+  // View of label column in mapped RME table file.
+  {
+   public:
+    RMETableLabelColumn(const char* name, std::uint32_t width, const void* data)
+      : name_(name, ::strnlen(name, detail::kRMETableLabelNameLength)), width_(width), data_(data)
+    {}
+
+    const std::string& name() const {return name_;}
+    std::uint32_t width() const {return width_;}
+    const void* data() const {return data_;}
+
+    int TwiceValue(std::size_t state) const
+    {
+      if (width_==1)
+        return static_cast<const std::int8_t*>(data_)[state];
+      else if (width_==2)
+        return static_cast<const std::int16_t*>(data_)[state];
+      else
+        return static_cast<const std::int32_t*>(data_)[state];
+    }
+    HalfInt operator[](std::size_t state) const {return HalfInt(TwiceValue(state),2);}
+
+   private:
+    std::string name_;
+    std::uint32_t width_;
+    const void* data_;
+  };
+
+  struct RMETableBlockView
+  // View of block in mapped RME table file.
+  //
+  // The RMEs are rows x cols doubles, in row-major order, pointing directly
+  // into the mapping.
+  {
+    std::size_t bra_subspace_index;
+    std::size_t ket_subspace_index;
+    HalfInt Jp, J;
+    std::size_t rows, cols;
+    const double* rmes;
+  };
+
+  class RMETableFile
+  // Memory-mapped RME table file.
+  //
+  // Views returned by the accessors remain valid for the lifetime of the
+  // RMETableFile.
+  {
+   public:
+
+    explicit RMETableFile(const std::string& filename)
+    // Map file and validate header and index.
+    //
+    // Throws std::runtime_error for a missing or malformed file.
+      : file_(filename)
+    {
+      const detail::RMETableHeader& header = Record<detail::RMETableHeader>(0);
+      if (std::memcmp(header.magic, detail::kRMETableMagic, sizeof(header.magic))!=0)
+        throw std::runtime_error("not an RME table file: " + filename);
+      if (header.byte_order_mark!=detail::kRMETableByteOrderMark)
+        throw std::runtime_error("RME table file has foreign byte order: " + filename);
+      if (header.version!=detail::kRMETableVersion)
+        throw std::runtime_error("unsupported RME table file version: " + filename);
+      if (header.index_offset==0)
+        throw std::runtime_error("incomplete RME table file: " + filename);
+      k_ = HalfInt(header.two_k,2);
+      ReadBasis(header.bra_basis_offset, bra_subspaces_, bra_num_states_, bra_labels_);
+      ReadBasis(header.ket_basis_offset, ket_subspaces_, ket_num_states_, ket_labels_);
+
+      const auto* index = &Record<detail::RMETableIndexRecord>(header.index_offset, header.num_blocks);
+      index_.assign(index, index+header.num_blocks);
+      for (std::size_t i=0; i<index_.size(); ++i)
+        {
+          const detail::RMETableIndexRecord& record = index_[i];
+          if ((record.bra_subspace_index>=bra_subspaces_.size())
+              || (record.ket_subspace_index>=ket_subspaces_.size())
+              || (record.offset%alignof(double)!=0))
+            throw std::runtime_error("malformed RME table index: " + filename);
+
+          // block shape must match subspaces, and size must not overflow,
+          // before bounds check against file size
+          const AngularMomentumSubspace& bra = bra_subspaces_[record.bra_subspace_index];
+          const AngularMomentumSubspace& ket = ket_subspaces_[record.ket_subspace_index];
+          if ((record.rows!=bra.dimension) || (record.cols!=ket.dimension)
+              || (record.two_Jp!=TwiceValue(bra.J)) || (record.two_J!=TwiceValue(ket.J)))
+            throw std::runtime_error("RME table block does not match subspace dimensions: " + filename);
+          if ((record.cols!=0) && (record.rows>std::numeric_limits<std::uint64_t>::max()/record.cols))
+            throw std::runtime_error("RME table block size overflow: " + filename);
+          Record<double>(record.offset, record.rows*record.cols);
+          if (!block_lookup_.emplace(std::make_pair(record.bra_subspace_index, record.ket_subspace_index), i).second)
+            throw std::runtime_error("repeated RME table block: " + filename);
+        }
+    }
+
+    // tensor rank
+    HalfInt k() const {return k_;}
+
+    // bases
+    const std::vector<AngularMomentumSubspace>& bra_subspaces() const {return bra_subspaces_;}
+    const std::vector<AngularMomentumSubspace>& ket_subspaces() const {return ket_subspaces_;}
+    std::size_t bra_num_states() const {return bra_num_states_;}
+    std::size_t ket_num_states() const {return ket_num_states_;}
+    const std::vector<RMETableLabelColumn>& bra_labels() const {return bra_labels_;}
+    const std::vector<RMETableLabelColumn>& ket_labels() const {return ket_labels_;}
+
+    // blocks
+    std::size_t num_blocks() const {return index_.size();}
+
+    RMETableBlockView block(std::size_t i) const
+    // Block with given position in file.
+    {
+      const detail::RMETableIndexRecord& record = index_.at(i);
+      return RMETableBlockView{
+          record.bra_subspace_index, record.ket_subspace_index,
+          HalfInt(record.two_Jp,2), HalfInt(record.two_J,2),
+          record.rows, record.cols,
+          reinterpret_cast<const double*>(file_.data()+record.offset)
+        };
+    }
+
+    bool Find(
+        std::size_t bra_subspace_index, std::size_t ket_subspace_index, RMETableBlockView& view
+      ) const
+    // Look up block for pair of subspaces.
+    //
+    // Returns:
+    //   (bool): whether block is present
+    {
+      auto it = block_lookup_.find({bra_subspace_index, ket_subspace_index});
+      if (it==block_lookup_.end())
+        return false;
+      view = block(it->second);
+      return true;
+    }
+
+    std::vector<ReducedMatrixBlock> ReducedMatrixBlocks() const
+    // Copy all blocks, e.g., for WignerEckartExpansion.
+    {
+      std::vector<ReducedMatrixBlock> blocks;
+      blocks.reserve(num_blocks());
+      for (std::size_t i=0; i<num_blocks(); ++i)
+        {
+          const RMETableBlockView view = block(i);
+          blocks.push_back({view.bra_subspace_index, view.ket_subspace_index,
+                            std::vector<double>(view.rmes, view.rmes+view.rows*view.cols)});
+        }
+      return blocks;
+    }
+
+   private:
+
+    template<typename T>
+    const T& Record(std::uint64_t offset, std::uint64_t count = 1) const
+    // Record(s) at given offset, with bounds check.
+    {
+      if ((offset>file_.size()) || (count>(file_.size()-offset)/sizeof(T)))
+        throw std::runtime_error("truncated RME table file");
+      return *reinterpret_cast<const T*>(file_.data()+offset);
+    }
+
+    void ReadBasis(
+        std::uint64_t offset,
+        std::vector<AngularMomentumSubspace>& subspaces, std::size_t& num_states,
+        std::vector<RMETableLabelColumn>& labels
+      )
+    {
+      const detail::RMETableBasisHeader& basis_header = Record<detail::RMETableBasisHeader>(offset);
+      offset += sizeof(basis_header);
+      num_states = basis_header.num_states;
+      if (num_states>file_.size())
+        throw std::runtime_error("truncated RME table file");
+      const auto* subspace_records
+        = &Record<detail::RMETableSubspaceRecord>(offset, basis_header.num_subspaces);
+      std::uint64_t remaining_states = num_states;
+      for (std::size_t s=0; s<basis_header.num_subspaces; ++s)
+        {
+          // subspace dimensions must sum to number of states (checked
+          // against remainder to avoid overflow)
+          if (subspace_records[s].dimension>remaining_states)
+            throw std::runtime_error("RME table subspace dimensions do not match number of states");
+          remaining_states -= subspace_records[s].dimension;
+          subspaces.push_back({HalfInt(subspace_records[s].two_J,2), subspace_records[s].dimension});
+        }
+      if (remaining_states!=0)
+        throw std::runtime_error("RME table subspace dimensions do not match number of states");
+      offset += sizeof(detail::RMETableSubspaceRecord)*basis_header.num_subspaces;
+      const auto* label_records
+        = &Record<detail::RMETableLabelRecord>(offset, basis_header.num_label_columns);
+      offset += sizeof(detail::RMETableLabelRecord)*basis_header.num_label_columns;
+      for (std::size_t c=0; c<basis_header.num_label_columns; ++c)
+        {
+          const std::uint32_t width = label_records[c].width;
+          if (!((width==1)||(width==2)||(width==4)))
+            throw std::runtime_error("malformed RME table label column");
+          Record<char>(offset, width*num_states);
+          labels.emplace_back(label_records[c].name, width, file_.data()+offset);
+          offset = detail::AlignRMETableOffset(offset+width*num_states);
+        }
+    }
+
+    MappedFile file_;
+    HalfInt k_;
+    std::vector<AngularMomentumSubspace> bra_subspaces_, ket_subspaces_;
+    std::size_t bra_num_states_ = 0, ket_num_states_ = 0;
+    std::vector<RMETableLabelColumn> bra_labels_, ket_labels_;
+    std::vector<detail::RMETableIndexRecord> index_;
+    std::map<std::pair<std::size_t,std::size_t>,std::size_t> block_lookup_;
+  };
+
+}  // namespace am
+
+#endif  // AM_RME_TABLE_FILE_H_
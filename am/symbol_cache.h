@@ -0,0 +1,487 @@
+/****************************************************************
+  symbol_cache.h
+
+  Caches of Wigner 6-j and 9-j symbols, optionally backed by a shared,
+  memory-mapped table file.
+
+  A SymbolCache holds symbol values keyed by their arguments (as a
+  PackedKey), in two layers:
+
+    - a read-only table, attached from a file (see mapped_file.h), which is
+      shared (through the page cache) by all processes attaching the same
+      file, e.g., the workers of a multiprocessing pool, or a forked MPI
+      job;
+
+    - a process-local table, which receives values computed on cache misses,
+      or by warming the cache over all arguments up to a given j_max.
+
+  Save() writes the contents of both layers to a new table file, which may
+  then be attached by other processes.
+
+  The process-wide caches are obtained from Wigner6JCache() and
+  Wigner9JCache(), and are consulted by CachedWigner6J() and
+  CachedWigner9J().  A cache is disabled (and CachedWigner6J() simply
+  evaluates Wigner6J()) until it is attached, warmed, or explicitly enabled.
+
+  Example:
+
+    am::Wigner6JCache().Attach("wigner6j.bin");
+    ...
+    double value = am::CachedWigner6J(ja,jb,jc,jd,je,jf);
+    ...
+    am::SymbolCacheStatistics statistics = am::Wigner6JCache().statistics();
+
+  File layout (native byte order, with byte order mark):
+
+    header (64 bytes):
+      char[8] magic "AMSYMTBL"
+      uint32 version
+      uint32 byte order mark 0x01020304
+      uint32 number of key fields N
+      uint32 number of key words
+      uint64 capacity (number of slots, a power of 2)
+      uint64 number of entries
+      char[16] symbol name
+      uint64 reserved
+
+    slots (open-addressing hash table, linear probing from PackedKey hash):
+      {uint64 key words[number of key words], double value}
+
+  Empty slots have all key words zero, which does not represent any valid
+  key (since arguments are nonnegative).
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Bump file version to 2, for change of PackedKey hash.
+
+****************************************************************/
+
+#ifndef AM_SYMBOL_CACHE_H_
+#define AM_SYMBOL_CACHE_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "halfint.h"
+#include "mapped_file.h"
+#include "packed_key.h"
+#include "parallel.h"
+#include "wigner_gsl.h"
+
+namespace am {
+
+  struct SymbolCacheStatistics
+  // Size and usage statistics for symbol cache.
+  {
+    std::size_t mapped_size;  // entries in attached table
+    std::size_t local_size;  // entries in process-local table
+    std::uint64_t hits;
+    std::uint64_t misses;
+
+    std::size_t size() const {return mapped_size+local_size;}
+    double hit_rate() const {return (hits+misses>0) ? double(hits)/double(hits+misses) : 0.;}
+  };
+
+  namespace detail {
+
+    constexpr char kSymbolCacheMagic[8] = {'A','M','S','Y','M','T','B','L'};
+    constexpr std::uint32_t kSymbolCacheVersion = 2;  // 2: PackedKey multiply-fold hash
+    constexpr std::uint32_t kSymbolCacheByteOrderMark = 0x01020304;
+    constexpr std::size_t kSymbolCacheNameLength = 16;
+
+    struct SymbolCacheHeader
+    {
+      char magic[8];
+      std::uint32_t version;
+      std::uint32_t byte_order_mark;
+      std::uint32_t num_fields;
+      std::uint32_t num_words;
+      std::uint64_t capacity;
+      std::uint64_t num_entries;
+      char name[kSymbolCacheNameLength];
+      std::uint64_t reserved;
+    };
+    static_assert(sizeof(SymbolCacheHeader)==64);
+
+    inline
+    bool AllowedTriangleTwice(int two_ja, int two_jb, int two_jc)
+    // Triangle inequality and integer sum, on twice-values.
+    {
+      return (two_jc>=std::abs(two_ja-two_jb)) && (two_jc<=two_ja+two_jb) && ((two_ja+two_jb+two_jc)%2==0);
+    }
+
+  }  // namespace detail
+
+  template<std::size_t N>
+  class SymbolCache
+  // Cache of values of symbol with N angular momentum arguments.
+  //
+  // Lookup (Get) may be called concurrently from multiple threads.
+  {
+   public:
+
+    typedef PackedKey<N> Key;
+
+    // evaluation of symbol from twice-values of arguments
+    typedef double (*Evaluator)(const int* two_values);
+
+    // argument positions subject to triangle condition
+    typedef std::array<int,3> Triad;
+
+    SymbolCache(std::string name, Evaluator evaluator, std::vector<Triad> triads)
+      : name_(std::move(name)), evaluator_(evaluator), triads_(std::move(triads))
+    {
+      if (name_.size()>=detail::kSymbolCacheNameLength)
+        throw std::invalid_argument("symbol cache name too long");
+    }
+
+    SymbolCache(const SymbolCache&) = delete;
+    SymbolCache& operator=(const SymbolCache&) = delete;
+
+    ////////////////////////////////////////////////////////////////
+    // lookup
+    ////////////////////////////////////////////////////////////////
+
+    double Get(const int* two_values)
+    // Get symbol value, from cache if present, else by evaluation (and
+    // insertion into process-local table).
+    //
+    // Arguments which violate a triangle condition, or lie outside the range
+    // representable by Key (including negative arguments), are evaluated
+    // directly, without caching.
+    {
+      if (!enabled_.load(std::memory_order_relaxed))
+        return evaluator_(two_values);
+      for (std::size_t i=0; i<N; ++i)
+        if ((two_values[i]<0) || (two_values[i]>Key::kTwiceValueMax))
+          return evaluator_(two_values);
+      for (const Triad& triad : triads_)
+        if (!detail::AllowedTriangleTwice(two_values[triad[0]], two_values[triad[1]], two_values[triad[2]]))
+          return evaluator_(two_values);
+      const Key key = Key::FromTwiceValues(two_values);
+      {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        const double* value = Find(key);
+        if (value)
+          {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return *value;
+          }
+      }
+      misses_.fetch_add(1, std::memory_order_relaxed);
+      const double value = evaluator_(two_values);
+      std::unique_lock<std::shared_mutex> lock(mutex_);
+      local_.emplace(key, value);
+      return value;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // table management
+    ////////////////////////////////////////////////////////////////
+
+    void Attach(const std::string& filename)
+    // Attach table file (replacing any previously attached file), and enable
+    // cache.
+    //
+    // Throws std::runtime_error for a missing or malformed file.
+    {
+      MappedFile file(filename);
+      if (file.size()<sizeof(detail::SymbolCacheHeader))
+        throw std::runtime_error("not a symbol table file: " + filename);
+      detail::SymbolCacheHeader header;
+      std::memcpy(&header, file.data(), sizeof(header));
+      if (std::memcmp(header.magic, detail::kSymbolCacheMagic, sizeof(header.magic))!=0)
+        throw std::runtime_error("not a symbol table file: " + filename);
+      if (header.byte_order_mark!=detail::kSymbolCacheByteOrderMark)
+        throw std::runtime_error("symbol table file has foreign byte order: " + filename);
+      if (header.version!=detail::kSymbolCacheVersion)
+        throw std::runtime_error("unsupported symbol table file version: " + filename);
+      if ((std::strncmp(header.name, name_.c_str(), detail::kSymbolCacheNameLength)!=0)
+          || (header.num_fields!=N) || (header.num_words!=Key::kNumWords))
+        throw std::runtime_error("symbol table file is not for " + name_ + ": " + filename);
+      if ((header.capacity==0) || ((header.capacity&(header.capacity-1))!=0)
+          || (header.num_entries>header.capacity)
+          || (file.size()!=sizeof(header)+header.capacity*sizeof(Slot)))
+        throw std::runtime_error("malformed symbol table file: " + filename);
+
+      std::unique_lock<std::shared_mutex> lock(mutex_);
+      file_ = std::move(file);
+      filename_ = filename;
+      slots_ = reinterpret_cast<const Slot*>(file_.data()+sizeof(header));
+      capacity_ = header.capacity;
+      mapped_size_ = header.num_entries;
+      enabled_.store(true);
+    }
+
+    void Detach()
+    // Detach table file, if any.
+    {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
+      file_ = MappedFile();
+      filename_.clear();
+      slots_ = nullptr;
+      capacity_ = 0;
+      mapped_size_ = 0;
+    }
+
+    void Warm(const HalfInt& j_max, int num_threads = 0)
+    // Evaluate and cache all symbols with arguments j<=j_max (satisfying
+    // triangle conditions), which are not already present, and enable
+    // cache.
+    {
+      const int two_j_max = TwiceValue(j_max);
+      if (two_j_max>Key::kTwiceValueMax)
+        throw std::invalid_argument("j_max out of range for symbol cache");
+      ParallelFor(0, two_j_max+1, [&](std::ptrdiff_t two_j0) {
+          std::vector<std::pair<Key,double>> entries;
+          int two_values[N];
+          two_values[0] = int(two_j0);
+          WarmRecursive(1, two_j_max, two_values, entries);
+          std::unique_lock<std::shared_mutex> lock(mutex_);
+          for (const auto& [key, value] : entries)
+            local_.emplace(key, value);
+        }, num_threads);
+      enabled_.store(true);
+    }
+
+    void Save(const std::string& filename) const
+    // Write contents of attached and process-local tables to table file.
+    //
+    // The file is written under a temporary name and then renamed, so that
+    // it may safely replace the currently attached file, and so that other
+    // processes never attach a partially written file.
+    //
+    // Throws std::runtime_error on I/O error.
+    {
+      std::vector<Slot> slots;
+      detail::SymbolCacheHeader header{};
+      std::memcpy(header.magic, detail::kSymbolCacheMagic, sizeof(header.magic));
+      header.version = detail::kSymbolCacheVersion;
+      header.byte_order_mark = detail::kSymbolCacheByteOrderMark;
+      header.num_fields = N;
+      header.num_words = Key::kNumWords;
+      std::strncpy(header.name, name_.c_str(), detail::kSymbolCacheNameLength-1);
+      {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        // capacity at most half full
+        std::uint64_t capacity = 16;
+        while (capacity<2*(mapped_size_+local_.size()))
+          capacity *= 2;
+        slots.assign(capacity, Slot{});
+        for (std::uint64_t i=0; i<capacity_; ++i)
+          if (!Empty(slots_[i]))
+            header.num_entries += Insert(slots, slots_[i]);
+        for (const auto& [key, value] : local_)
+          header.num_entries += Insert(slots, Slot{key.words(), value});
+        header.capacity = capacity;
+      }
+
+      const std::string temporary_filename = filename + ".tmp";
+      std::ofstream stream(temporary_filename, std::ios::binary|std::ios::trunc);
+      if (!stream)
+        throw std::runtime_error("cannot open symbol table file " + temporary_filename);
+      stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      stream.write(reinterpret_cast<const char*>(slots.data()), sizeof(Slot)*slots.size());
+      stream.close();
+      if (stream.fail())
+        throw std::runtime_error("error writing symbol table file " + temporary_filename);
+      if (std::rename(temporary_filename.c_str(), filename.c_str())!=0)
+        throw std::runtime_error("cannot rename symbol table file to " + filename);
+    }
+
+    void Clear()
+    // Discard process-local table, and reset statistics.
+    {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
+      local_.clear();
+      hits_.store(0);
+      misses_.store(0);
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // accessors
+    ////////////////////////////////////////////////////////////////
+
+    const std::string& name() const {return name_;}
+    bool enabled() const {return enabled_.load();}
+    void set_enabled(bool enabled) {enabled_.store(enabled);}
+
+    std::string filename() const
+    // Attached table file (or empty string).
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      return filename_;
+    }
+
+    SymbolCacheStatistics statistics() const
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      return SymbolCacheStatistics{mapped_size_, local_.size(), hits_.load(), misses_.load()};
+    }
+
+   private:
+
+    struct Slot
+    {
+      std::array<std::uint64_t,Key::kNumWords> words;
+      double value;
+    };
+    static_assert(sizeof(Slot)==sizeof(std::uint64_t)*(Key::kNumWords+1));
+
+    static bool Empty(const Slot& slot)
+    {
+      for (std::uint64_t word : slot.words)
+        if (word!=0)
+          return false;
+      return true;
+    }
+
+    static bool Insert(std::vector<Slot>& slots, const Slot& slot)
+    // Insert into slot table, unless already present.
+    //
+    // Returns:
+    //   (bool): whether inserted
+    {
+      const std::size_t mask = slots.size()-1;
+      for (std::size_t i=Key::FromWords(slot.words).Hash()&mask; ; i=(i+1)&mask)
+        {
+          if (Empty(slots[i]))
+            {
+              slots[i] = slot;
+              return true;
+            }
+          if (slots[i].words==slot.words)
+            return false;
+        }
+    }
+
+    const double* Find(const Key& key) const
+    // Find value in attached or process-local table (with lock held).
+    {
+      if (capacity_>0)
+        {
+          const std::size_t mask = capacity_-1;
+          for (std::size_t i=key.Hash()&mask; !Empty(slots_[i]); i=(i+1)&mask)
+            if (slots_[i].words==key.words())
+              return &slots_[i].value;
+        }
+      auto it = local_.find(key);
+      return (it!=local_.end()) ? &it->second : nullptr;
+    }
+
+    void WarmRecursive(std::size_t position, int two_j_max, int* two_values, std::vector<std::pair<Key,double>>& entries) const
+    // Enumerate arguments from given position onward, pruning on triangle
+    // conditions as soon as all arguments of a triad are assigned.
+    {
+      for (const Triad& triad : triads_)
+        if ((std::size_t(std::max({triad[0], triad[1], triad[2]}))==position-1)
+            && !detail::AllowedTriangleTwice(two_values[triad[0]], two_values[triad[1]], two_values[triad[2]]))
+          return;
+      if (position==N)
+        {
+          const Key key = Key::FromTwiceValues(two_values);
+          {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            if (Find(key))
+              return;
+          }
+          entries.emplace_back(key, evaluator_(two_values));
+          return;
+        }
+      for (two_values[position]=0; two_values[position]<=two_j_max; ++two_values[position])
+        WarmRecursive(position+1, two_j_max, two_values, entries);
+    }
+
+    std::string name_;
+    Evaluator evaluator_;
+    std::vector<Triad> triads_;
+    std::atomic<bool> enabled_{false};
+    std::atomic<std::uint64_t> hits_{0}, misses_{0};
+
+    mutable std::shared_mutex mutex_;  // guards following members
+    MappedFile file_;
+    std::string filename_;
+    const Slot* slots_ = nullptr;
+    std::uint64_t capacity_ = 0;
+    std::size_t mapped_size_ = 0;
+    std::unordered_map<Key,double> local_;
+  };
+
+  ////////////////////////////////////////////////////////////////
+  // process-wide caches
+  ////////////////////////////////////////////////////////////////
+
+  inline
+  SymbolCache<6>& Wigner6JCache()
+  // Process-wide cache of Wigner 6-j symbols {ja jb jc; jd je jf}.
+  {
+    static SymbolCache<6> cache(
+        "Wigner6J",
+        [](const int* t) {return gsl_sf_coupling_6j(t[0], t[1], t[2], t[3], t[4], t[5]);},
+        {{0,1,2}, {0,4,5}, {3,1,5}, {3,4,2}}
+      );
+    return cache;
+  }
+
+  inline
+  SymbolCache<9>& Wigner9JCache()
+  // Process-wide cache of Wigner 9-j symbols {ja jb jc; jd je jf; jg jh ji}.
+  {
+    static SymbolCache<9> cache(
+        "Wigner9J",
+        [](const int* t) {return gsl_sf_coupling_9j(t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], t[8]);},
+        {{0,1,2}, {3,4,5}, {6,7,8}, {0,3,6}, {1,4,7}, {2,5,8}}
+      );
+    return cache;
+  }
+
+  inline
+  double CachedWigner6J(
+      const HalfInt& ja, const HalfInt& jb, const HalfInt& jc,
+      const HalfInt& jd, const HalfInt& je, const HalfInt& jf
+    )
+  // Wigner 6-j symbol, through Wigner6JCache().
+  {
+    const int two_values[6] = {
+      TwiceValue(ja), TwiceValue(jb), TwiceValue(jc),
+      TwiceValue(jd), TwiceValue(je), TwiceValue(jf)
+    };
+    return Wigner6JCache().Get(two_values);
+  }
+
+  inline
+  double CachedWigner9J(
+      const HalfInt& ja, const HalfInt& jb, const HalfInt& jc,
+      const HalfInt& jd, const HalfInt& je, const HalfInt& jf,
+      const HalfInt& jg, const HalfInt& jh, const HalfInt& ji
+    )
+  // Wigner 9-j symbol, through Wigner9JCache().
+  {
+    const int two_values[9] = {
+      TwiceValue(ja), TwiceValue(jb), TwiceValue(jc),
+      TwiceValue(jd), TwiceValue(je), TwiceValue(jf),
+      TwiceValue(jg), TwiceValue(jh), TwiceValue(ji)
+    };
+    return Wigner9JCache().Get(two_values);
+  }
+
+}  // namespace am
+
+#endif  // AM_SYMBOL_CACHE_H_
@@ -0,0 +1,363 @@
+/****************************************************************
+  table_reader.h
+
+  Reads whitespace-separated text tables of angular momentum labels and
+  numerical data (e.g., quantum numbers and RMEs) into columnar arrays.
+
+  Each column is declared as HalfInt, int, or double.  HalfInt entries may
+  be given as "3", "3/2", or "1.5" (see from_chars in halfint.h).  Blank
+  lines and lines beginning with '#' are ignored.
+
+  The file is memory mapped (see mapped_file.h) and divided into chunks at
+  line boundaries.  The chunks are parsed in parallel (see parallel.h), with
+  std::from_chars, into chunk-local columns, which are then concatenated.
+  Where the standard library does not provide std::from_chars for double
+  (__cpp_lib_to_chars undefined, e.g., older Apple libc++), double fields
+  are instead parsed with std::strtod, which depends on the C locale.
+  Column storage is reserved in advance from the line count, and no strings
+  are constructed, so parsing performs no per-line or per-field allocation.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Fall back to strtod for double fields where floating-point
+    std::from_chars is unavailable.
+
+****************************************************************/
+
+#ifndef AM_TABLE_READER_H_
+#define AM_TABLE_READER_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "halfint.h"
+#include "mapped_file.h"
+#include "parallel.h"
+
+namespace am {
+
+  enum class ColumnType {kHalfInt, kInt, kDouble};
+
+  class ColumnarTable
+  // Table stored by columns.
+  //
+  // Each column is stored in a contiguous array of its declared type.
+  {
+   public:
+
+    ColumnarTable() = default;
+
+    explicit ColumnarTable(const std::vector<ColumnType>& column_types)
+      : column_types_(column_types), num_rows_(0),
+        halfint_columns_(column_types.size()), int_columns_(column_types.size()),
+        double_columns_(column_types.size())
+    {}
+
+    // layout
+    std::size_t num_columns() const {return column_types_.size();}
+    std::size_t num_rows() const {return num_rows_;}
+    const std::vector<ColumnType>& column_types() const {return column_types_;}
+
+    // columns
+    const std::vector<HalfInt>& halfint_column(std::size_t c) const
+    {
+      CheckType(c,ColumnType::kHalfInt);
+      return halfint_columns_[c];
+    }
+    const std::vector<int>& int_column(std::size_t c) const
+    {
+      CheckType(c,ColumnType::kInt);
+      return int_columns_[c];
+    }
+    const std::vector<double>& double_column(std::size_t c) const
+    {
+      CheckType(c,ColumnType::kDouble);
+      return double_columns_[c];
+    }
+
+   private:
+
+    friend ColumnarTable ParseTable(const char*, const char*, const std::vector<ColumnType>&);
+    friend ColumnarTable ParseTableParallel(const char*, const char*, const std::vector<ColumnType>&);
+
+    void Reserve(std::size_t num_rows)
+    {
+      for (std::size_t c=0; c<num_columns(); ++c)
+        switch (column_types_[c])
+          {
+          case ColumnType::kHalfInt: halfint_columns_[c].reserve(num_rows); break;
+          case ColumnType::kInt: int_columns_[c].reserve(num_rows); break;
+          default: double_columns_[c].reserve(num_rows); break;
+          }
+    }
+
+    void CheckType(std::size_t c, ColumnType type) const
+    {
+      if (column_types_.at(c)!=type)
+        throw std::invalid_argument("column type mismatch in ColumnarTable");
+    }
+
+    std::vector<ColumnType> column_types_;
+    std::size_t num_rows_ = 0;
+    std::vector<std::vector<HalfInt>> halfint_columns_;
+    std::vector<std::vector<int>> int_columns_;
+    std::vector<std::vector<double>> double_columns_;
+  };
+
+  namespace detail {
+
+    // target size of parse chunks (bytes)
+    constexpr std::size_t kTableChunkSize = std::size_t(1)<<20;
+
+    inline bool IsTableSpace(char c) {return (c==' ')||(c=='\t')||(c=='\r');}
+
+#ifndef __cpp_lib_to_chars
+    // maximum length of double field for strtod fallback
+    constexpr std::size_t kTableDoubleMaxChars = 64;
+
+    inline
+    std::from_chars_result StrtodTableField(const char* first, const char* last, double& value)
+    // Parse double with std::strtod, for standard libraries lacking
+    // floating-point std::from_chars (e.g., Apple libc++).
+    //
+    // The field (up to the next whitespace) is copied into a local
+    // null-terminated buffer, since the mapped file is not null-terminated.
+    // Note that, unlike std::from_chars, std::strtod depends on the C locale
+    // (for the decimal point).
+    {
+      const char* field_end = first;
+      while ((field_end!=last) && !IsTableSpace(*field_end) && (*field_end!='\n'))
+        ++field_end;
+      const std::size_t length = std::size_t(field_end-first);
+      if ((length==0) || (length>=kTableDoubleMaxChars))
+        return {first, std::errc::invalid_argument};
+      char buffer[kTableDoubleMaxChars];
+      std::memcpy(buffer, first, length);
+      buffer[length] = '\0';
+      char* end;
+      errno = 0;
+      const double parsed = std::strtod(buffer, &end);
+      if (end==buffer)
+        return {first, std::errc::invalid_argument};
+      if (errno==ERANGE)
+        return {first+(end-buffer), std::errc::result_out_of_range};
+      value = parsed;
+      return {first+(end-buffer), std::errc()};
+    }
+#endif
+
+    template<typename T>
+    inline
+    std::from_chars_result ParseTableField(const char* first, const char* last, T& value)
+    {
+      // std::from_chars does not accept leading '+'
+      if ((first!=last) && (*first=='+'))
+        ++first;
+      if constexpr (std::is_same_v<T,HalfInt>)
+        return from_chars(first, last, value);
+#ifndef __cpp_lib_to_chars
+      else if constexpr (std::is_same_v<T,double>)
+        return StrtodTableField(first, last, value);
+#endif
+      else
+        return std::from_chars(first, last, value);
+    }
+
+  }  // namespace detail
+
+  inline
+  ColumnarTable ParseTable(
+      const char* first, const char* last,
+      const std::vector<ColumnType>& column_types
+    )
+  // Parse text table from buffer [first,last), serially.
+  //
+  // Throws std::runtime_error on a malformed line.
+  {
+    ColumnarTable table(column_types);
+    table.Reserve(std::count(first, last, '\n')+1);
+    const std::size_t num_columns = column_types.size();
+    const char* ptr = first;
+    while (ptr!=last)
+      {
+        const char* line_end = std::find(ptr, last, '\n');
+
+        // skip leading whitespace, blank lines, and comments
+        while ((ptr!=line_end) && detail::IsTableSpace(*ptr))
+          ++ptr;
+        if ((ptr==line_end) || (*ptr=='#'))
+          {
+            ptr = (line_end==last) ? last : line_end+1;
+            continue;
+          }
+
+        // parse fields
+        for (std::size_t c=0; c<num_columns; ++c)
+          {
+            while ((ptr!=line_end) && detail::IsTableSpace(*ptr))
+              ++ptr;
+            std::from_chars_result result;
+            switch (column_types[c])
+              {
+              case ColumnType::kHalfInt:
+                {
+                  HalfInt value;
+                  result = detail::ParseTableField(ptr, line_end, value);
+                  table.halfint_columns_[c].push_back(value);
+                  break;
+                }
+              case ColumnType::kInt:
+                {
+                  int value = 0;
+                  result = detail::ParseTableField(ptr, line_end, value);
+                  table.int_columns_[c].push_back(value);
+                  break;
+                }
+              default:
+                {
+                  double value = 0.;
+                  result = detail::ParseTableField(ptr, line_end, value);
+                  table.double_columns_[c].push_back(value);
+                  break;
+                }
+              }
+            if ((result.ec!=std::errc()) || ((result.ptr!=line_end) && !detail::IsTableSpace(*result.ptr)))
+              throw std::runtime_error("malformed table field at byte offset " + std::to_string(ptr-first));
+            ptr = result.ptr;
+          }
+        while ((ptr!=line_end) && detail::IsTableSpace(*ptr))
+          ++ptr;
+        if (ptr!=line_end)
+          throw std::runtime_error("extra table fields at byte offset " + std::to_string(ptr-first));
+        ++table.num_rows_;
+        ptr = (line_end==last) ? last : line_end+1;
+      }
+    return table;
+  }
+
+  inline
+  ColumnarTable ParseTableParallel(
+      const char* first, const char* last,
+      const std::vector<ColumnType>& column_types
+    )
+  // Parse text table from buffer [first,last), in parallel chunks.
+  //
+  // Throws std::runtime_error on a malformed line, identified by line number.
+  {
+    // divide buffer into chunks at line boundaries
+    std::vector<const char*> boundaries{first};
+    while (boundaries.back()!=last)
+      {
+        const char* target = boundaries.back()+std::min<std::size_t>(detail::kTableChunkSize, last-boundaries.back());
+        const char* boundary = (target==last) ? last : std::find(target, last, '\n');
+        boundaries.push_back((boundary==last) ? last : boundary+1);
+      }
+    const std::size_t num_chunks = boundaries.size()-1;
+
+    // parse chunks
+    std::vector<ColumnarTable> chunks(num_chunks);
+    std::vector<const char*> error_positions(num_chunks, nullptr);
+    ParallelFor(0, num_chunks, [&](std::ptrdiff_t k) {
+        try
+          {
+            chunks[k] = ParseTable(boundaries[k], boundaries[k+1], column_types);
+          }
+        catch (const std::runtime_error&)
+          {
+            // locate error by reparsing chunk line by line (error path only)
+            const char* line = boundaries[k];
+            while (line!=boundaries[k+1])
+              {
+                const char* line_end = std::find(line, boundaries[k+1], '\n');
+                try
+                  {
+                    ParseTable(line, line_end, column_types);
+                  }
+                catch (const std::runtime_error&)
+                  {
+                    error_positions[k] = line;
+                    return;
+                  }
+                line = (line_end==boundaries[k+1]) ? line_end : line_end+1;
+              }
+            error_positions[k] = boundaries[k];
+          }
+      });
+    for (const char* position : error_positions)
+      if (position)
+        throw std::runtime_error(
+            "malformed table line " + std::to_string(std::count(first, position, '\n')+1)
+          );
+
+    // concatenate chunks
+    std::vector<std::size_t> offsets(num_chunks+1, 0);
+    for (std::size_t k=0; k<num_chunks; ++k)
+      offsets[k+1] = offsets[k]+chunks[k].num_rows();
+    ColumnarTable table(column_types);
+    table.num_rows_ = offsets.back();
+    for (std::size_t c=0; c<column_types.size(); ++c)
+      switch (column_types[c])
+        {
+        case ColumnType::kHalfInt: table.halfint_columns_[c].resize(table.num_rows_); break;
+        case ColumnType::kInt: table.int_columns_[c].resize(table.num_rows_); break;
+        default: table.double_columns_[c].resize(table.num_rows_); break;
+        }
+    ParallelFor(0, num_chunks, [&](std::ptrdiff_t k) {
+        for (std::size_t c=0; c<column_types.size(); ++c)
+          switch (column_types[c])
+            {
+            case ColumnType::kHalfInt:
+              std::copy(
+                  chunks[k].halfint_columns_[c].begin(), chunks[k].halfint_columns_[c].end(),
+                  table.halfint_columns_[c].begin()+offsets[k]
+                );
+              break;
+            case ColumnType::kInt:
+              std::copy(
+                  chunks[k].int_columns_[c].begin(), chunks[k].int_columns_[c].end(),
+                  table.int_columns_[c].begin()+offsets[k]
+                );
+              break;
+            default:
+              std::copy(
+                  chunks[k].double_columns_[c].begin(), chunks[k].double_columns_[c].end(),
+                  table.double_columns_[c].begin()+offsets[k]
+                );
+              break;
+            }
+      });
+    return table;
+  }
+
+  inline
+  ColumnarTable ReadTable(const std::string& filename, const std::vector<ColumnType>& column_types)
+  // Read text table from file.
+  //
+  // The file is memory mapped and parsed in parallel chunks.
+  //
+  // Arguments:
+  //   filename (input): name of file
+  //   column_types (input): types of columns
+  //
+  // Returns:
+  //   (ColumnarTable): table
+  {
+    MappedFile file(filename);
+    return ParseTableParallel(file.data(), file.data()+file.size(), column_types);
+  }
+
+}  // namespace am
+
+#endif  // AM_TABLE_READER_H_
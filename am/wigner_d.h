@@ -0,0 +1,308 @@
+/****************************************************************
+  wigner_d.h
+
+  Generates Wigner rotation matrices d^j(beta) and D^j(alpha,beta,gamma),
+  for all j=0,1/2,1,...,j_max at once.
+
+  The convention is that of Edmonds/Rose, i.e.,
+
+    D^j_{m'm}(alpha,beta,gamma) = <j m'|R(alpha,beta,gamma)|j m>
+      = exp(-i*m'*alpha) d^j_{m'm}(beta) exp(-i*m*gamma),
+
+  with d^{1/2}_{1/2,-1/2}(beta)=-sin(beta/2).
+
+  The small-d matrices are built by the recursion of Risbo [J. Geodesy 70,
+  383 (1996)], which couples d^{j-1/2} with d^{1/2} to obtain d^j:
+
+    2j d^j_{m'm} = sqrt((j+m')(j+m)) c d^{j-1/2}_{m'-1/2,m-1/2}
+                 - sqrt((j+m')(j-m)) s d^{j-1/2}_{m'-1/2,m+1/2}
+                 + sqrt((j-m')(j+m)) s d^{j-1/2}_{m'+1/2,m-1/2}
+                 + sqrt((j-m')(j-m)) c d^{j-1/2}_{m'+1/2,m+1/2},
+
+  where c=cos(beta/2) and s=sin(beta/2).  The terms are of mixed sign (one
+  s term is subtracted, and the previous elements carry their own signs), so
+  the recursion does involve cancellation.  However, the weights are at most
+  one, and the elements of each d^j are bounded by one, so the terms never
+  grow large, unlike the alternating terms of the Wigner sum formula, which
+  cancel catastrophically at large j.
+
+  Storage layout: The matrices for all j are stored contiguously, ordered by
+  2j=0,1,...,2*j_max.  The matrix d^j starts at offset
+
+    sum_{n=0}^{2j-1} (n+1)^2 = 2j*(2j+1)*(4j+1)/6,
+
+  and is stored in row-major order, with element (m',m) at position
+  (j+m')*(2j+1)+(j+m).
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Correct description of recursion weights.
+
+****************************************************************/
+
+#ifndef AM_WIGNER_D_H_
+#define AM_WIGNER_D_H_
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "am.h"
+#include "parallel.h"
+
+namespace am {
+
+  ////////////////////////////////////////////////////////////////
+  // storage layout
+  ////////////////////////////////////////////////////////////////
+
+  inline constexpr
+  std::size_t WignerDOffset(int two_j)
+  // Offset of matrix for given 2j, within storage for all j.
+  {
+    return std::size_t(two_j)*(two_j+1)*(2*two_j+1)/6;
+  }
+
+  inline constexpr
+  std::size_t WignerDSize(int two_j_max)
+  // Size of storage for matrices for all j<=j_max.
+  {
+    return WignerDOffset(two_j_max+1);
+  }
+
+  inline
+  std::size_t WignerDIndex(const HalfInt& j, const HalfInt& mp, const HalfInt& m)
+  // Index of element (m',m) of matrix for j, within storage for all j.
+  {
+    return WignerDOffset(TwiceValue(j)) + std::size_t(int(j+mp))*dim(j) + int(j+m);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // recursion
+  ////////////////////////////////////////////////////////////////
+
+  namespace detail {
+
+    inline
+    void WignerSmallDRecursion(
+        int two_j_max, double beta, double* values, std::vector<double>& scratch
+      )
+    // Evaluate d^j(beta) for all j<=j_max by Risbo recursion.
+    //
+    // The previous matrix is copied into scratch, with a border of zeros, so
+    // that the recursion runs without bounds checks.
+    {
+      const double c = std::cos(beta/2), s = std::sin(beta/2);
+      std::vector<double> root(two_j_max+1);
+      for (int k=0; k<=two_j_max; ++k)
+        root[k] = std::sqrt(double(k));
+
+      values[0] = 1.;
+      for (int n=1; n<=two_j_max; ++n)
+        {
+          // pad previous matrix: q[(r+1)*(n+1)+(c+1)] = d^{j-1/2}[r][c], for 0<=r,c<n
+          const double* previous = values+WignerDOffset(n-1);
+          double* current = values+WignerDOffset(n);
+          const int width = n+1;
+          scratch.assign(std::size_t(width+1)*width, 0.);
+          for (int r=0; r<n; ++r)
+            for (int col=0; col<n; ++col)
+              scratch[(r+1)*width+(col+1)] = previous[r*n+col];
+
+          const double inverse = 1./n;
+          for (int ip=0; ip<=n; ++ip)
+            {
+              // rows m'-1/2 and m'+1/2 of previous matrix, offset by one column
+              const double* upper = &scratch[ip*width];
+              const double* lower = &scratch[(ip+1)*width];
+              const double a = root[ip]*inverse, b = root[n-ip]*inverse;
+              double* row = current+ip*(n+1);
+              AM_OMP_SIMD
+              for (int i=0; i<=n; ++i)
+                {
+                  const double u = root[i], v = root[n-i];
+                  row[i] = a*(u*c*upper[i]-v*s*upper[i+1]) + b*(u*s*lower[i]+v*c*lower[i+1]);
+                }
+            }
+        }
+    }
+
+  }  // namespace detail
+
+  ////////////////////////////////////////////////////////////////
+  // single angle
+  ////////////////////////////////////////////////////////////////
+
+  class WignerSmallD
+  // Matrices d^j(beta) for all j<=j_max.
+  //
+  // Storage is allocated once, at construction, and reused by each call to
+  // Evaluate.
+  //
+  // Example:
+  //
+  //   am::WignerSmallD d(j_max);
+  //   for (double beta : betas)
+  //     {
+  //       d.Evaluate(beta);
+  //       ... d(j,mp,m) or d.matrix(j)[...] ...
+  //     }
+  {
+   public:
+
+    explicit WignerSmallD(const HalfInt& j_max)
+      : two_j_max_(TwiceValue(j_max)), beta_(0.)
+    {
+      if (two_j_max_<0)
+        throw std::invalid_argument("negative j_max for WignerSmallD");
+      values_.resize(WignerDSize(two_j_max_));
+      Evaluate(0.);
+    }
+
+    void Evaluate(double beta)
+    // Evaluate matrices at given beta.
+    {
+      beta_ = beta;
+      detail::WignerSmallDRecursion(two_j_max_, beta, values_.data(), scratch_);
+    }
+
+    // accessors
+    HalfInt j_max() const {return HalfInt(two_j_max_,2);}
+    double beta() const {return beta_;}
+    const std::vector<double>& values() const {return values_;}
+
+    const double* matrix(const HalfInt& j) const
+    // Matrix d^j, of dimension (2j+1)x(2j+1), in row-major order.
+    {
+      return &values_[WignerDOffset(TwiceValue(j))];
+    }
+
+    double operator()(const HalfInt& j, const HalfInt& mp, const HalfInt& m) const
+    // Matrix element d^j_{m'm}.
+    {
+      return values_[WignerDIndex(j,mp,m)];
+    }
+
+   private:
+    int two_j_max_;
+    double beta_;
+    std::vector<double> values_, scratch_;
+  };
+
+  class WignerD
+  // Matrices D^j(alpha,beta,gamma) for all j<=j_max.
+  //
+  // Storage is allocated once, at construction, and reused by each call to
+  // Evaluate.
+  {
+   public:
+
+    explicit WignerD(const HalfInt& j_max)
+      : small_d_(j_max), values_(WignerDSize(TwiceValue(j_max))),
+        alpha_phases_(TwiceValue(j_max)+1), gamma_phases_(TwiceValue(j_max)+1)
+    {
+      Evaluate(0.,0.,0.);
+    }
+
+    void Evaluate(double alpha, double beta, double gamma)
+    // Evaluate matrices at given Euler angles.
+    {
+      alpha_ = alpha;
+      gamma_ = gamma;
+      small_d_.Evaluate(beta);
+      const int two_j_max = TwiceValue(small_d_.j_max());
+      for (int n=0; n<=two_j_max; ++n)
+        {
+          // phases exp(-i*m*alpha) and exp(-i*m*gamma), for m=-j,...,j
+          for (int i=0; i<=n; ++i)
+            {
+              const double m = (2*i-n)/2.;
+              alpha_phases_[i] = std::polar(1.,-m*alpha);
+              gamma_phases_[i] = std::polar(1.,-m*gamma);
+            }
+          const double* d = small_d_.values().data()+WignerDOffset(n);
+          std::complex<double>* D = values_.data()+WignerDOffset(n);
+          for (int ip=0; ip<=n; ++ip)
+            for (int i=0; i<=n; ++i)
+              D[ip*(n+1)+i] = alpha_phases_[ip]*d[ip*(n+1)+i]*gamma_phases_[i];
+        }
+    }
+
+    // accessors
+    HalfInt j_max() const {return small_d_.j_max();}
+    double alpha() const {return alpha_;}
+    double beta() const {return small_d_.beta();}
+    double gamma() const {return gamma_;}
+    const WignerSmallD& small_d() const {return small_d_;}
+    const std::vector<std::complex<double>>& values() const {return values_;}
+
+    const std::complex<double>* matrix(const HalfInt& j) const
+    // Matrix D^j, of dimension (2j+1)x(2j+1), in row-major order.
+    {
+      return &values_[WignerDOffset(TwiceValue(j))];
+    }
+
+    std::complex<double> operator()(const HalfInt& j, const HalfInt& mp, const HalfInt& m) const
+    // Matrix element D^j_{m'm}.
+    {
+      return values_[WignerDIndex(j,mp,m)];
+    }
+
+   private:
+    WignerSmallD small_d_;
+    double alpha_ = 0., gamma_ = 0.;
+    std::vector<std::complex<double>> values_;
+    std::vector<std::complex<double>> alpha_phases_, gamma_phases_;
+  };
+
+  ////////////////////////////////////////////////////////////////
+  // batches of angles
+  ////////////////////////////////////////////////////////////////
+
+  inline
+  void WignerSmallDBatch(
+      const HalfInt& j_max, std::size_t num_angles, const double* betas, double* values
+    )
+  // Evaluate d^j(beta) for all j<=j_max, for a batch of angles.
+  //
+  // Angles are distributed over threads (see parallel.h).
+  //
+  // Arguments:
+  //   j_max (input): maximum angular momentum
+  //   num_angles (input): number of angles
+  //   betas (input): angles beta
+  //   values (output): matrices, with the storage for angle betas[a] (of
+  //     length WignerDSize(2*j_max)) starting at a*WignerDSize(2*j_max)
+  {
+    const int two_j_max = TwiceValue(j_max);
+    if (two_j_max<0)
+      throw std::invalid_argument("negative j_max for WignerSmallDBatch");
+    const std::size_t size = WignerDSize(two_j_max);
+    ParallelForRange(0, num_angles, 16, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<double> scratch;
+        for (std::ptrdiff_t a=begin; a<end; ++a)
+          detail::WignerSmallDRecursion(two_j_max, betas[a], values+a*size, scratch);
+      });
+  }
+
+  inline
+  std::vector<double> WignerSmallDBatch(const HalfInt& j_max, const std::vector<double>& betas)
+  // Evaluate d^j(beta) for all j<=j_max, for a batch of angles.
+  //
+  // Returns:
+  //   (std::vector<double>): matrices, with the storage for angle betas[a]
+  //     starting at a*WignerDSize(2*j_max)
+  {
+    std::vector<double> values(WignerDSize(TwiceValue(j_max))*betas.size());
+    WignerSmallDBatch(j_max, betas.size(), betas.data(), values.data());
+    return values;
+  }
+
+}  // namespace am
+
+#endif  // AM_WIGNER_D_H_
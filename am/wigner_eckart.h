@@ -0,0 +1,307 @@
+/****************************************************************
+  wigner_eckart.h
+
+  Expands reduced matrix elements into m-scheme matrix elements, by the
+  Wigner-Eckart theorem.
+
+  RMEs are taken in Rose convention, as throughout rme.h:
+
+    <J' M'|T^k_q|J M> = <J M k q|J' M'> <J'||T^k||J>.
+
+  The m-scheme matrices are generated in compressed sparse row (CSR) form.
+  The number of entries in each row is determined in advance, from the
+  triangle and projection selection rules, so that the output buffers are
+  allocated once at their final sizes.  Clebsch-Gordan coefficients are
+  generated as complete tables for each (J,k,J') combination (see
+  clebsch_gordan.h), so that the cost of the expansion is linear in the size
+  of the output.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Validate tensor rank and component.
+
+****************************************************************/
+
+#ifndef AM_WIGNER_ECKART_H_
+#define AM_WIGNER_ECKART_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "am.h"
+#include "clebsch_gordan.h"
+
+namespace am {
+
+  ////////////////////////////////////////////////////////////////
+  // J-scheme and m-scheme bases
+  ////////////////////////////////////////////////////////////////
+
+  struct AngularMomentumSubspace
+  // Subspace of states sharing angular momentum J.
+  //
+  // The subspace contains "dimension" J-scheme states, distinguished by other
+  // quantum numbers.  In the m-scheme, each of these states gives rise to
+  // 2J+1 states.
+  {
+    HalfInt J;
+    std::size_t dimension;
+  };
+
+  inline
+  std::vector<std::size_t> MSchemeOffsets(
+      const std::vector<AngularMomentumSubspace>& subspaces
+    )
+  // Calculate offsets of subspaces in m-scheme basis.
+  //
+  // Within the m-scheme basis, the state with J-scheme index i within
+  // subspace s and angular momentum projection M has index
+  //
+  //   offsets[s] + i*(2J+1) + (J+M).
+  //
+  // Arguments:
+  //   subspaces (input): J-scheme subspaces
+  //
+  // Returns:
+  //   (std::vector<std::size_t>): offsets, with the total m-scheme dimension
+  //     appended as a final entry
+  {
+    std::vector<std::size_t> offsets(subspaces.size()+1, 0);
+    for (std::size_t s=0; s<subspaces.size(); ++s)
+      offsets[s+1] = offsets[s] + subspaces[s].dimension*dim(subspaces[s].J);
+    return offsets;
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // containers
+  ////////////////////////////////////////////////////////////////
+
+  struct ReducedMatrixBlock
+  // Block of RMEs <J'||T^k||J> between two J-scheme subspaces.
+  //
+  // RMEs are stored densely, in row-major order, with bra states as rows and
+  // ket states as columns.
+  {
+    std::size_t bra_subspace_index;
+    std::size_t ket_subspace_index;
+    std::vector<double> rmes;
+  };
+
+  struct CSRMatrix
+  // Sparse matrix in compressed sparse row form.
+  //
+  // The column indices of the entries in row r are
+  // column_indices[row_offsets[r]..row_offsets[r+1]-1], and similarly for
+  // values.
+  {
+    std::size_t num_rows = 0;
+    std::size_t num_cols = 0;
+    std::vector<std::size_t> row_offsets;
+    std::vector<std::size_t> column_indices;
+    std::vector<double> values;
+
+    std::size_t nnz() const {return values.size();}
+  };
+
+  ////////////////////////////////////////////////////////////////
+  // expansion
+  ////////////////////////////////////////////////////////////////
+
+  namespace detail {
+
+    class ClebschGordanTableCache
+    // Tables of <J M k q|J' M'> for fixed k, keyed by (J,J').
+    {
+     public:
+      explicit ClebschGordanTableCache(int k) : k_(k) {}
+
+      const ClebschGordanTable& Get(const HalfInt& J, const HalfInt& Jp)
+      {
+        auto key = std::make_pair(TwiceValue(J), TwiceValue(Jp));
+        auto it = tables_.find(key);
+        if (it == tables_.end())
+          it = tables_.emplace(key, ClebschGordanTable(J, k_, Jp)).first;
+        return it->second;
+      }
+
+     private:
+      int k_;
+      std::map<std::pair<int,int>, ClebschGordanTable> tables_;
+    };
+
+    inline
+    void CheckTensorComponent(int k, const HalfInt& q)
+    // Validate tensor rank and component, before tabulating Clebsch-Gordan
+    // coefficients indexed by q+k.
+    {
+      #ifdef AM_EXCEPTIONS
+      if (k<0)
+        throw std::invalid_argument("negative tensor rank in WignerEckartExpansion");
+      if (!IsInteger(q))
+        throw std::invalid_argument("tensor component and rank of different integer class in WignerEckartExpansion");
+      if (abs(q)>k)
+        throw std::invalid_argument("tensor component exceeds rank in WignerEckartExpansion");
+      #else
+      assert((k>=0) && IsInteger(q) && (abs(q)<=k));
+      #endif
+    }
+
+    inline
+    CSRMatrix WignerEckartExpansion(
+        const std::vector<AngularMomentumSubspace>& bra_subspaces,
+        const std::vector<AngularMomentumSubspace>& ket_subspaces,
+        const std::vector<ReducedMatrixBlock>& blocks,
+        int k, const HalfInt& q,
+        ClebschGordanTableCache& cg_cache
+      )
+    // Expand RMEs for single component q, with shared table cache.
+    {
+      const std::vector<std::size_t> bra_offsets = MSchemeOffsets(bra_subspaces);
+      const std::vector<std::size_t> ket_offsets = MSchemeOffsets(ket_subspaces);
+
+      CSRMatrix matrix;
+      matrix.num_rows = bra_offsets.back();
+      matrix.num_cols = ket_offsets.back();
+      matrix.row_offsets.assign(matrix.num_rows+1, 0);
+
+      // process blocks in order of ket subspace, so that column indices are
+      // sorted within each row
+      std::vector<std::size_t> block_order(blocks.size());
+      std::iota(block_order.begin(), block_order.end(), 0);
+      std::stable_sort(
+          block_order.begin(), block_order.end(),
+          [&blocks](std::size_t a, std::size_t b) {
+            return blocks[a].ket_subspace_index < blocks[b].ket_subspace_index;
+          }
+        );
+
+      // count entries per row
+      for (std::size_t block_index : block_order)
+        {
+          const ReducedMatrixBlock& block = blocks[block_index];
+          const AngularMomentumSubspace& bra = bra_subspaces.at(block.bra_subspace_index);
+          const AngularMomentumSubspace& ket = ket_subspaces.at(block.ket_subspace_index);
+          if (block.rmes.size() != bra.dimension*ket.dimension)
+            throw std::invalid_argument("RME block size does not match subspace dimensions");
+          if (!AllowedTriangle(ket.J, k, bra.J))
+            continue;
+          for (std::size_t ip=0; ip<bra.dimension; ++ip)
+            for (HalfInt Mp=-bra.J; Mp<=bra.J; ++Mp)
+              {
+                if (abs(Mp-q) > ket.J)
+                  continue;
+                const std::size_t row = bra_offsets[block.bra_subspace_index]
+                  + ip*dim(bra.J) + int(Mp+bra.J);
+                matrix.row_offsets[row+1] += ket.dimension;
+              }
+        }
+      std::partial_sum(matrix.row_offsets.begin(), matrix.row_offsets.end(), matrix.row_offsets.begin());
+      matrix.column_indices.resize(matrix.row_offsets.back());
+      matrix.values.resize(matrix.row_offsets.back());
+
+      // populate entries
+      std::vector<std::size_t> cursor(matrix.row_offsets.begin(), matrix.row_offsets.end()-1);
+      for (std::size_t block_index : block_order)
+        {
+          const ReducedMatrixBlock& block = blocks[block_index];
+          const AngularMomentumSubspace& bra = bra_subspaces[block.bra_subspace_index];
+          const AngularMomentumSubspace& ket = ket_subspaces[block.ket_subspace_index];
+          if (!AllowedTriangle(ket.J, k, bra.J))
+            continue;
+          const ClebschGordanTable& cg_table = cg_cache.Get(ket.J, bra.J);
+          const int iq = int(q+k);
+          for (std::size_t ip=0; ip<bra.dimension; ++ip)
+            for (HalfInt Mp=-bra.J; Mp<=bra.J; ++Mp)
+              {
+                const HalfInt M = Mp-q;
+                if (abs(M) > ket.J)
+                  continue;
+                const std::size_t row = bra_offsets[block.bra_subspace_index]
+                  + ip*dim(bra.J) + int(Mp+bra.J);
+                const int iM = int(M+ket.J);
+                const double cg = cg_table.Value(iM, iq);
+                const double* rme_row = &block.rmes[ip*ket.dimension];
+                std::size_t column = ket_offsets[block.ket_subspace_index] + iM;
+                std::size_t position = cursor[row];
+                for (std::size_t i=0; i<ket.dimension; ++i, column+=dim(ket.J), ++position)
+                  {
+                    matrix.column_indices[position] = column;
+                    matrix.values[position] = cg*rme_row[i];
+                  }
+                cursor[row] = position;
+              }
+        }
+
+      return matrix;
+    }
+
+  }  // namespace detail
+
+  inline
+  CSRMatrix WignerEckartExpansion(
+      const std::vector<AngularMomentumSubspace>& bra_subspaces,
+      const std::vector<AngularMomentumSubspace>& ket_subspaces,
+      const std::vector<ReducedMatrixBlock>& blocks,
+      int k, const HalfInt& q
+    )
+  // Expand RMEs of tensor operator T^k into m-scheme matrix of component T^k_q.
+  //
+  // Entries are generated for every (bra,ket) state pair connected by a block
+  // and allowed by the triangle and projection selection rules, even if the
+  // RME or Clebsch-Gordan coefficient happens to vanish numerically.  Column
+  // indices are sorted within each row.
+  //
+  // Arguments:
+  //   bra_subspaces (input): J-scheme subspaces for bra basis
+  //   ket_subspaces (input): J-scheme subspaces for ket basis
+  //   blocks (input): RME blocks, in Rose convention (at most one block per
+  //     pair of subspaces)
+  //   k (int): tensor rank
+  //   q (HalfInt): tensor component
+  //
+  // Returns:
+  //   (CSRMatrix): m-scheme matrix, with rows and columns indexed as
+  //     described for MSchemeOffsets
+  {
+    detail::CheckTensorComponent(k, q);
+    detail::ClebschGordanTableCache cg_cache(k);
+    return detail::WignerEckartExpansion(bra_subspaces, ket_subspaces, blocks, k, q, cg_cache);
+  }
+
+  inline
+  std::vector<CSRMatrix> WignerEckartExpansion(
+      const std::vector<AngularMomentumSubspace>& bra_subspaces,
+      const std::vector<AngularMomentumSubspace>& ket_subspaces,
+      const std::vector<ReducedMatrixBlock>& blocks,
+      int k
+    )
+  // Expand RMEs of tensor operator T^k into m-scheme matrices of all components.
+  //
+  // Clebsch-Gordan tables are shared among components.
+  //
+  // Returns:
+  //   (std::vector<CSRMatrix>): m-scheme matrices for q=-k,...,k
+  {
+    detail::CheckTensorComponent(k, 0);
+    detail::ClebschGordanTableCache cg_cache(k);
+    std::vector<CSRMatrix> matrices;
+    matrices.reserve(2*k+1);
+    for (int q=-k; q<=k; ++q)
+      matrices.push_back(
+          detail::WignerEckartExpansion(bra_subspaces, ket_subspaces, blocks, k, q, cg_cache)
+        );
+    return matrices;
+  }
+
+}  // namespace am
+
+#endif  // AM_WIGNER_ECKART_H_
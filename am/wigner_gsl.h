@@ -32,6 +32,9 @@
     wigner_gsl_twice.h.
   + 04/28/18 (mac): Restore missing Hat2 and ParitySign2 to
     wigner_gsl_twice.h.
+  + 10/18/26: Use tabulated Hat factors (factor_table.h).
+  + 10/18/26: Instrument calls under AM_INSTRUMENT (instrument.h).
+  + 10/18/26: Profile symbol arguments under AM_INSTRUMENT_ARGUMENTS.
 
 ****************************************************************/
 
@@ -41,6 +44,8 @@
 #include <gsl/gsl_sf_coupling.h>
 
 #include "am.h"
+#include "factor_table.h"
+#include "instrument.h"
 
 namespace am {
 
@@ -54,6 +59,8 @@ namespace am {
         const HalfInt& ma, const HalfInt& mb, const HalfInt& mc
       )
   {
+    AM_INSTRUMENT_FUNCTION(Wigner3J);
+    AM_INSTRUMENT_SYMBOL(Wigner3J, TwiceValue(ja), TwiceValue(jb), TwiceValue(jc), TwiceValue(ma), TwiceValue(mb), TwiceValue(mc));
     return gsl_sf_coupling_3j(
         TwiceValue(ja), TwiceValue(jb), TwiceValue(jc),
         TwiceValue(ma), TwiceValue(mb), TwiceValue(mc)
@@ -71,7 +78,9 @@ namespace am {
         const HalfInt& jc, const HalfInt& mc
       )
   {
-    return Hat(jc)*ParitySign(ja-jb+mc)
+    AM_INSTRUMENT_FUNCTION(ClebschGordan);
+    AM_INSTRUMENT_SYMBOL(Wigner3J, TwiceValue(ja), TwiceValue(jb), TwiceValue(jc), TwiceValue(ma), TwiceValue(mb), -TwiceValue(mc));
+    return TabulatedHat(jc)*ParitySign(ja-jb+mc)
       *gsl_sf_coupling_3j(
           TwiceValue(ja), TwiceValue(jb), TwiceValue(jc),
           TwiceValue(ma), TwiceValue(mb), -TwiceValue(mc)
@@ -88,6 +97,8 @@ namespace am {
         const HalfInt& jd, const HalfInt& je, const HalfInt& jf
       )
   {
+    AM_INSTRUMENT_FUNCTION(Wigner6J);
+    AM_INSTRUMENT_SYMBOL(Wigner6J, TwiceValue(ja), TwiceValue(jb), TwiceValue(jc), TwiceValue(jd), TwiceValue(je), TwiceValue(jf));
     return gsl_sf_coupling_6j(
         TwiceValue(ja), TwiceValue(jb), TwiceValue(jc),
         TwiceValue(jd), TwiceValue(je), TwiceValue(jf)
@@ -109,7 +120,8 @@ namespace am {
         const HalfInt& jd, const HalfInt& je, const HalfInt& jf
       )
   {
-    return ParitySign(ja+jb+jd+je)*Hat(jc)*Hat(jf)
+    AM_INSTRUMENT_FUNCTION(Unitary6J);
+    return ParitySign(ja+jb+jd+je)*TabulatedHat(jc)*TabulatedHat(jf)
       *Wigner6J(ja,jb,jc,jd,je,jf);
   }
 
@@ -129,7 +141,8 @@ namespace am {
         const HalfInt& jd, const HalfInt& je, const HalfInt& jf
       )
   {
-    return ParitySign(jb+je+jc+jf)*Hat(jc)*Hat(jf)
+    AM_INSTRUMENT_FUNCTION(Unitary6JZ);
+    return ParitySign(jb+je+jc+jf)*TabulatedHat(jc)*TabulatedHat(jf)
       *Wigner6J(ja,jb,jc,jd,je,jf);
   }
 
@@ -144,6 +157,8 @@ namespace am {
         const HalfInt& jg, const HalfInt& jh, const HalfInt& ji
       )
   {
+    AM_INSTRUMENT_FUNCTION(Wigner9J);
+    AM_INSTRUMENT_SYMBOL(Wigner9J, TwiceValue(ja), TwiceValue(jb), TwiceValue(jc), TwiceValue(jd), TwiceValue(je), TwiceValue(jf), TwiceValue(jg), TwiceValue(jh), TwiceValue(ji));
     return gsl_sf_coupling_9j(
         TwiceValue(ja), TwiceValue(jb), TwiceValue(jc),
         TwiceValue(jd), TwiceValue(je), TwiceValue(jf),
@@ -162,7 +177,8 @@ namespace am {
         const HalfInt& jg, const HalfInt& jh, const HalfInt& ji
       )
   {
-    return Hat(jc)*Hat(jf)*Hat(jg)*Hat(jh)
+    AM_INSTRUMENT_FUNCTION(Unitary9J);
+    return TabulatedHat(jc)*TabulatedHat(jf)*TabulatedHat(jg)*TabulatedHat(jh)
       *Wigner9J(
           ja, jb, jc,
           jd, je, jf,
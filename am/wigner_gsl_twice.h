@@ -33,6 +33,9 @@
   + 04/28/18 (mac): Restore missing Hat2 and ParitySign2 to
     wigner_gsl_twice.h.
   + 04/10/20 (pjf): Replace assertions with exceptions.
+  + 10/18/26: Use tabulated Hat factors (factor_table.h).
+  + 10/18/26: Instrument calls under AM_INSTRUMENT (instrument.h).
+  + 10/18/26: Profile symbol arguments under AM_INSTRUMENT_ARGUMENTS.
 
 ****************************************************************/
 
@@ -44,6 +47,8 @@
 #include <gsl/gsl_sf_coupling.h>
 
 #include "am.h"
+#include "factor_table.h"
+#include "instrument.h"
 
 namespace am {
 
@@ -52,7 +57,7 @@ namespace am {
   inline
     double Hat2(int two_j)
   {
-    return sqrt(static_cast<double>(two_j+1));
+    return TabulatedHat2(two_j);
   }
 
 
@@ -77,6 +82,8 @@ namespace am {
 		     int two_ma, int two_mb, int two_mc
 		     )
   {
+    AM_INSTRUMENT_FUNCTION(Wigner3J2);
+    AM_INSTRUMENT_SYMBOL(Wigner3J, two_ja, two_jb, two_jc, two_ma, two_mb, two_mc);
     return gsl_sf_coupling_3j(
 			      two_ja, two_jb, two_jc,
 			      two_ma, two_mb, two_mc
@@ -94,6 +101,8 @@ namespace am {
 			  int two_jc, int two_mc
 			  )
   {
+    AM_INSTRUMENT_FUNCTION(ClebschGordan2);
+    AM_INSTRUMENT_SYMBOL(Wigner3J, two_ja, two_jb, two_jc, two_ma, two_mb, -two_mc);
     return Hat2(two_jc)*ParitySign2(two_ja-two_jb+two_mc)
       *gsl_sf_coupling_3j(
 			  two_ja, two_jb, two_jc,
@@ -111,6 +120,8 @@ namespace am {
 		     int two_jd, int two_je, int two_jf
 		     )
   {
+    AM_INSTRUMENT_FUNCTION(Wigner6J2);
+    AM_INSTRUMENT_SYMBOL(Wigner6J, two_ja, two_jb, two_jc, two_jd, two_je, two_jf);
     return gsl_sf_coupling_6j(
 			      two_ja, two_jb, two_jc,
 			      two_jd, two_je, two_jf
@@ -127,6 +138,8 @@ namespace am {
 		      int two_jd, int two_je, int two_jf
 		      )
   {
+    AM_INSTRUMENT_FUNCTION(Unitary6J2);
+    AM_INSTRUMENT_SYMBOL(Wigner6J, two_ja, two_jb, two_jc, two_jd, two_je, two_jf);
     return ParitySign2(two_ja+two_jb+two_jd+two_je)*Hat2(two_jc)*Hat2(two_jf)*gsl_sf_coupling_6j(
 												 two_ja, two_jb, two_jc,
 												 two_jd, two_je, two_jf
@@ -144,6 +157,8 @@ namespace am {
 		     int two_jg, int two_jh, int two_ji
 		     )
   {
+    AM_INSTRUMENT_FUNCTION(Wigner9J2);
+    AM_INSTRUMENT_SYMBOL(Wigner9J, two_ja, two_jb, two_jc, two_jd, two_je, two_jf, two_jg, two_jh, two_ji);
     return gsl_sf_coupling_9j(
 			      two_ja, two_jb, two_jc,
 			      two_jd, two_je, two_jf,
@@ -162,6 +177,8 @@ namespace am {
 		      int two_jg, int two_jh, int two_ji
 		      )
   {
+    AM_INSTRUMENT_FUNCTION(Unitary9J2);
+    AM_INSTRUMENT_SYMBOL(Wigner9J, two_ja, two_jb, two_jc, two_jd, two_je, two_jf, two_jg, two_jh, two_ji);
     return Hat2(two_jc)*Hat2(two_jf)*Hat2(two_jg)*Hat2(two_jh)
       *gsl_sf_coupling_9j(
 			  two_ja, two_jb, two_jc,
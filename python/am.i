@@ -9,6 +9,11 @@
 //
 //     > swig -python -c++ -cppext cpp -builtin -fastdispatch -py3 am.i
 //
+// To build the module from a freshly generated wrapper (in the build
+// directory, leaving the committed am_wrap.cpp untouched):
+//
+//     > python3 setup.py build_ext --regenerate-wrapper
+//
 // Patrick J. Fasano
 // University of Notre Dame
 //
@@ -17,6 +22,15 @@
 //   removing assertions.
 // + 05/18/20 (pjf): Correctly expose hashing so that dicts work
 //   as expected.
+// + 10/18/26: Add NumPy-vectorized coefficient functions (am_numpy.h).
+// + 10/18/26: Add NumPy dtype for HalfInt (am_halfint_dtype.h).
+// + 10/18/26: Add buffer protocol for containers (am_buffer.h).
+// + 10/18/26: Expose thread control for bulk routines (parallel.h).
+// + 10/18/26: Add fast-call path for scalar coefficients (am_fastcall.h).
+// + 10/18/26: Add symbol cache functions (am_symbol_cache.h).
+// + 10/18/26: Add table builder functions (am_builders.h).
+// + 10/18/26: Add pickle support for HalfInt and containers (am_pickle.h).
+// + 10/18/26: Move %init to end, after type registration.
 ////////////////////////////////////////////////////////////////
 %module am
 %include "typemaps.i"
@@ -52,6 +66,53 @@
 #include "am/wigner_gsl.h"
 #include "am/racah_reduction.h"
 #include "am/rme.h"
+#include "am/parallel.h"
+%}
+
+// NumPy extensions (see am_halfint_dtype.h and am_numpy.h), fast-call
+// scalar functions (see am_fastcall.h), symbol cache functions (see
+// am_symbol_cache.h), and table builder functions (see am_builders.h),
+// registered at module initialization (see %init at end of file)
+%{
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+#include <numpy/ufuncobject.h>
+#include "python/am_halfint_dtype.h"
+#include "python/am_numpy.h"
+#include "python/am_fastcall.h"
+#include "python/am_symbol_cache.h"
+#include "python/am_builders.h"
+
+// conversion of Python objects to and from HalfInt, for HalfInt dtype (see
+// am_halfint_dtype.h)
+namespace am_python {
+bool HalfIntFromPyObject(PyObject* object, int& two_value) {
+  void *argp = 0;
+  if (SWIG_IsOK(SWIG_ConvertPtr(object, &argp, SWIGTYPE_p_HalfInt, 0))) {
+    two_value = reinterpret_cast<HalfInt*>(argp)->TwiceValue();
+    return true;
+  }
+  if (PyIndex_Check(object)) {
+    PyObject* index = PyNumber_Index(object);
+    if (!index) return false;
+    const long value = PyLong_AsLong(index);
+    Py_DECREF(index);
+    two_value = int(2*value);
+    return !PyErr_Occurred();
+  }
+  const double value = PyFloat_AsDouble(object);
+  if (PyErr_Occurred()) return false;
+  if (!(std::abs(2*value)<=double(std::numeric_limits<int>::max())) || (2*value!=std::floor(2*value))) {
+    PyErr_Format(PyExc_ValueError, "value %R is not a half-integer", object);
+    return false;
+  }
+  two_value = int(2*value);
+  return true;
+}
+PyObject* HalfIntToPyObject(int two_value) {
+  return SWIG_InternalNewPointerObj((new HalfInt(two_value,2)), SWIGTYPE_p_HalfInt, SWIG_POINTER_OWN |  0 );
+}
+}
 %}
 
 // ignore global am constants
@@ -221,6 +282,115 @@ PyObject* HalfInt_dispatch_mul(PyObject* a, PyObject* b) {
   bool operator!=(const HalfInt& h2) { return (*$self) != h2; };
 };
 
+////////////////////////////////////////////////////////////////
+// Buffer protocol for containers, with lock against modification
+// while exported (see am_buffer.h)
+////////////////////////////////////////////////////////////////
+
+%{
+#include "python/am_buffer.h"
+
+namespace am_python {
+template<typename Container>
+int SwigGetBuffer(PyObject* exporter, Py_buffer* view, int flags, swig_type_info* type) {
+  void *argp = 0;
+  if (!SWIG_IsOK(SWIG_ConvertPtr(exporter, &argp, type, 0))) {
+    PyErr_SetString(PyExc_BufferError, "object does not wrap expected container type");
+    return -1;
+  }
+  return GetBuffer(exporter, *reinterpret_cast<Container*>(argp), view, flags);
+}
+int HalfIntPairGetBuffer(PyObject* exporter, Py_buffer* view, int flags) {
+  return SwigGetBuffer<std::pair<HalfInt,HalfInt> >(exporter, view, flags, SWIGTYPE_p_std__pairT_HalfInt_HalfInt_t);
+}
+int HalfIntVectorGetBuffer(PyObject* exporter, Py_buffer* view, int flags) {
+  return SwigGetBuffer<std::vector<HalfInt> >(exporter, view, flags, SWIGTYPE_p_std__vectorT_HalfInt_t);
+}
+int PairIntGetBuffer(PyObject* exporter, Py_buffer* view, int flags) {
+  return SwigGetBuffer<std::pair<int,int> >(exporter, view, flags, SWIGTYPE_p_std__pairT_int_int_t);
+}
+int VectorIntGetBuffer(PyObject* exporter, Py_buffer* view, int flags) {
+  return SwigGetBuffer<std::vector<int> >(exporter, view, flags, SWIGTYPE_p_std__vectorT_int_t);
+}
+}
+%}
+
+%feature("python:bf_getbuffer", functype="getbufferproc") std::pair<HalfInt,HalfInt> "am_python::HalfIntPairGetBuffer";
+%feature("python:bf_releasebuffer", functype="releasebufferproc") std::pair<HalfInt,HalfInt> "am_python::ReleaseBuffer";
+%feature("python:bf_getbuffer", functype="getbufferproc") std::vector<HalfInt> "am_python::HalfIntVectorGetBuffer";
+%feature("python:bf_releasebuffer", functype="releasebufferproc") std::vector<HalfInt> "am_python::ReleaseBuffer";
+%feature("python:bf_getbuffer", functype="getbufferproc") std::pair<int,int> "am_python::PairIntGetBuffer";
+%feature("python:bf_releasebuffer", functype="releasebufferproc") std::pair<int,int> "am_python::ReleaseBuffer";
+%feature("python:bf_getbuffer", functype="getbufferproc") std::vector<int> "am_python::VectorIntGetBuffer";
+%feature("python:bf_releasebuffer", functype="releasebufferproc") std::vector<int> "am_python::ReleaseBuffer";
+
+// Methods which may reallocate vector storage raise BufferError while the
+// storage is exported.
+%define %am_buffer_lock(Container, method, check)
+%exception Container::method {
+  if (check) {
+    PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+    SWIG_fail;
+  }
+  try {
+    $action
+  } catch (const std::invalid_argument& e) {
+    SWIG_exception(SWIG_ValueError, e.what());
+  } catch (const std::domain_error& e) {
+    SWIG_exception(SWIG_ValueError, e.what());
+  } catch (const std::exception& e) {
+    SWIG_exception(SWIG_RuntimeError, e.what());
+  }
+}
+%enddef
+%define %am_buffer_lock_vector(Container)
+%am_buffer_lock(Container, append, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, pop, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, push_back, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, pop_back, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, resize, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, reserve, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, insert, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, erase, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, assign, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, clear, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, __setitem__, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, __delitem__, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, __setslice__, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, __delslice__, am_python::BufferExported(arg1))
+%am_buffer_lock(Container, swap, am_python::BufferExported(arg1) || am_python::BufferExported(arg2))
+%enddef
+%am_buffer_lock_vector(std::vector<HalfInt>)
+%am_buffer_lock_vector(std::vector<int>)
+
+////////////////////////////////////////////////////////////////
+// Pickle support for HalfInt and containers, installed at module
+// initialization (see am_pickle.h)
+////////////////////////////////////////////////////////////////
+
+%{
+#include "python/am_pickle.h"
+
+namespace am_python {
+template<>
+PyObject* ContainerToPyObject(std::vector<HalfInt>* container) {
+  return SWIG_InternalNewPointerObj(container, SWIGTYPE_p_std__vectorT_HalfInt_t, SWIG_POINTER_OWN |  0 );
+}
+template<>
+PyObject* ContainerToPyObject(std::pair<HalfInt,HalfInt>* container) {
+  return SWIG_InternalNewPointerObj(container, SWIGTYPE_p_std__pairT_HalfInt_HalfInt_t, SWIG_POINTER_OWN |  0 );
+}
+template<>
+PyObject* ContainerToPyObject(std::vector<int>* container) {
+  return SWIG_InternalNewPointerObj(container, SWIGTYPE_p_std__vectorT_int_t, SWIG_POINTER_OWN |  0 );
+}
+template<>
+PyObject* ContainerToPyObject(std::pair<int,int>* container) {
+  return SWIG_InternalNewPointerObj(container, SWIGTYPE_p_std__pairT_int_int_t, SWIG_POINTER_OWN |  0 );
+}
+}
+%}
+
 // instantiate STL templates for types defined in HalfInt
 %template(HalfIntPair) std::pair<HalfInt, HalfInt>;  // HalfInt::pair
 %template(HalfIntVector) std::vector<HalfInt>;  // HalfInt::vector
@@ -268,3 +438,49 @@ AngularMomentumRangeIntersection<int,HalfInt,HalfInt,nullptr>;
 AngularMomentumRangeIntersection<HalfInt,HalfInt,HalfInt,nullptr>;
 };
 
+////////////////////////////////////////////////////////////////
+// Thread control for bulk routines (see parallel.h)
+//
+// Bulk (array) routines release the GIL while computing, and distribute
+// work over the am thread pool.
+////////////////////////////////////////////////////////////////
+
+namespace am {
+void SetNumThreads(int num_threads);
+int GetNumThreads();
+}
+
+////////////////////////////////////////////////////////////////
+// Module initialization
+//
+// SWIG emits %init code, and the registration of each wrapped type, into
+// SWIG_init in the order of this file.  This block looks up HalfInt and
+// installs methods on the container types, so it must follow all %include
+// and %template directives.
+////////////////////////////////////////////////////////////////
+
+%init %{
+  import_array();
+  import_umath();
+  {
+    PyObject* halfint_type = PyObject_GetAttrString(m, "HalfInt");
+    if (!halfint_type)
+      return NULL;
+    int status = am_python::RegisterHalfIntDType(
+        m, public_interface, reinterpret_cast<PyTypeObject*>(halfint_type)
+      );
+    if (status==0)
+      status = am_python::InstallFastCallFunctions(m, reinterpret_cast<PyTypeObject*>(halfint_type));
+    Py_DECREF(halfint_type);
+    if (status<0)
+      return NULL;
+  }
+  if (am_python::AddNumPyFunctions(m, public_interface)<0)
+    return NULL;
+  if (am_python::AddSymbolCacheFunctions(m, public_interface)<0)
+    return NULL;
+  if (am_python::AddBuilderFunctions(m, public_interface)<0)
+    return NULL;
+  if (am_python::InstallPickleSupport(m)<0)
+    return NULL;
+%}
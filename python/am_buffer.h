@@ -0,0 +1,217 @@
+/****************************************************************
+  am_buffer.h
+
+  Zero-copy exposure of container memory to Python, for the am Python
+  module.
+
+  Buffer protocol: The SWIG-wrapped containers HalfIntVector, HalfIntPair,
+  vectori, and pairi export their memory through the Python buffer protocol,
+  as one-dimensional, C-contiguous, writable buffers of int32 ("i").  For
+  HalfInt containers, the elements are the twice-values 2j:
+
+    >>> v = am.HalfIntVector([am.HalfInt(1,2), am.HalfInt(3,2)])
+    >>> memoryview(v).tolist()
+    [1, 3]
+    >>> j = numpy.asarray(v).view(am.HalfIntDType)  # no copy
+
+  Lifetime: A buffer (memoryview, NumPy array, etc.) holds a reference to the
+  exporting Python object, so the container remains alive while the buffer
+  exists.  (As for any SWIG proxy, a proxy which does not own its C++ object,
+  e.g., one referring to a member of another object, is only valid while
+  that object is alive.)  While any buffer export of a container exists, the
+  container is locked: its own methods which modify it (append, resize,
+  item and slice assignment, etc.) raise BufferError, since they could
+  reallocate the exported memory.  The contents may still be modified
+  through the buffer.  The lock is released when the last buffer is
+  released (e.g., memoryview.release(), or deletion of the NumPy array).
+
+  Bulk results: Results computed in C++ into a std::vector are handed to
+  NumPy without copying by ArrayFromVector, which transfers ownership of the
+  vector storage to the array.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Accept run-time array rank in ArrayFromVector.
+
+****************************************************************/
+
+#ifndef AM_PYTHON_AM_BUFFER_H_
+#define AM_PYTHON_AM_BUFFER_H_
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "am/halfint.h"
+
+namespace am_python {
+
+  ////////////////////////////////////////////////////////////////
+  // buffer export registry
+  ////////////////////////////////////////////////////////////////
+
+  inline
+  std::unordered_map<const void*,Py_ssize_t>& BufferExports()
+  // Number of outstanding buffer exports, by C++ container address.
+  //
+  // Accessed only while holding the GIL.
+  {
+    static std::unordered_map<const void*,Py_ssize_t> exports;
+    return exports;
+  }
+
+  inline
+  bool BufferExported(const void* container)
+  // Test whether container memory is currently exported.
+  {
+    return BufferExports().count(container)>0;
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // buffer protocol
+  ////////////////////////////////////////////////////////////////
+
+  struct BufferInternal
+  // Per-export storage, referenced by Py_buffer::internal.
+  {
+    const void* container;
+    Py_ssize_t shape;
+    Py_ssize_t stride;
+  };
+
+  template<typename T> struct BufferElement;
+  template<> struct BufferElement<int> {static constexpr const char* kFormat = "i";};
+  template<> struct BufferElement<HalfInt> {static constexpr const char* kFormat = "i";};  // 2j
+  template<> struct BufferElement<double> {static constexpr const char* kFormat = "d";};
+
+  static_assert(sizeof(HalfInt)==sizeof(int), "HalfInt buffer export assumes int layout");
+
+  inline
+  int FillBuffer(
+      PyObject* exporter, Py_buffer* view, int flags,
+      const void* container, void* data, Py_ssize_t size, Py_ssize_t itemsize, const char* format
+    )
+  // Fill in one-dimensional, C-contiguous, writable buffer, and register
+  // export of container.
+  //
+  // Arguments:
+  //   exporter (input): Python object exporting buffer
+  //   view, flags (input): as for getbufferproc
+  //   container (input): address of C++ container (lock key)
+  //   data, size, itemsize, format (input): memory layout
+  //
+  // Returns:
+  //   (int): 0 on success, or -1 with Python exception set
+  {
+    static int empty_data;
+    BufferInternal* internal = new BufferInternal{container, size, itemsize};
+    view->buf = data ? data : &empty_data;
+    view->obj = exporter;
+    Py_INCREF(exporter);
+    view->len = size*itemsize;
+    view->itemsize = itemsize;
+    view->readonly = 0;
+    view->ndim = 1;
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(format) : nullptr;
+    view->shape = (flags & PyBUF_ND) ? &internal->shape : nullptr;
+    view->strides = ((flags & PyBUF_STRIDES)==PyBUF_STRIDES) ? &internal->stride : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = internal;
+    ++BufferExports()[container];
+    return 0;
+  }
+
+  inline
+  void ReleaseBuffer(PyObject*, Py_buffer* view)
+  // Release buffer, and unregister export (releasebufferproc).
+  {
+    BufferInternal* internal = static_cast<BufferInternal*>(view->internal);
+    if (!internal)
+      return;
+    auto& exports = BufferExports();
+    auto it = exports.find(internal->container);
+    if ((it!=exports.end()) && (--(it->second)==0))
+      exports.erase(it);
+    delete internal;
+    view->internal = nullptr;
+  }
+
+  template<typename T>
+  int GetBuffer(PyObject* exporter, std::vector<T>& container, Py_buffer* view, int flags)
+  // Export memory of vector.
+  {
+    return FillBuffer(
+        exporter, view, flags, &container, container.data(), Py_ssize_t(container.size()),
+        sizeof(T), BufferElement<T>::kFormat
+      );
+  }
+
+  template<typename T>
+  int GetBuffer(PyObject* exporter, std::pair<T,T>& container, Py_buffer* view, int flags)
+  // Export memory of homogeneous pair, as two-element array.
+  {
+    static_assert(sizeof(std::pair<T,T>)==2*sizeof(T), "pair buffer export assumes contiguous members");
+    return FillBuffer(
+        exporter, view, flags, &container, &container.first, 2,
+        sizeof(T), BufferElement<T>::kFormat
+      );
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // bulk results
+  ////////////////////////////////////////////////////////////////
+
+  template<typename T>
+  PyObject* ArrayFromVector(std::vector<T>&& values, const std::vector<npy_intp>& shape, int type_num)
+  // Construct NumPy array taking ownership of vector storage, without
+  // copying.
+  //
+  // The vector is moved into a capsule, which is set as the array base
+  // object, and is destroyed when the array (and any views of it) are
+  // deleted.  Requires the NumPy C API.
+  //
+  // Arguments:
+  //   values (input): values, in C order (moved from)
+  //   shape (input): array shape (product must equal values.size())
+  //   type_num (input): NumPy type number corresponding to T
+  //
+  // Returns:
+  //   (PyObject*): new reference, or nullptr with Python exception set
+  {
+    std::vector<T>* storage = new std::vector<T>(std::move(values));
+    PyObject* capsule = PyCapsule_New(
+        storage, "am.ArrayFromVector",
+        [](PyObject* object) {
+          delete static_cast<std::vector<T>*>(PyCapsule_GetPointer(object, "am.ArrayFromVector"));
+        }
+      );
+    if (!capsule)
+      {
+        delete storage;
+        return nullptr;
+      }
+    static T empty_data;
+    PyObject* array = PyArray_SimpleNewFromData(
+        int(shape.size()), const_cast<npy_intp*>(shape.data()), type_num,
+        storage->empty() ? &empty_data : storage->data()
+      );
+    if (!array)
+      {
+        Py_DECREF(capsule);
+        return nullptr;
+      }
+    if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(array), capsule)<0)  // steals capsule
+      {
+        Py_DECREF(array);
+        return nullptr;
+      }
+    return array;
+  }
+
+}  // namespace am_python
+
+#endif  // AM_PYTHON_AM_BUFFER_H_
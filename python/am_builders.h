@@ -0,0 +1,496 @@
+/****************************************************************
+  am_builders.h
+
+  Builders for whole tables of angular momentum coefficients, returned as
+  NumPy arrays, for the am Python module.
+
+  Clebsch-Gordan coupling matrix (see clebsch_gordan.h):
+
+    ClebschGordanMatrix(j1, j2, num_threads=0)
+
+  returns the orthogonal matrix <j1 m1 j2 m2|J M> of shape
+  ((2j1+1)(2j2+1), (2j1+1)(2j2+1)), with rows indexed by the uncoupled
+  states (m1,m2) in lexicographic order, i.e., row (j1+m1)*(2j2+1)+(j2+m2),
+  and columns indexed by the coupled states (J,M), for J=|j1-j2|,...,j1+j2,
+  and M=-J,...,J within each J.
+
+  Wigner small-d matrices (see wigner_d.h):
+
+    WignerSmallDArray(j, betas, num_threads=0)
+
+  returns d^j_{m'm}(beta) for an array of angles, with shape
+  betas.shape+(2j+1,2j+1), indexed by (...,j+m',j+m).
+
+  Spherical harmonic reduced matrix elements (see rme.h):
+
+    SphericalHarmonicCRMEArray(lmax, kmax=2*lmax, num_threads=0)
+    LJCoupledSphericalHarmonicCRMEArray(lmax, kmax=2*lmax, num_threads=0)
+
+  return SphericalHarmonicCRME(lp,l,k), with shape (lmax+1,lmax+1,kmax+1),
+  indexed by (lp,l,k), and LJCoupledSphericalHarmonicCRME(lp,jp,l,j,k), with
+  shape (lmax+1,2,lmax+1,2,kmax+1), indexed by (lp,jp-lp+1/2,l,j-l+1/2,k).
+  Disallowed entries are zero, as in SphericalHarmonicRMETable.
+
+  Racah reduction factor blocks (see racah_reduction.h):
+
+    RacahReductionFactor1RoseMatrix(bra_states, ket_states, J0, num_threads=0)
+    ...
+    RacahReductionFactor12RoseMatrix(bra_states, ket_states, J0a, J0b, J0, num_threads=0)
+    ...
+
+  take bra and ket two-system states as arrays of shape (n,3), with rows
+  (J1,J2,J), and return the matrix of shape (n_bra,n_ket) of reduction
+  factors.  Entries forbidden by the selection rules of the reduction
+  formula (e.g., J2'!=J2 for a first-system operator) are zero.
+
+  The tables are built in C++, with the GIL released, and are handed to
+  NumPy without copying (see ArrayFromVector in am_buffer.h).
+
+  This file is included by the SWIG interface file am.i, after am_numpy.h,
+  and is not intended for use from C++.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+
+****************************************************************/
+
+#ifndef AM_PYTHON_AM_BUILDERS_H_
+#define AM_PYTHON_AM_BUILDERS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "am/am.h"
+#include "am/clebsch_gordan.h"
+#include "am/halfint.h"
+#include "am/parallel.h"
+#include "am/racah_reduction.h"
+#include "am/rme.h"
+#include "am/wigner_d.h"
+#include "python/am_buffer.h"
+#include "python/am_numpy.h"
+
+namespace am_python {
+
+  namespace builders {
+
+    template<typename F>
+    bool RunWithoutGIL(const char* function_name, F&& f)
+    // Invoke f with GIL released, and translate any exception as in am.i
+    // default exception handler.
+    //
+    // Returns:
+    //   (bool): success, or false with Python exception set
+    {
+      std::exception_ptr exception;
+      Py_BEGIN_ALLOW_THREADS
+      try
+        {
+          f();
+        }
+      catch (...)
+        {
+          exception = std::current_exception();
+        }
+      Py_END_ALLOW_THREADS
+      if (!exception)
+        return true;
+      try
+        {
+          std::rethrow_exception(exception);
+        }
+      catch (const std::invalid_argument& e)
+        {
+          PyErr_Format(PyExc_ValueError, "%s: %s", function_name, e.what());
+        }
+      catch (const std::domain_error& e)
+        {
+          PyErr_Format(PyExc_ValueError, "%s: %s", function_name, e.what());
+        }
+      catch (const std::exception& e)
+        {
+          PyErr_Format(PyExc_RuntimeError, "%s: %s", function_name, e.what());
+        }
+      catch (...)
+        {
+          PyErr_Format(PyExc_RuntimeError, "%s: unknown exception", function_name);
+        }
+      return false;
+    }
+
+    inline
+    bool NonnegativeHalfInt(PyObject* object, const char* function_name, const char* argument_name, int& two_value)
+    // Extract nonnegative angular momentum argument, as twice-value.
+    //
+    // Returns:
+    //   (bool): success, or false with Python exception set
+    {
+      if (!HalfIntFromPyObject(object, two_value))
+        return false;
+      if (two_value<0)
+        {
+          PyErr_Format(PyExc_ValueError, "%s: negative %s", function_name, argument_name);
+          return false;
+        }
+      return true;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Clebsch-Gordan matrix
+    ////////////////////////////////////////////////////////////////
+
+    inline
+    PyObject* ClebschGordanMatrix(PyObject*, PyObject* args, PyObject* kwargs)
+    {
+      static const char* keywords[] = {"j1", "j2", "num_threads", nullptr};
+      PyObject* j1_object;
+      PyObject* j2_object;
+      int num_threads = 0;
+      if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|i:ClebschGordanMatrix", const_cast<char**>(keywords), &j1_object, &j2_object, &num_threads))
+        return nullptr;
+      int two_j1, two_j2;
+      if (!NonnegativeHalfInt(j1_object, "ClebschGordanMatrix", "j1", two_j1)
+          || !NonnegativeHalfInt(j2_object, "ClebschGordanMatrix", "j2", two_j2))
+        return nullptr;
+
+      const std::size_t dimension = std::size_t(two_j1+1)*(two_j2+1);
+      std::vector<double> values;
+      const bool success = RunWithoutGIL("ClebschGordanMatrix", [&] {
+          values.assign(dimension*dimension, 0.);
+          const int two_J_min = std::abs(two_j1-two_j2);
+          const int num_J = (two_j1+two_j2-two_J_min)/2+1;
+          am::ParallelFor(0, num_J, [&](std::ptrdiff_t J_index) {
+              const int two_J = two_J_min+2*int(J_index);
+              // column offset: sum of 2J'+1 over J'<J
+              const std::size_t column_offset = std::size_t(J_index)*(two_J_min+1)+std::size_t(J_index)*(J_index-1);
+              const am::ClebschGordanTable table(HalfInt(two_j1,2), HalfInt(two_j2,2), HalfInt(two_J,2));
+              for (int i1=0; i1<=two_j1; ++i1)
+                for (int i2=0; i2<=two_j2; ++i2)
+                  {
+                    // 2M = 2m1+2m2, and column within J block is J+M
+                    const int two_M = (2*i1-two_j1)+(2*i2-two_j2);
+                    if (std::abs(two_M)>two_J)
+                      continue;
+                    const std::size_t row = std::size_t(i1)*(two_j2+1)+i2;
+                    const std::size_t column = column_offset+(two_J+two_M)/2;
+                    values[row*dimension+column] = table.Value(i1,i2);
+                  }
+            }, num_threads);
+        });
+      if (!success)
+        return nullptr;
+      return ArrayFromVector(std::move(values), {npy_intp(dimension), npy_intp(dimension)}, NPY_FLOAT64);
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Wigner small-d matrices
+    ////////////////////////////////////////////////////////////////
+
+    inline
+    PyObject* WignerSmallDArray(PyObject*, PyObject* args, PyObject* kwargs)
+    {
+      static const char* keywords[] = {"j", "betas", "num_threads", nullptr};
+      PyObject* j_object;
+      PyObject* betas_object;
+      int num_threads = 0;
+      if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|i:WignerSmallDArray", const_cast<char**>(keywords), &j_object, &betas_object, &num_threads))
+        return nullptr;
+      int two_j;
+      if (!NonnegativeHalfInt(j_object, "WignerSmallDArray", "j", two_j))
+        return nullptr;
+      PyArrayObject* betas = reinterpret_cast<PyArrayObject*>(
+          PyArray_FROMANY(betas_object, NPY_FLOAT64, 0, 0, NPY_ARRAY_CARRAY_RO|NPY_ARRAY_FORCECAST)
+        );
+      if (!betas)
+        return nullptr;
+
+      const std::size_t dimension = std::size_t(two_j+1);
+      const std::size_t block_size = dimension*dimension;
+      const std::ptrdiff_t num_angles = PyArray_SIZE(betas);
+      const double* beta_values = static_cast<const double*>(PyArray_DATA(betas));
+      std::vector<npy_intp> shape(PyArray_DIMS(betas), PyArray_DIMS(betas)+PyArray_NDIM(betas));
+      shape.push_back(npy_intp(dimension));
+      shape.push_back(npy_intp(dimension));
+      std::vector<double> values;
+      const bool success = RunWithoutGIL("WignerSmallDArray", [&] {
+          values.resize(block_size*num_angles);
+          am::ParallelForRange(0, num_angles, 16, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+              // recursion passes through all j'<=j
+              std::vector<double> matrices(am::WignerDSize(two_j)), scratch;
+              for (std::ptrdiff_t a=begin; a<end; ++a)
+                {
+                  am::detail::WignerSmallDRecursion(two_j, beta_values[a], matrices.data(), scratch);
+                  std::copy_n(matrices.data()+am::WignerDOffset(two_j), block_size, values.data()+a*block_size);
+                }
+            }, num_threads);
+        });
+      Py_DECREF(betas);
+      if (!success)
+        return nullptr;
+      return ArrayFromVector(std::move(values), shape, NPY_FLOAT64);
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // spherical harmonic RMEs
+    ////////////////////////////////////////////////////////////////
+
+    template<bool lj_coupled>
+    PyObject* SphericalHarmonicCRMEArray(PyObject*, PyObject* args, PyObject* kwargs)
+    {
+      const char* function_name = lj_coupled ? "LJCoupledSphericalHarmonicCRMEArray" : "SphericalHarmonicCRMEArray";
+      static const char* keywords[] = {"lmax", "kmax", "num_threads", nullptr};
+      const std::string format = std::string("i|ii:")+function_name;
+      int lmax, kmax = -1, num_threads = 0;
+      if (!PyArg_ParseTupleAndKeywords(args, kwargs, format.c_str(), const_cast<char**>(keywords), &lmax, &kmax, &num_threads))
+        return nullptr;
+      if (kmax<0)
+        kmax = 2*lmax;
+      if (lmax<0)
+        {
+          PyErr_Format(PyExc_ValueError, "%s: negative lmax", function_name);
+          return nullptr;
+        }
+
+      const std::size_t num_l = lmax+1, num_k = kmax+1;
+      const std::size_t num_s = lj_coupled ? 2 : 1;
+      std::vector<double> values;
+      const bool success = RunWithoutGIL(function_name, [&] {
+          values.resize(num_l*num_s*num_l*num_s*num_k);
+          // entries as in SphericalHarmonicRMETable
+          am::ParallelFor(0, lmax+1, [&](std::ptrdiff_t lp_index) {
+              const int lp = int(lp_index);
+              double* value = values.data()+lp_index*num_s*num_l*num_s*num_k;
+              for (int sp=0; sp<int(num_s); ++sp)
+                for (int l=0; l<=lmax; ++l)
+                  for (int s=0; s<int(num_s); ++s)
+                    for (int k=0; k<=kmax; ++k)
+                      {
+                        if (lj_coupled)
+                          {
+                            const HalfInt jp = lp+HalfInt(2*sp-1,2), j = l+HalfInt(2*s-1,2);
+                            *value++ = ((jp>=0) && (j>=0))
+                              ? am::detail::LJCoupledSphericalHarmonicCRMEDirect(lp, jp, l, j, k)
+                              : 0.;
+                          }
+                        else
+                          *value++ = am::AllowedTriangle(lp, k, l)
+                            ? am::detail::SphericalHarmonicCRMEDirect(lp, l, k)
+                            : 0.;
+                      }
+            }, num_threads);
+        });
+      if (!success)
+        return nullptr;
+      std::vector<npy_intp> shape;
+      if (lj_coupled)
+        shape = {npy_intp(num_l), 2, npy_intp(num_l), 2, npy_intp(num_k)};
+      else
+        shape = {npy_intp(num_l), npy_intp(num_l), npy_intp(num_k)};
+      return ArrayFromVector(std::move(values), shape, NPY_FLOAT64);
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Racah reduction factor blocks
+    ////////////////////////////////////////////////////////////////
+
+    inline
+    bool AllowedTriangleTwice(int two_ja, int two_jb, int two_jc)
+    {
+      return (two_jc>=std::abs(two_ja-two_jb)) && (two_jc<=two_ja+two_jb) && ((two_ja+two_jb+two_jc)%2==0);
+    }
+
+    // selection rules, on twice-values (J1p,J2p,Jp,J1,J2,J,J0...), for which
+    // reduction factor functions would throw (under AM_EXCEPTIONS)
+    inline bool Allowed1(const int* t) {return (t[1]==t[4]) && AllowedTriangleTwice(t[2],t[5],t[6]);}
+    inline bool Allowed2(const int* t) {return (t[0]==t[3]) && AllowedTriangleTwice(t[2],t[5],t[6]);}
+    inline bool Allowed12Dot(const int* t) {return t[2]==t[5];}
+    inline bool Allowed12(const int* t) {return AllowedTriangleTwice(t[2],t[5],t[8]);}
+
+    struct RacahBlockFunction
+    {
+      const char* name;
+      int num_operator_args;
+      VectorizedKernel kernel;
+      bool (*allowed)(const int* two_values);
+      const char* operator_arguments;
+    };
+
+    inline constexpr RacahBlockFunction kRacahBlockFunctions[] = {
+      {"RacahReductionFactor1RoseMatrix", 1, Kernel<&am::RacahReductionFactor1Rose>, Allowed1, "J0"},
+      {"RacahReductionFactor2RoseMatrix", 1, Kernel<&am::RacahReductionFactor2Rose>, Allowed2, "J0"},
+      {"RacahReductionFactor12DotRoseMatrix", 1, Kernel<&am::RacahReductionFactor12DotRose>, Allowed12Dot, "J0"},
+      {"RacahReductionFactor12RoseMatrix", 3, Kernel<&am::RacahReductionFactor12Rose>, Allowed12, "J0a, J0b, J0"},
+      {"RacahReductionFactor21RoseMatrix", 3, Kernel<&am::RacahReductionFactor21Rose>, Allowed12, "J0a, J0b, J0"},
+    };
+
+    constexpr std::size_t kNumRacahBlockFunctions = sizeof(kRacahBlockFunctions)/sizeof(kRacahBlockFunctions[0]);
+
+    inline
+    PyArrayObject* StatesArgument(PyObject* object, const char* function_name, int position)
+    // Convert two-system states argument to (n,3) int32 array of twice-values.
+    //
+    // Returns:
+    //   (PyArrayObject*): new reference, or nullptr with Python exception set
+    {
+      PyArrayObject* states = TwiceValueArgument(object, ArgumentMode::kHalfInt, function_name, position);
+      if (states && ((PyArray_NDIM(states)!=2) || (PyArray_DIM(states,1)!=3)))
+        {
+          PyErr_Format(
+              PyExc_ValueError, "%s: argument %d must have shape (n,3), with rows (J1,J2,J)",
+              function_name, position+1
+            );
+          Py_CLEAR(states);
+        }
+      return states;
+    }
+
+    template<std::size_t index>
+    PyObject* RacahBlockWrapper(PyObject*, PyObject* args, PyObject* kwargs)
+    // Python entry point for Racah reduction factor block.
+    {
+      const RacahBlockFunction& function = kRacahBlockFunctions[index];
+      const Py_ssize_t num_args = 2+function.num_operator_args;
+      if (PyTuple_GET_SIZE(args)!=num_args)
+        {
+          PyErr_Format(
+              PyExc_TypeError, "%s() takes %zd positional arguments but %zd were given",
+              function.name, num_args, PyTuple_GET_SIZE(args)
+            );
+          return nullptr;
+        }
+      int num_threads;
+      if (!ParseNumThreads(kwargs, function.name, num_threads))
+        return nullptr;
+      int two_operator[3];
+      for (int i=0; i<function.num_operator_args; ++i)
+        if (!NonnegativeHalfInt(PyTuple_GET_ITEM(args, 2+i), function.name, "operator angular momentum", two_operator[i]))
+          return nullptr;
+      PyArrayObject* bra_states = StatesArgument(PyTuple_GET_ITEM(args, 0), function.name, 0);
+      if (!bra_states)
+        return nullptr;
+      PyArrayObject* ket_states = StatesArgument(PyTuple_GET_ITEM(args, 1), function.name, 1);
+      if (!ket_states)
+        {
+          Py_DECREF(bra_states);
+          return nullptr;
+        }
+
+      const std::ptrdiff_t num_bra = PyArray_DIM(bra_states, 0), num_ket = PyArray_DIM(ket_states, 0);
+      const std::int32_t* bra = static_cast<const std::int32_t*>(PyArray_DATA(bra_states));
+      const std::int32_t* ket = static_cast<const std::int32_t*>(PyArray_DATA(ket_states));
+      std::vector<double> values;
+      const bool success = RunWithoutGIL(function.name, [&] {
+          values.assign(std::size_t(num_bra)*num_ket, 0.);
+          am::ParallelFor(0, num_bra, [&](std::ptrdiff_t b) {
+              int two_values[9];
+              for (int i=0; i<function.num_operator_args; ++i)
+                two_values[6+i] = two_operator[i];
+              std::copy_n(bra+3*b, 3, two_values);
+              for (std::ptrdiff_t k=0; k<num_ket; ++k)
+                {
+                  std::copy_n(ket+3*k, 3, two_values+3);
+                  if (function.allowed(two_values))
+                    values[b*num_ket+k] = function.kernel(two_values);
+                }
+            }, num_threads);
+        });
+      Py_DECREF(bra_states);
+      Py_DECREF(ket_states);
+      if (!success)
+        return nullptr;
+      return ArrayFromVector(std::move(values), {npy_intp(num_bra), npy_intp(num_ket)}, NPY_FLOAT64);
+    }
+
+    template<std::size_t... index>
+    void AppendRacahBlockMethods(std::vector<PyMethodDef>& methods, std::deque<std::string>& strings, std::index_sequence<index...>)
+    {
+      const PyCFunctionWithKeywords wrappers[] = {RacahBlockWrapper<index>...};
+      for (std::size_t i=0; i<sizeof...(index); ++i)
+        {
+          const RacahBlockFunction& function = kRacahBlockFunctions[i];
+          const std::string& doc = strings.emplace_back(
+              std::string(function.name)+"(bra_states, ket_states, "+function.operator_arguments+", num_threads=0)\n\n"
+              +"Matrix of reduction factors between two-system states, given as arrays of rows (J1,J2,J)."
+            );
+          methods.push_back({
+              function.name, reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(wrappers[i])),
+              METH_VARARGS|METH_KEYWORDS, doc.c_str()
+            });
+        }
+    }
+
+    template<typename F>
+    constexpr PyCFunction AsPyCFunction(F function)
+    {
+      return reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(function));
+    }
+
+  }  // namespace builders
+
+  inline
+  int AddBuilderFunctions(PyObject* module, PyObject* public_interface)
+  // Register table builder functions in module.
+  //
+  // Must be called after import_array().
+  //
+  // Returns:
+  //   (int): 0 on success, or -1 with Python exception set
+  {
+    using builders::AsPyCFunction;
+
+    // method definitions must outlive module
+    static std::deque<std::string> strings;
+    static std::vector<PyMethodDef> methods;
+    if (methods.empty())
+      {
+        methods.push_back({
+            "ClebschGordanMatrix", AsPyCFunction(builders::ClebschGordanMatrix), METH_VARARGS|METH_KEYWORDS,
+            "ClebschGordanMatrix(j1, j2, num_threads=0)\n\n"
+            "Clebsch-Gordan coupling matrix <j1 m1 j2 m2|J M>, with rows (m1,m2) and columns (J,M), in ascending order."
+          });
+        methods.push_back({
+            "WignerSmallDArray", AsPyCFunction(builders::WignerSmallDArray), METH_VARARGS|METH_KEYWORDS,
+            "WignerSmallDArray(j, betas, num_threads=0)\n\n"
+            "Wigner small-d matrices d^j(beta) for array of angles, with shape betas.shape+(2j+1,2j+1), indexed by (...,j+m',j+m)."
+          });
+        methods.push_back({
+            "SphericalHarmonicCRMEArray", AsPyCFunction(builders::SphericalHarmonicCRMEArray<false>), METH_VARARGS|METH_KEYWORDS,
+            "SphericalHarmonicCRMEArray(lmax, kmax=2*lmax, num_threads=0)\n\n"
+            "SphericalHarmonicCRME(lp,l,k), with shape (lmax+1,lmax+1,kmax+1)."
+          });
+        methods.push_back({
+            "LJCoupledSphericalHarmonicCRMEArray", AsPyCFunction(builders::SphericalHarmonicCRMEArray<true>), METH_VARARGS|METH_KEYWORDS,
+            "LJCoupledSphericalHarmonicCRMEArray(lmax, kmax=2*lmax, num_threads=0)\n\n"
+            "LJCoupledSphericalHarmonicCRME(lp,jp,l,j,k), with shape (lmax+1,2,lmax+1,2,kmax+1), indexed by (lp,jp-lp+1/2,l,j-l+1/2,k)."
+          });
+        builders::AppendRacahBlockMethods(methods, strings, std::make_index_sequence<builders::kNumRacahBlockFunctions>());
+        methods.push_back({nullptr, nullptr, 0, nullptr});
+      }
+    if (PyModule_AddFunctions(module, methods.data())<0)
+      return -1;
+    for (const PyMethodDef& method : methods)
+      if (method.ml_name)
+        {
+          PyObject* name = PyUnicode_FromString(method.ml_name);
+          if (!name)
+            return -1;
+          PyList_Append(public_interface, name);
+          Py_DECREF(name);
+        }
+    return 0;
+  }
+
+}  // namespace am_python
+
+#endif  // AM_PYTHON_AM_BUILDERS_H_
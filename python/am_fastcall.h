@@ -0,0 +1,212 @@
+/****************************************************************
+  am_fastcall.h
+
+  Low-overhead call path for scalar angular momentum coefficients in the am
+  Python module.
+
+  The SWIG wrappers for the scalar coefficient functions (Wigner3J,
+  Wigner6J, ..., RacahReductionFactor21Rose, i.e., those with vectorized
+  counterparts in am_numpy.h) are replaced at module initialization by
+  METH_FASTCALL functions of the same name.  These accept each j argument
+  directly as a HalfInt, an int, or a float with half-integer value, without
+  the tuple unpacking, implicit HalfInt conversion, and temporary HalfInt
+  objects of the SWIG wrapper:
+
+    >>> am.Wigner6J(1, 1, 1, 1, 1, 1)
+    >>> am.ClebschGordan(0.5, 0.5, 0.5, -0.5, 1, 0)
+
+  Calls with any other arguments are passed on to the original SWIG
+  wrapper, so behavior (including error messages) is otherwise unchanged.
+  The original wrappers remain available, for comparison, in the dictionary
+  _am._swig_functions.  (Note that only the fast-call path consults the
+  Wigner6J and Wigner9J symbol caches; see am_symbol_cache.h.)
+
+  This file is included by the SWIG interface file am.i, after am_numpy.h,
+  and is not intended for use from C++.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Note use of symbol caches.
+
+****************************************************************/
+
+#ifndef AM_PYTHON_AM_FASTCALL_H_
+#define AM_PYTHON_AM_FASTCALL_H_
+
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "python/am_numpy.h"
+
+namespace am_python {
+
+  namespace fastcall {
+
+    typedef PyObject* (*FastFunction)(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
+
+    // HalfInt Python type
+    inline PyTypeObject* halfint_type = nullptr;
+
+    // original SWIG wrappers, by index in kVectorizedFunctions
+    inline PyObject* swig_functions[kNumVectorizedFunctions] = {};
+
+    enum class Conversion {kSuccess, kError, kFallback};
+
+    inline
+    Conversion TwiceValue(PyObject* object, int& two_value)
+    // Extract twice-value from HalfInt, int, or float argument.
+    //
+    // Returns:
+    //   (Conversion): kSuccess, kError (with Python exception set), or
+    //     kFallback (argument of other type, or out of range, to be
+    //     handled by SWIG wrapper)
+    {
+      if (PyLong_CheckExact(object))
+        {
+          int overflow;
+          const long value = PyLong_AsLongAndOverflow(object, &overflow);
+          if (overflow || (value>std::numeric_limits<int>::max()/2) || (value<std::numeric_limits<int>::min()/2))
+            return Conversion::kFallback;
+          two_value = int(2*value);
+          return Conversion::kSuccess;
+        }
+      if (PyFloat_CheckExact(object))
+        {
+          const double value = 2*PyFloat_AS_DOUBLE(object);
+          if (!(std::abs(value)<=double(std::numeric_limits<int>::max())) || (value!=std::floor(value)))
+            {
+              PyErr_Format(PyExc_ValueError, "value %R is not a half-integer", object);
+              return Conversion::kError;
+            }
+          two_value = int(value);
+          return Conversion::kSuccess;
+        }
+      if (halfint_type && PyObject_TypeCheck(object, halfint_type))
+        return HalfIntFromPyObject(object, two_value) ? Conversion::kSuccess : Conversion::kError;
+      return Conversion::kFallback;
+    }
+
+    template<std::size_t index>
+    PyObject* FastWrapper(PyObject*, PyObject* const* args, Py_ssize_t nargs)
+    // Python entry point for scalar function.
+    {
+      const VectorizedFunction& function = kVectorizedFunctions[index];
+      if (nargs!=function.num_args)
+        return PyObject_Vectorcall(swig_functions[index], args, nargs, nullptr);
+
+      int two_values[kMaxVectorizedArguments];
+      for (Py_ssize_t arg=0; arg<nargs; ++arg)
+        {
+          const Conversion status = TwiceValue(args[arg], two_values[arg]);
+          if (status==Conversion::kError)
+            return nullptr;
+          if (status==Conversion::kFallback)
+            return PyObject_Vectorcall(swig_functions[index], args, nargs, nullptr);
+        }
+
+      // exception mapping follows default exception handler in am.i
+      double value;
+      try
+        {
+          value = function.kernel(two_values);
+        }
+      catch (const std::invalid_argument& e)
+        {
+          PyErr_SetString(PyExc_ValueError, e.what());
+          return nullptr;
+        }
+      catch (const std::domain_error& e)
+        {
+          PyErr_SetString(PyExc_ValueError, e.what());
+          return nullptr;
+        }
+      catch (const std::exception& e)
+        {
+          PyErr_SetString(PyExc_RuntimeError, e.what());
+          return nullptr;
+        }
+      return PyFloat_FromDouble(value);
+    }
+
+    template<std::size_t... index>
+    int InstallFunctions(PyObject* module, PyObject* swig_functions_dict, std::index_sequence<index...>)
+    {
+      const FastFunction wrappers[] = {FastWrapper<index>...};
+
+      // method definitions must outlive module
+      static PyMethodDef methods[sizeof...(index)];
+      static std::deque<std::string> docs;
+
+      PyObject* module_name = PyModule_GetNameObject(module);
+      if (!module_name)
+        return -1;
+      int status = 0;
+      for (std::size_t i=0; (i<sizeof...(index)) && (status==0); ++i)
+        {
+          const char* name = kVectorizedFunctions[i].name;
+          PyObject* original = PyObject_GetAttrString(module, name);
+          if (!original || (PyDict_SetItemString(swig_functions_dict, name, original)<0))
+            {
+              Py_XDECREF(original);
+              status = -1;
+              break;
+            }
+          Py_XSETREF(swig_functions[i], original);
+
+          // carry over SWIG docstring
+          PyObject* doc = PyObject_GetAttrString(original, "__doc__");
+          const char* doc_text = (doc && PyUnicode_Check(doc)) ? PyUnicode_AsUTF8(doc) : nullptr;
+          const std::string& doc_string = docs.emplace_back(doc_text ? doc_text : "");
+          Py_XDECREF(doc);
+          PyErr_Clear();
+
+          methods[i] = {
+            name, reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(wrappers[i])),
+            METH_FASTCALL, doc_string.c_str()
+          };
+          PyObject* function = PyCFunction_NewEx(&methods[i], nullptr, module_name);
+          if (!function || (PyObject_SetAttrString(module, name, function)<0))
+            status = -1;
+          Py_XDECREF(function);
+        }
+      Py_DECREF(module_name);
+      return status;
+    }
+
+  }  // namespace fastcall
+
+  inline
+  int InstallFastCallFunctions(PyObject* module, PyTypeObject* halfint_type)
+  // Replace SWIG wrappers of scalar functions in module with fast-call
+  // wrappers.
+  //
+  // The replaced SWIG wrappers are saved in module attribute _swig_functions.
+  //
+  // Returns:
+  //   (int): 0 on success, or -1 with Python exception set
+  {
+    fastcall::halfint_type = halfint_type;
+    PyObject* swig_functions_dict = PyDict_New();
+    if (!swig_functions_dict)
+      return -1;
+    int status = fastcall::InstallFunctions(
+        module, swig_functions_dict, std::make_index_sequence<kNumVectorizedFunctions>()
+      );
+    if (status==0)
+      status = PyObject_SetAttrString(module, "_swig_functions", swig_functions_dict);
+    Py_DECREF(swig_functions_dict);
+    return status;
+  }
+
+}  // namespace am_python
+
+#endif  // AM_PYTHON_AM_FASTCALL_H_
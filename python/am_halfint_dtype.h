@@ -0,0 +1,483 @@
+/****************************************************************
+  am_halfint_dtype.h
+
+  NumPy dtype for HalfInt, for the am Python module.
+
+  Array elements are stored as the int32 twice-value 2j (the same layout as
+  the C++ HalfInt), and are read and written from Python as HalfInt
+  objects:
+
+    >>> a = numpy.array([am.HalfInt(1,2), 1, 1.5], dtype=am.HalfIntDType)
+    >>> a = numpy.arange(0,10,dtype=numpy.int32).view(am.HalfIntDType)  # from 2j
+
+  Conversions to the HalfInt dtype from integer dtypes (j=n) are safe casts,
+  so integers mix freely with HalfInt arrays.  Conversion from float64 (by
+  astype) sets the floating point "invalid" flag for values which are not
+  half-integers.  Conversion to float64 (j) is a safe cast.
+
+  The following NumPy ufuncs are given loops for the HalfInt dtype:
+
+    add, subtract (HalfInt, HalfInt)
+    multiply (HalfInt, int64), (int64, HalfInt)
+    negative, positive, absolute, maximum, minimum
+    equal, not_equal, less, less_equal, greater, greater_equal
+
+  and the module provides the ufuncs (for arguments of HalfInt dtype):
+
+    IsIntegerArray(j) -> bool
+    TwiceValueArray(j) -> int32
+    HatArray(j) -> float64
+    ParitySignArray(j) -> int32
+
+  ParitySignArray sets the floating point "invalid" flag (and returns 0) for
+  half-integer arguments, as NumPy does for integer division by zero.
+
+  Elementwise loops and casts do not require the GIL.
+
+  Conversion of Python objects to and from HalfInt (HalfIntFromPyObject,
+  HalfIntToPyObject) depends on the SWIG runtime, and is therefore provided
+  by the SWIG interface file am.i.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+
+****************************************************************/
+
+#ifndef AM_PYTHON_AM_HALFINT_DTYPE_H_
+#define AM_PYTHON_AM_HALFINT_DTYPE_H_
+
+#include <algorithm>
+#include <cfenv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+
+#include "am/factor_table.h"
+
+namespace am_python {
+
+  // type number of registered HalfInt dtype (NPY_NOTYPE before registration)
+  inline int halfint_type_num = NPY_NOTYPE;
+
+  // conversion between Python objects and HalfInt twice-values (defined in
+  // am.i); return false or nullptr with Python exception set on failure
+  bool HalfIntFromPyObject(PyObject* object, int& two_value);
+  PyObject* HalfIntToPyObject(int two_value);
+
+  namespace halfint_dtype {
+
+    ////////////////////////////////////////////////////////////////
+    // array functions
+    ////////////////////////////////////////////////////////////////
+
+    inline
+    std::int32_t Load(const void* data)
+    {
+      std::int32_t two_value;
+      std::memcpy(&two_value, data, sizeof(two_value));
+      return two_value;
+    }
+
+    inline
+    void Store(void* data, std::int32_t two_value)
+    {
+      std::memcpy(data, &two_value, sizeof(two_value));
+    }
+
+    inline
+    std::int32_t ByteSwap(std::int32_t two_value)
+    {
+      const std::uint32_t bits = static_cast<std::uint32_t>(two_value);
+      return static_cast<std::int32_t>(
+          (bits>>24) | ((bits>>8)&0xff00u) | ((bits<<8)&0xff0000u) | (bits<<24)
+        );
+    }
+
+    inline
+    void RaiseInvalid()
+    // Set floating point "invalid" flag, which NumPy reports after loops and
+    // casts according to numpy.errstate (equivalent to
+    // npy_set_floatstatus_invalid, without linking npymath).
+    {
+      std::feraiseexcept(FE_INVALID);
+    }
+
+    inline
+    PyObject* GetItem(void* data, void*)
+    {
+      return HalfIntToPyObject(Load(data));
+    }
+
+    inline
+    int SetItem(PyObject* item, void* data, void*)
+    {
+      int two_value;
+      if (!HalfIntFromPyObject(item, two_value))
+        return -1;
+      Store(data, two_value);
+      return 0;
+    }
+
+    inline
+    void CopySwapN(void* destination, npy_intp destination_stride, void* source, npy_intp source_stride, npy_intp n, int swap, void*)
+    {
+      if (!source)
+        return;
+      char* d = static_cast<char*>(destination);
+      const char* s = static_cast<const char*>(source);
+      for (npy_intp i=0; i<n; ++i, d+=destination_stride, s+=source_stride)
+        Store(d, swap ? ByteSwap(Load(s)) : Load(s));
+    }
+
+    inline
+    void CopySwap(void* destination, void* source, int swap, void*)
+    {
+      if (!source)
+        return;
+      Store(destination, swap ? ByteSwap(Load(source)) : Load(source));
+    }
+
+    inline
+    int Compare(const void* a, const void* b, void*)
+    {
+      const std::int32_t x = Load(a), y = Load(b);
+      return (x>y)-(x<y);
+    }
+
+    inline
+    npy_bool NonZero(void* data, void*)
+    {
+      return Load(data)!=0;
+    }
+
+    inline
+    int ArgMax(void* data, npy_intp n, npy_intp* index, void*)
+    {
+      const std::int32_t* values = static_cast<const std::int32_t*>(data);
+      *index = 0;
+      for (npy_intp i=1; i<n; ++i)
+        if (values[i]>values[*index])
+          *index = i;
+      return 0;
+    }
+
+    inline
+    int ArgMin(void* data, npy_intp n, npy_intp* index, void*)
+    {
+      const std::int32_t* values = static_cast<const std::int32_t*>(data);
+      *index = 0;
+      for (npy_intp i=1; i<n; ++i)
+        if (values[i]<values[*index])
+          *index = i;
+      return 0;
+    }
+
+    inline
+    int Fill(void* data, npy_intp length, void*)
+    // Fill arithmetic progression from first two entries (for arange).
+    {
+      std::int32_t* values = static_cast<std::int32_t*>(data);
+      const std::int32_t delta = values[1]-values[0];
+      for (npy_intp i=2; i<length; ++i)
+        values[i] = values[0]+std::int32_t(i)*delta;
+      return 0;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // casts
+    ////////////////////////////////////////////////////////////////
+
+    template<typename T>
+    void FromInteger(void* from, void* to, npy_intp n, void*, void*)
+    {
+      const T* source = static_cast<const T*>(from);
+      std::int32_t* destination = static_cast<std::int32_t*>(to);
+      for (npy_intp i=0; i<n; ++i)
+        destination[i] = std::int32_t(2*source[i]);
+    }
+
+    inline
+    void FromFloat64(void* from, void* to, npy_intp n, void*, void*)
+    {
+      const double* source = static_cast<const double*>(from);
+      std::int32_t* destination = static_cast<std::int32_t*>(to);
+      for (npy_intp i=0; i<n; ++i)
+        {
+          const double two_value = 2*source[i];
+          if (
+              (std::abs(two_value)<=double(std::numeric_limits<std::int32_t>::max()))
+              && (two_value==std::floor(two_value))
+            )
+            destination[i] = std::int32_t(two_value);
+          else
+            {
+              RaiseInvalid();
+              destination[i] = 0;
+            }
+        }
+    }
+
+    inline
+    void ToFloat64(void* from, void* to, npy_intp n, void*, void*)
+    {
+      const std::int32_t* source = static_cast<const std::int32_t*>(from);
+      double* destination = static_cast<double*>(to);
+      for (npy_intp i=0; i<n; ++i)
+        destination[i] = source[i]/2.;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // ufunc loops
+    ////////////////////////////////////////////////////////////////
+
+    template<typename A, typename R, R (*operation)(A)>
+    void UnaryLoop(char** args, npy_intp const* dimensions, npy_intp const* steps, void*)
+    {
+      char* a = args[0];
+      char* r = args[1];
+      for (npy_intp i=0; i<dimensions[0]; ++i, a+=steps[0], r+=steps[1])
+        *reinterpret_cast<R*>(r) = operation(*reinterpret_cast<const A*>(a));
+    }
+
+    template<typename A, typename B, typename R, R (*operation)(A,B)>
+    void BinaryLoop(char** args, npy_intp const* dimensions, npy_intp const* steps, void*)
+    {
+      char* a = args[0];
+      char* b = args[1];
+      char* r = args[2];
+      for (npy_intp i=0; i<dimensions[0]; ++i, a+=steps[0], b+=steps[1], r+=steps[2])
+        *reinterpret_cast<R*>(r) = operation(*reinterpret_cast<const A*>(a), *reinterpret_cast<const B*>(b));
+    }
+
+    // operations on twice-values
+    inline std::int32_t Add(std::int32_t a, std::int32_t b) {return a+b;}
+    inline std::int32_t Subtract(std::int32_t a, std::int32_t b) {return a-b;}
+    inline std::int32_t MultiplyRight(std::int32_t a, npy_int64 n) {return std::int32_t(a*n);}
+    inline std::int32_t MultiplyLeft(npy_int64 n, std::int32_t a) {return std::int32_t(n*a);}
+    inline std::int32_t Maximum(std::int32_t a, std::int32_t b) {return (a>b) ? a : b;}
+    inline std::int32_t Minimum(std::int32_t a, std::int32_t b) {return (a<b) ? a : b;}
+    inline std::int32_t Negative(std::int32_t a) {return -a;}
+    inline std::int32_t Positive(std::int32_t a) {return a;}
+    inline std::int32_t Absolute(std::int32_t a) {return std::abs(a);}
+    inline npy_bool Equal(std::int32_t a, std::int32_t b) {return a==b;}
+    inline npy_bool NotEqual(std::int32_t a, std::int32_t b) {return a!=b;}
+    inline npy_bool Less(std::int32_t a, std::int32_t b) {return a<b;}
+    inline npy_bool LessEqual(std::int32_t a, std::int32_t b) {return a<=b;}
+    inline npy_bool Greater(std::int32_t a, std::int32_t b) {return a>b;}
+    inline npy_bool GreaterEqual(std::int32_t a, std::int32_t b) {return a>=b;}
+    inline npy_bool IsInteger(std::int32_t a) {return (a&1)==0;}
+    inline std::int32_t TwiceValue(std::int32_t a) {return a;}
+    inline double Hat(std::int32_t a) {return am::TabulatedHat2(a);}
+
+    inline
+    std::int32_t ParitySign(std::int32_t a)
+    {
+      if (a&1)
+        {
+          RaiseInvalid();
+          return 0;
+        }
+      return 1-(a&2);
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // registration
+    ////////////////////////////////////////////////////////////////
+
+    inline
+    int RegisterLoop(PyObject* numpy, const char* name, PyUFuncGenericFunction loop, std::initializer_list<int> types)
+    // Register loop for existing NumPy ufunc.
+    {
+      PyObject* ufunc = PyObject_GetAttrString(numpy, name);
+      if (!ufunc)
+        return -1;
+      int arg_types[3];
+      std::copy(types.begin(), types.end(), arg_types);
+      const int status = PyUFunc_RegisterLoopForType(
+          reinterpret_cast<PyUFuncObject*>(ufunc), halfint_type_num, loop, arg_types, nullptr
+        );
+      Py_DECREF(ufunc);
+      return status;
+    }
+
+    inline
+    int AddUFunc(PyObject* module, PyObject* public_interface, const char* name, const char* doc, PyUFuncGenericFunction loop, int output_type)
+    // Create unary ufunc with single HalfInt loop, and add to module.
+    {
+      PyObject* ufunc = PyUFunc_FromFuncAndData(
+          nullptr, nullptr, nullptr, 0, 1, 1, PyUFunc_None, name, doc, 0
+        );
+      if (!ufunc)
+        return -1;
+      int arg_types[2] = {halfint_type_num, output_type};
+      if (PyUFunc_RegisterLoopForType(reinterpret_cast<PyUFuncObject*>(ufunc), halfint_type_num, loop, arg_types, nullptr)<0)
+        {
+          Py_DECREF(ufunc);
+          return -1;
+        }
+      if (PyModule_AddObject(module, name, ufunc)<0)
+        {
+          Py_DECREF(ufunc);
+          return -1;
+        }
+      PyObject* symbol = PyUnicode_FromString(name);
+      if (!symbol)
+        return -1;
+      const int status = PyList_Append(public_interface, symbol);
+      Py_DECREF(symbol);
+      return status;
+    }
+
+  }  // namespace halfint_dtype
+
+  inline
+  int RegisterHalfIntDType(PyObject* module, PyObject* public_interface, PyTypeObject* halfint_type)
+  // Register HalfInt dtype, casts, and ufunc loops, and add dtype to module
+  // as HalfIntDType.
+  //
+  // Must be called after import_array() and import_umath().
+  //
+  // Arguments:
+  //   module (input): am module
+  //   public_interface (input): list of public symbols (__all__)
+  //   halfint_type (input): Python type of HalfInt objects, used as dtype
+  //     scalar type
+  //
+  // Returns:
+  //   (int): 0 on success, or -1 with Python exception set
+  {
+    using namespace halfint_dtype;
+
+    // descriptor (prototype must outlive registration)
+    static PyArray_ArrFuncs functions;
+    PyArray_InitArrFuncs(&functions);
+    functions.getitem = GetItem;
+    functions.setitem = SetItem;
+    functions.copyswapn = CopySwapN;
+    functions.copyswap = CopySwap;
+    functions.compare = Compare;
+    functions.nonzero = NonZero;
+    functions.argmax = ArgMax;
+    functions.argmin = ArgMin;
+    functions.fill = Fill;
+    static PyArray_DescrProto prototype;
+    std::memset(&prototype, 0, sizeof(prototype));
+    Py_SET_TYPE(&prototype, &PyArrayDescr_Type);
+    Py_SET_REFCNT(&prototype, 1);
+    prototype.typeobj = halfint_type;
+    prototype.kind = 'V';
+    prototype.type = 'j';
+    prototype.byteorder = '=';
+    // scalars are HalfInt objects, constructed by getitem (not by copying
+    // element into a NumPy scalar)
+    prototype.flags = NPY_USE_GETITEM|NPY_USE_SETITEM;
+    prototype.elsize = sizeof(std::int32_t);
+    prototype.alignment = alignof(std::int32_t);
+    prototype.f = &functions;
+    prototype.hash = -1;
+    halfint_type_num = PyArray_RegisterDataType(&prototype);
+    if (halfint_type_num<0)
+      return -1;
+    PyArray_Descr* descriptor = PyArray_DescrFromType(halfint_type_num);
+    if (!descriptor)
+      return -1;
+
+    // casts
+    int status = 0;
+    const std::pair<int,PyArray_VectorUnaryFunc*> integer_casts[] = {
+      {NPY_BOOL, FromInteger<npy_bool>},
+      {NPY_INT8, FromInteger<npy_int8>}, {NPY_UINT8, FromInteger<npy_uint8>},
+      {NPY_INT16, FromInteger<npy_int16>}, {NPY_UINT16, FromInteger<npy_uint16>},
+      {NPY_INT32, FromInteger<npy_int32>}, {NPY_INT64, FromInteger<npy_int64>},
+    };
+    for (const auto& [type_num, cast] : integer_casts)
+      {
+        PyArray_Descr* from = PyArray_DescrFromType(type_num);
+        status |= PyArray_RegisterCastFunc(from, halfint_type_num, cast);
+        status |= PyArray_RegisterCanCast(from, halfint_type_num, NPY_NOSCALAR);
+        Py_DECREF(from);
+      }
+    PyArray_Descr* float64 = PyArray_DescrFromType(NPY_FLOAT64);
+    status |= PyArray_RegisterCastFunc(float64, halfint_type_num, FromFloat64);
+    Py_DECREF(float64);
+    status |= PyArray_RegisterCastFunc(descriptor, NPY_FLOAT64, ToFloat64);
+    status |= PyArray_RegisterCanCast(descriptor, NPY_FLOAT64, NPY_NOSCALAR);
+    if (status<0)
+      {
+        Py_DECREF(descriptor);
+        return -1;
+      }
+
+    // loops for NumPy ufuncs
+    PyObject* numpy = PyImport_ImportModule("numpy");
+    if (!numpy)
+      {
+        Py_DECREF(descriptor);
+        return -1;
+      }
+    typedef std::int32_t T;
+    const int H = halfint_type_num;
+    status |= RegisterLoop(numpy, "add", BinaryLoop<T,T,T,Add>, {H,H,H});
+    status |= RegisterLoop(numpy, "subtract", BinaryLoop<T,T,T,Subtract>, {H,H,H});
+    status |= RegisterLoop(numpy, "multiply", BinaryLoop<T,npy_int64,T,MultiplyRight>, {H,NPY_INT64,H});
+    status |= RegisterLoop(numpy, "multiply", BinaryLoop<npy_int64,T,T,MultiplyLeft>, {NPY_INT64,H,H});
+    status |= RegisterLoop(numpy, "maximum", BinaryLoop<T,T,T,Maximum>, {H,H,H});
+    status |= RegisterLoop(numpy, "minimum", BinaryLoop<T,T,T,Minimum>, {H,H,H});
+    status |= RegisterLoop(numpy, "negative", UnaryLoop<T,T,Negative>, {H,H});
+    status |= RegisterLoop(numpy, "positive", UnaryLoop<T,T,Positive>, {H,H});
+    status |= RegisterLoop(numpy, "absolute", UnaryLoop<T,T,Absolute>, {H,H});
+    status |= RegisterLoop(numpy, "equal", BinaryLoop<T,T,npy_bool,Equal>, {H,H,NPY_BOOL});
+    status |= RegisterLoop(numpy, "not_equal", BinaryLoop<T,T,npy_bool,NotEqual>, {H,H,NPY_BOOL});
+    status |= RegisterLoop(numpy, "less", BinaryLoop<T,T,npy_bool,Less>, {H,H,NPY_BOOL});
+    status |= RegisterLoop(numpy, "less_equal", BinaryLoop<T,T,npy_bool,LessEqual>, {H,H,NPY_BOOL});
+    status |= RegisterLoop(numpy, "greater", BinaryLoop<T,T,npy_bool,Greater>, {H,H,NPY_BOOL});
+    status |= RegisterLoop(numpy, "greater_equal", BinaryLoop<T,T,npy_bool,GreaterEqual>, {H,H,NPY_BOOL});
+    Py_DECREF(numpy);
+
+    // am ufuncs
+    status |= AddUFunc(
+        module, public_interface, "IsIntegerArray", "IsIntegerArray(j)\n\nTest whether HalfInt values are integers.",
+        UnaryLoop<T,npy_bool,IsInteger>, NPY_BOOL
+      );
+    status |= AddUFunc(
+        module, public_interface, "TwiceValueArray", "TwiceValueArray(j)\n\nTwice-values 2j of HalfInt values, as int32.",
+        UnaryLoop<T,npy_int32,TwiceValue>, NPY_INT32
+      );
+    status |= AddUFunc(
+        module, public_interface, "HatArray", "HatArray(j)\n\nHat symbol sqrt(2j+1) of HalfInt values.",
+        UnaryLoop<T,double,Hat>, NPY_FLOAT64
+      );
+    status |= AddUFunc(
+        module, public_interface, "ParitySignArray", "ParitySignArray(j)\n\nPhase sign (-)^j of integer HalfInt values, as int32.",
+        UnaryLoop<T,npy_int32,ParitySign>, NPY_INT32
+      );
+    if (status<0)
+      {
+        Py_DECREF(descriptor);
+        return -1;
+      }
+
+    // expose dtype
+    if (PyModule_AddObject(module, "HalfIntDType", reinterpret_cast<PyObject*>(descriptor))<0)
+      {
+        Py_DECREF(descriptor);
+        return -1;
+      }
+    PyObject* symbol = PyUnicode_FromString("HalfIntDType");
+    if (!symbol)
+      return -1;
+    status = PyList_Append(public_interface, symbol);
+    Py_DECREF(symbol);
+    return status;
+  }
+
+}  // namespace am_python
+
+#endif  // AM_PYTHON_AM_HALFINT_DTYPE_H_
@@ -0,0 +1,521 @@
+/****************************************************************
+  am_numpy.h
+
+  NumPy extensions to the am Python module.
+
+  Vectorized angular momentum coefficients:
+
+    Wigner3JArray(ja, jb, jc, ma, mb, mc, num_threads=0)
+    Wigner3J2Array(two_ja, two_jb, two_jc, two_ma, two_mb, two_mc, num_threads=0)
+    ...
+
+  The functions named <Name>Array take angular momentum values j (as float
+  or integer arrays, or sequences of HalfInt), which must be integers or
+  half-integers.  The functions named <Name>2Array take twice-values 2j (as
+  integer arrays, or float arrays with integer values).  Arrays of HalfInt
+  dtype (see am_halfint_dtype.h) are accepted as j without copying.  Arguments are
+  broadcast against each other, following the usual NumPy rules, and the
+  result is returned as a float64 array of the broadcast shape (or a 0-d
+  array if all arguments are scalars).
+
+  The coefficients are evaluated in a C++ loop, with the GIL released, and
+  distributed over num_threads threads (or GetNumThreads() for
+  num_threads=0).  Wigner6J and Wigner9J values are obtained through the
+  symbol caches (see am/symbol_cache.h and am_symbol_cache.h), when enabled.
+
+  This file is included by the SWIG interface file am.i, after the NumPy C
+  API headers, and is not intended for use from C++.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+  + 10/18/26: Evaluate Wigner6J and Wigner9J through symbol caches.
+
+****************************************************************/
+
+#ifndef AM_PYTHON_AM_NUMPY_H_
+#define AM_PYTHON_AM_NUMPY_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "am/halfint.h"
+#include "am/parallel.h"
+#include "am/racah_reduction.h"
+#include "am/symbol_cache.h"
+#include "am/wigner_gsl.h"
+#include "python/am_halfint_dtype.h"
+
+namespace am_python {
+
+  ////////////////////////////////////////////////////////////////
+  // argument conversion
+  ////////////////////////////////////////////////////////////////
+
+  enum class ArgumentMode {kHalfInt, kTwice};
+
+  inline
+  bool ObjectTwiceValue(PyObject* item, ArgumentMode mode, double& twice_value)
+  // Extract twice-value from Python object (HalfInt or number).
+  //
+  // Returns:
+  //   (bool): success, or false with Python exception set
+  {
+    if (PyObject_HasAttrString(item, "TwiceValue"))
+      {
+        // HalfInt (representing j, or 2j in twice-value mode)
+        PyObject* value = PyObject_CallMethod(item, "TwiceValue", nullptr);
+        if (!value)
+          return false;
+        twice_value = PyLong_AsDouble(value);
+        Py_DECREF(value);
+        if (mode==ArgumentMode::kTwice)
+          twice_value /= 2;
+      }
+    else
+      {
+        twice_value = PyFloat_AsDouble(item);
+        if (mode==ArgumentMode::kHalfInt)
+          twice_value *= 2;
+      }
+    return !PyErr_Occurred();
+  }
+
+  inline
+  PyArrayObject* TwiceValueArgument(PyObject* object, ArgumentMode mode, const char* function_name, int position)
+  // Convert Python argument to aligned, C-contiguous int32 array of
+  // twice-values.
+  //
+  // Arrays of HalfInt dtype (for j), or int32 arrays (for 2j), are passed
+  // through without copying, if they are C-contiguous.  Otherwise, the values are
+  // converted through float64 (or, for sequences of HalfInt, obtained from
+  // TwiceValue()), and validated as integers (kTwice) or half-integers
+  // (kHalfInt).
+  //
+  // Arguments:
+  //   object (input): Python argument (array, sequence, or scalar)
+  //   mode (input): whether argument contains j or 2j
+  //   function_name, position (input): for error messages
+  //
+  // Returns:
+  //   (PyArrayObject*): new reference, or nullptr with Python exception set
+  {
+    PyArrayObject* array = reinterpret_cast<PyArrayObject*>(
+        PyArray_FROMANY(object, NPY_NOTYPE, 0, 0, 0)
+      );
+    if (!array)
+      return nullptr;
+    const int zero_copy_type = (mode==ArgumentMode::kTwice) ? NPY_INT32 : halfint_type_num;
+    if ((PyArray_TYPE(array)==zero_copy_type) && PyArray_ISCARRAY_RO(array))
+      return array;
+
+    const bool objects = (PyArray_TYPE(array)==NPY_OBJECT);
+    PyArrayObject* values = reinterpret_cast<PyArrayObject*>(
+        PyArray_FROMANY(
+            reinterpret_cast<PyObject*>(array), objects ? NPY_OBJECT : NPY_FLOAT64,
+            0, 0, NPY_ARRAY_CARRAY_RO|NPY_ARRAY_FORCECAST
+          )
+      );
+    Py_DECREF(array);
+    if (!values)
+      return nullptr;
+    PyArrayObject* twice_values = reinterpret_cast<PyArrayObject*>(
+        PyArray_SimpleNew(PyArray_NDIM(values), PyArray_DIMS(values), NPY_INT32)
+      );
+    if (!twice_values)
+      {
+        Py_DECREF(values);
+        return nullptr;
+      }
+
+    std::int32_t* destination = static_cast<std::int32_t*>(PyArray_DATA(twice_values));
+    const npy_intp size = PyArray_SIZE(values);
+    const double scale = (mode==ArgumentMode::kHalfInt) ? 2. : 1.;
+    for (npy_intp i=0; i<size; ++i)
+      {
+        double twice_value;
+        if (objects)
+          {
+            if (!ObjectTwiceValue(static_cast<PyObject* const*>(PyArray_DATA(values))[i], mode, twice_value))
+              {
+                Py_DECREF(values);
+                Py_DECREF(twice_values);
+                return nullptr;
+              }
+          }
+        else
+          twice_value = scale*static_cast<const double*>(PyArray_DATA(values))[i];
+        if (
+            !(std::abs(twice_value)<=double(std::numeric_limits<std::int32_t>::max()))
+            || (twice_value!=std::floor(twice_value))
+          )
+          {
+            PyObject* value = PyFloat_FromDouble(twice_value/scale);
+            PyErr_Format(
+                PyExc_ValueError, "%s: argument %d contains value %R which is not %s",
+                function_name, position+1, value,
+                (mode==ArgumentMode::kHalfInt) ? "a half-integer" : "an integer twice-value"
+              );
+            Py_XDECREF(value);
+            Py_DECREF(values);
+            Py_DECREF(twice_values);
+            return nullptr;
+          }
+        destination[i] = std::int32_t(twice_value);
+      }
+    Py_DECREF(values);
+    return twice_values;
+  }
+
+  inline
+  bool ParseNumThreads(PyObject* kwargs, const char* function_name, int& num_threads)
+  // Extract num_threads from keyword arguments (the only keyword accepted).
+  //
+  // Returns:
+  //   (bool): success, or false with Python exception set
+  {
+    num_threads = 0;
+    if (!kwargs)
+      return true;
+    PyObject* key;
+    PyObject* value;
+    Py_ssize_t position = 0;
+    while (PyDict_Next(kwargs, &position, &key, &value))
+      {
+        if (PyUnicode_CompareWithASCIIString(key, "num_threads")!=0)
+          {
+            PyErr_Format(PyExc_TypeError, "%s: unexpected keyword argument %R", function_name, key);
+            return false;
+          }
+        num_threads = int(PyLong_AsLong(value));
+        if (PyErr_Occurred())
+          return false;
+      }
+    return true;
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // broadcast loop
+  ////////////////////////////////////////////////////////////////
+
+  // maximum number of arguments of a vectorized function
+  constexpr int kMaxVectorizedArguments = 9;
+
+  // number of elements per parallel work item
+  constexpr std::ptrdiff_t kVectorizedGrain = 256;
+
+  typedef double (*VectorizedKernel)(const int* two_values);
+
+  struct BroadcastLoop
+  // Strided loop over the broadcast shape of several int32 arrays.
+  {
+    int num_args;
+    int ndim;
+    npy_intp shape[NPY_MAXDIMS];
+    // element strides of each argument along each output axis (0 for
+    // broadcast axes)
+    npy_intp strides[kMaxVectorizedArguments][NPY_MAXDIMS];
+    const std::int32_t* data[kMaxVectorizedArguments];
+
+    void Evaluate(VectorizedKernel kernel, double* output, std::ptrdiff_t begin, std::ptrdiff_t end) const
+    // Evaluate kernel for flat output indices [begin,end).
+    {
+      // initial multi-index and argument offsets
+      npy_intp index[NPY_MAXDIMS];
+      npy_intp offset[kMaxVectorizedArguments] = {};
+      std::ptrdiff_t remainder = begin;
+      for (int axis=ndim-1; axis>=0; --axis)
+        {
+          index[axis] = remainder%shape[axis];
+          remainder /= shape[axis];
+          for (int arg=0; arg<num_args; ++arg)
+            offset[arg] += index[axis]*strides[arg][axis];
+        }
+
+      int two_values[kMaxVectorizedArguments];
+      for (std::ptrdiff_t i=begin; i<end; ++i)
+        {
+          for (int arg=0; arg<num_args; ++arg)
+            two_values[arg] = data[arg][offset[arg]];
+          output[i] = kernel(two_values);
+
+          // increment multi-index (odometer)
+          for (int axis=ndim-1; axis>=0; --axis)
+            {
+              for (int arg=0; arg<num_args; ++arg)
+                offset[arg] += strides[arg][axis];
+              if (++index[axis]<shape[axis])
+                break;
+              for (int arg=0; arg<num_args; ++arg)
+                offset[arg] -= shape[axis]*strides[arg][axis];
+              index[axis] = 0;
+            }
+        }
+    }
+  };
+
+  inline
+  PyObject* EvaluateVectorized(
+      const char* function_name, VectorizedKernel kernel, int num_args,
+      PyArrayObject* const* arrays, int num_threads
+    )
+  // Broadcast C-contiguous int32 arrays and evaluate kernel elementwise.
+  //
+  // Returns:
+  //   (PyObject*): new float64 array, or nullptr with Python exception set
+  {
+    // broadcast shape
+    BroadcastLoop loop;
+    loop.num_args = num_args;
+    loop.ndim = 0;
+    for (int arg=0; arg<num_args; ++arg)
+      loop.ndim = std::max(loop.ndim, PyArray_NDIM(arrays[arg]));
+    for (int axis=0; axis<loop.ndim; ++axis)
+      loop.shape[axis] = 1;
+    for (int arg=0; arg<num_args; ++arg)
+      {
+        const int shift = loop.ndim-PyArray_NDIM(arrays[arg]);
+        for (int axis=0; axis<PyArray_NDIM(arrays[arg]); ++axis)
+          {
+            const npy_intp dimension = PyArray_DIM(arrays[arg], axis);
+            npy_intp& broadcast_dimension = loop.shape[shift+axis];
+            if ((broadcast_dimension!=1) && (dimension!=1) && (dimension!=broadcast_dimension))
+              {
+                PyErr_Format(
+                    PyExc_ValueError, "%s: arguments could not be broadcast together (argument %d)",
+                    function_name, arg+1
+                  );
+                return nullptr;
+              }
+            if (dimension!=1)
+              broadcast_dimension = dimension;
+          }
+      }
+
+    // argument strides, in elements, relative to broadcast shape
+    for (int arg=0; arg<num_args; ++arg)
+      {
+        const int shift = loop.ndim-PyArray_NDIM(arrays[arg]);
+        npy_intp stride = 1;
+        for (int axis=loop.ndim-1; axis>=0; --axis)
+          {
+            const npy_intp dimension = (axis>=shift) ? PyArray_DIM(arrays[arg], axis-shift) : 1;
+            loop.strides[arg][axis] = (dimension==1) ? 0 : stride;
+            stride *= dimension;
+          }
+        loop.data[arg] = static_cast<const std::int32_t*>(PyArray_DATA(arrays[arg]));
+      }
+
+    PyArrayObject* result = reinterpret_cast<PyArrayObject*>(
+        PyArray_SimpleNew(loop.ndim, loop.shape, NPY_FLOAT64)
+      );
+    if (!result)
+      return nullptr;
+    double* output = static_cast<double*>(PyArray_DATA(result));
+    const std::ptrdiff_t size = PyArray_SIZE(result);
+
+    // evaluate without GIL
+    std::exception_ptr exception;
+    Py_BEGIN_ALLOW_THREADS
+    try
+      {
+        am::ParallelForRange(
+            0, size, kVectorizedGrain,
+            [&](std::ptrdiff_t begin, std::ptrdiff_t end) {loop.Evaluate(kernel, output, begin, end);},
+            num_threads
+          );
+      }
+    catch (...)
+      {
+        exception = std::current_exception();
+      }
+    Py_END_ALLOW_THREADS
+
+    // translate exception as in am.i default exception handler
+    if (exception)
+      {
+        Py_DECREF(result);
+        try
+          {
+            std::rethrow_exception(exception);
+          }
+        catch (const std::invalid_argument& e)
+          {
+            PyErr_Format(PyExc_ValueError, "%s: %s", function_name, e.what());
+          }
+        catch (const std::domain_error& e)
+          {
+            PyErr_Format(PyExc_ValueError, "%s: %s", function_name, e.what());
+          }
+        catch (const std::exception& e)
+          {
+            PyErr_Format(PyExc_RuntimeError, "%s: %s", function_name, e.what());
+          }
+        catch (...)
+          {
+            PyErr_Format(PyExc_RuntimeError, "%s: unknown exception", function_name);
+          }
+        return nullptr;
+      }
+
+    return reinterpret_cast<PyObject*>(result);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // vectorized function table
+  ////////////////////////////////////////////////////////////////
+
+  template<typename... Args>
+  constexpr int Arity(double (*)(Args...))
+  {
+    return int(sizeof...(Args));
+  }
+
+  template<auto function, std::size_t... i>
+  double EvaluateKernel(const int* two_values, std::index_sequence<i...>)
+  {
+    return function(HalfInt(two_values[i],2)...);
+  }
+
+  template<auto function>
+  double Kernel(const int* two_values)
+  // Evaluate HalfInt function on twice-value arguments.
+  {
+    return EvaluateKernel<function>(two_values, std::make_index_sequence<Arity(function)>());
+  }
+
+  struct VectorizedFunction
+  {
+    const char* name;
+    int num_args;
+    VectorizedKernel kernel;
+    const char* arguments;
+  };
+
+  inline constexpr VectorizedFunction kVectorizedFunctions[] = {
+    {"Wigner3J", 6, Kernel<&am::Wigner3J>, "ja, jb, jc, ma, mb, mc"},
+    {"ClebschGordan", 6, Kernel<&am::ClebschGordan>, "ja, ma, jb, mb, jc, mc"},
+    {"Wigner6J", 6, Kernel<&am::CachedWigner6J>, "ja, jb, jc, jd, je, jf"},
+    {"Unitary6J", 6, Kernel<&am::Unitary6J>, "ja, jb, jc, jd, je, jf"},
+    {"Unitary6JZ", 6, Kernel<&am::Unitary6JZ>, "ja, jb, jc, jd, je, jf"},
+    {"Wigner9J", 9, Kernel<&am::CachedWigner9J>, "ja, jb, jc, jd, je, jf, jg, jh, ji"},
+    {"Unitary9J", 9, Kernel<&am::Unitary9J>, "ja, jb, jc, jd, je, jf, jg, jh, ji"},
+    {"RacahReductionFactorRose", 6, Kernel<&am::RacahReductionFactorRose>, "Jp, J, Jpp, J0a, J0b, J0"},
+    {"RacahReductionFactor1Rose", 7, Kernel<&am::RacahReductionFactor1Rose>, "J1p, J2p, Jp, J1, J2, J, J0"},
+    {"RacahReductionFactor2Rose", 7, Kernel<&am::RacahReductionFactor2Rose>, "J1p, J2p, Jp, J1, J2, J, J0"},
+    {"RacahReductionFactor12DotRose", 7, Kernel<&am::RacahReductionFactor12DotRose>, "J1p, J2p, Jp, J1, J2, J, J0"},
+    {"RacahReductionFactor12Rose", 9, Kernel<&am::RacahReductionFactor12Rose>, "J1p, J2p, Jp, J1, J2, J, J0a, J0b, J0"},
+    {"RacahReductionFactor21Rose", 9, Kernel<&am::RacahReductionFactor21Rose>, "J1p, J2p, Jp, J1, J2, J, J0a, J0b, J0"},
+  };
+
+  constexpr std::size_t kNumVectorizedFunctions = sizeof(kVectorizedFunctions)/sizeof(kVectorizedFunctions[0]);
+
+  template<std::size_t index, ArgumentMode mode>
+  PyObject* VectorizedWrapper(PyObject*, PyObject* args, PyObject* kwargs)
+  // Python entry point for vectorized function.
+  {
+    const VectorizedFunction& function = kVectorizedFunctions[index];
+    const std::string name = std::string(function.name)+((mode==ArgumentMode::kTwice) ? "2Array" : "Array");
+
+    if (PyTuple_GET_SIZE(args)!=function.num_args)
+      {
+        PyErr_Format(
+            PyExc_TypeError, "%s() takes %d positional arguments but %zd were given",
+            name.c_str(), function.num_args, PyTuple_GET_SIZE(args)
+          );
+        return nullptr;
+      }
+    int num_threads;
+    if (!ParseNumThreads(kwargs, name.c_str(), num_threads))
+      return nullptr;
+
+    PyArrayObject* arrays[kMaxVectorizedArguments] = {};
+    PyObject* result = nullptr;
+    int arg = 0;
+    for (; arg<function.num_args; ++arg)
+      {
+        arrays[arg] = TwiceValueArgument(PyTuple_GET_ITEM(args, arg), mode, name.c_str(), arg);
+        if (!arrays[arg])
+          break;
+      }
+    if (arg==function.num_args)
+      result = EvaluateVectorized(name.c_str(), function.kernel, function.num_args, arrays, num_threads);
+    for (int i=0; i<arg; ++i)
+      Py_DECREF(arrays[i]);
+    return result;
+  }
+
+  template<std::size_t... index>
+  void AppendVectorizedMethods(std::vector<PyMethodDef>& methods, std::deque<std::string>& strings, std::index_sequence<index...>)
+  {
+    const PyCFunctionWithKeywords wrappers[2][sizeof...(index)] = {
+      {VectorizedWrapper<index,ArgumentMode::kHalfInt>...},
+      {VectorizedWrapper<index,ArgumentMode::kTwice>...}
+    };
+    for (std::size_t i=0; i<sizeof...(index); ++i)
+      for (int twice=0; twice<2; ++twice)
+        {
+          const VectorizedFunction& function = kVectorizedFunctions[i];
+          const std::string suffix = twice ? "2Array" : "Array";
+          const std::string& name = strings.emplace_back(function.name+suffix);
+          const std::string& doc = strings.emplace_back(
+              name+"("+function.arguments+", num_threads=0)\n\n"
+              +"Vectorized "+function.name+", evaluated elementwise over broadcast arrays of "
+              +(twice ? "twice-values 2j" : "half-integer values j")+", returning float64 array."
+            );
+          methods.push_back({
+              name.c_str(), reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(wrappers[twice][i])),
+              METH_VARARGS|METH_KEYWORDS, doc.c_str()
+            });
+        }
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // module initialization
+  ////////////////////////////////////////////////////////////////
+
+  inline
+  int AddNumPyFunctions(PyObject* module, PyObject* public_interface)
+  // Register NumPy extension functions in module.
+  //
+  // Must be called after import_array().
+  //
+  // Returns:
+  //   (int): 0 on success, or -1 with Python exception set
+  {
+    // method definitions must outlive module
+    static std::deque<std::string> strings;
+    static std::vector<PyMethodDef> methods;
+    if (methods.empty())
+      {
+        AppendVectorizedMethods(methods, strings, std::make_index_sequence<kNumVectorizedFunctions>());
+        methods.push_back({nullptr, nullptr, 0, nullptr});
+      }
+    if (PyModule_AddFunctions(module, methods.data())<0)
+      return -1;
+    for (const PyMethodDef& method : methods)
+      if (method.ml_name)
+        {
+          PyObject* name = PyUnicode_FromString(method.ml_name);
+          if (!name)
+            return -1;
+          PyList_Append(public_interface, name);
+          Py_DECREF(name);
+        }
+    return 0;
+  }
+
+}  // namespace am_python
+
+#endif  // AM_PYTHON_AM_NUMPY_H_
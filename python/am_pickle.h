@@ -0,0 +1,258 @@
+/****************************************************************
+  am_pickle.h
+
+  Compact pickling of HalfInt and containers, for the am Python module.
+
+  HalfInt: A HalfInt is pickled as its twice-value 2j, a plain int, and is
+  reconstructed by the module-private function _am._HalfIntFromTwiceValue.
+
+  Containers: The SWIG-wrapped containers HalfIntVector, HalfIntPair,
+  vectori, and pairi are pickled as the raw bytes of their int32 storage
+  (see am_buffer.h), and are reconstructed by a single copy of these bytes
+  into a new container (_am._HalfIntVectorFromBuffer, etc.).  Under pickle
+  protocol 5, the storage is passed as a pickle.PickleBuffer, so it may be
+  transferred out of band, without any intermediate copy:
+
+    >>> buffers = []
+    >>> data = pickle.dumps(v, protocol=5, buffer_callback=buffers.append)
+    >>> w = pickle.loads(data, buffers=buffers)
+
+  Note that a container is locked against modification (see am_buffer.h)
+  while any PickleBuffer referring to it is alive.  Under earlier protocols,
+  the storage is copied into a bytes object.  The byte order is that of the
+  machine, so pickled containers are only portable between machines of the
+  same endianness.
+
+  The same reduction serves copy.copy and copy.deepcopy.
+
+  This file is included by the SWIG interface file am.i, which provides the
+  specializations of ContainerToPyObject for the wrapped containers, and
+  is not intended for use from C++.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+
+****************************************************************/
+
+#ifndef AM_PYTHON_AM_PICKLE_H_
+#define AM_PYTHON_AM_PICKLE_H_
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "am/halfint.h"
+#include "python/am_halfint_dtype.h"
+
+namespace am_python {
+
+  // Wrap C++ container in new Python object, taking ownership (defined in
+  // am.i, for each wrapped container type).
+  template<typename Container>
+  PyObject* ContainerToPyObject(Container* container);
+
+  namespace pickle {
+
+    // types with pickle support, and their reconstructors
+    //
+    // Order must match kPickleTypes.
+    enum PickleTypeIndex {
+      kHalfInt, kHalfIntVector, kHalfIntPair, kVectorInt, kPairInt, kNumPickleTypes
+    };
+
+    inline
+    PyObject*& Reconstructor(std::size_t index)
+    // Module-level reconstructor function for type (reference held for
+    // lifetime of process, once installed).
+    {
+      static PyObject* reconstructors[kNumPickleTypes] = {};
+      return reconstructors[index];
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // HalfInt
+    ////////////////////////////////////////////////////////////////
+
+    inline
+    PyObject* HalfIntFromTwiceValue(PyObject*, PyObject* two_value_object)
+    // Reconstruct HalfInt from twice-value.
+    {
+      const long two_value = PyLong_AsLong(two_value_object);
+      if ((two_value==-1) && PyErr_Occurred())
+        return nullptr;
+      return HalfIntToPyObject(int(two_value));
+    }
+
+    inline
+    PyObject* HalfIntReduce(PyObject* self, PyObject*)
+    // Reduce HalfInt to (_HalfIntFromTwiceValue, (2j,)).
+    {
+      int two_value;
+      if (!HalfIntFromPyObject(self, two_value))
+        return nullptr;
+      return Py_BuildValue("O(i)", Reconstructor(kHalfInt), two_value);
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // containers
+    ////////////////////////////////////////////////////////////////
+
+    template<typename T>
+    void* ContainerData(std::vector<T>& container) {return container.data();}
+
+    template<typename T>
+    bool ResizeContainer(std::vector<T>& container, std::size_t num_bytes)
+    {
+      if (num_bytes%sizeof(T)!=0)
+        return false;
+      container.resize(num_bytes/sizeof(T));
+      return true;
+    }
+
+    template<typename T>
+    void* ContainerData(std::pair<T,T>& container) {return &container.first;}
+
+    template<typename T>
+    bool ResizeContainer(std::pair<T,T>&, std::size_t num_bytes)
+    {
+      return num_bytes==2*sizeof(T);
+    }
+
+    template<typename Container>
+    PyObject* ContainerFromBuffer(PyObject*, PyObject* data)
+    // Reconstruct container from copy of contents of contiguous buffer.
+    {
+      Py_buffer view;
+      if (PyObject_GetBuffer(data, &view, PyBUF_C_CONTIGUOUS)<0)
+        return nullptr;
+      Container* container = new Container();
+      const bool valid = ResizeContainer(*container, std::size_t(view.len));
+      if (valid && view.len)
+        std::memcpy(ContainerData(*container), view.buf, std::size_t(view.len));
+      PyBuffer_Release(&view);
+      if (!valid)
+        {
+          delete container;
+          PyErr_SetString(PyExc_ValueError, "pickled container data has invalid length");
+          return nullptr;
+        }
+      return ContainerToPyObject(container);
+    }
+
+    template<std::size_t index>
+    PyObject* ContainerReduceEx(PyObject* self, PyObject* protocol_object)
+    // Reduce container to (_...FromBuffer, (data,)), where data is a
+    // PickleBuffer on the container storage (protocol 5 and later), or a
+    // bytes copy of the storage (earlier protocols).
+    {
+      const long protocol = PyLong_AsLong(protocol_object);
+      if ((protocol==-1) && PyErr_Occurred())
+        return nullptr;
+      PyObject* data = (protocol>=5) ? PyPickleBuffer_FromObject(self) : PyBytes_FromObject(self);
+      if (!data)
+        return nullptr;
+      return Py_BuildValue("O(N)", Reconstructor(index), data);
+    }
+
+    struct PickleType
+    {
+      const char* type_name;
+      const char* reconstructor_name;
+      PyCFunction reconstructor;
+      const char* reduce_name;
+      PyCFunction reduce;
+      int reduce_flags;
+    };
+
+    inline const PickleType kPickleTypes[] = {
+      {
+        "HalfInt", "_HalfIntFromTwiceValue", HalfIntFromTwiceValue,
+        "__reduce__", HalfIntReduce, METH_NOARGS
+      },
+      {
+        "HalfIntVector", "_HalfIntVectorFromBuffer", ContainerFromBuffer<std::vector<HalfInt>>,
+        "__reduce_ex__", ContainerReduceEx<kHalfIntVector>, METH_O
+      },
+      {
+        "HalfIntPair", "_HalfIntPairFromBuffer", ContainerFromBuffer<std::pair<HalfInt,HalfInt>>,
+        "__reduce_ex__", ContainerReduceEx<kHalfIntPair>, METH_O
+      },
+      {
+        "vectori", "_vectoriFromBuffer", ContainerFromBuffer<std::vector<int>>,
+        "__reduce_ex__", ContainerReduceEx<kVectorInt>, METH_O
+      },
+      {
+        "pairi", "_pairiFromBuffer", ContainerFromBuffer<std::pair<int,int>>,
+        "__reduce_ex__", ContainerReduceEx<kPairInt>, METH_O
+      },
+    };
+
+  }  // namespace pickle
+
+  inline
+  int InstallPickleSupport(PyObject* module)
+  // Register reconstructor functions in module (as private names, not in
+  // the public interface), and install reduction methods in the types.
+  //
+  // Must be called after the wrapped types have been added to the module.
+  //
+  // Returns:
+  //   (int): 0 on success, or -1 with Python exception set
+  {
+    using pickle::kNumPickleTypes;
+    using pickle::kPickleTypes;
+
+    // method definitions must outlive module and types
+    static PyMethodDef reconstructor_methods[kNumPickleTypes+1];
+    static PyMethodDef reduce_methods[kNumPickleTypes];
+    for (std::size_t index=0; index<kNumPickleTypes; ++index)
+      {
+        const pickle::PickleType& pickle_type = kPickleTypes[index];
+        reconstructor_methods[index] = {
+          pickle_type.reconstructor_name, pickle_type.reconstructor, METH_O,
+          "Reconstruct object from pickled data (see am_pickle.h)."
+        };
+        reduce_methods[index] = {
+          pickle_type.reduce_name, pickle_type.reduce, pickle_type.reduce_flags,
+          "Helper for pickle."
+        };
+      }
+    reconstructor_methods[kNumPickleTypes] = {nullptr, nullptr, 0, nullptr};
+    if (PyModule_AddFunctions(module, reconstructor_methods)<0)
+      return -1;
+
+    for (std::size_t index=0; index<kNumPickleTypes; ++index)
+      {
+        const pickle::PickleType& pickle_type = kPickleTypes[index];
+        PyObject* reconstructor = PyObject_GetAttrString(module, pickle_type.reconstructor_name);
+        if (!reconstructor)
+          return -1;
+        pickle::Reconstructor(index) = reconstructor;  // retain reference
+        PyObject* type = PyObject_GetAttrString(module, pickle_type.type_name);
+        if (!type)
+          return -1;
+        if (!PyType_Check(type))
+          {
+            Py_DECREF(type);
+            PyErr_Format(PyExc_TypeError, "am.%s is not a type", pickle_type.type_name);
+            return -1;
+          }
+        PyTypeObject* type_object = reinterpret_cast<PyTypeObject*>(type);
+        PyObject* descriptor = PyDescr_NewMethod(type_object, &reduce_methods[index]);
+        const int status = descriptor ? PyDict_SetItemString(type_object->tp_dict, pickle_type.reduce_name, descriptor) : -1;
+        Py_XDECREF(descriptor);
+        PyType_Modified(type_object);
+        Py_DECREF(type);
+        if (status<0)
+          return -1;
+      }
+    return 0;
+  }
+
+}  // namespace am_python
+
+#endif  // AM_PYTHON_AM_PICKLE_H_
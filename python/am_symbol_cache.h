@@ -0,0 +1,290 @@
+/****************************************************************
+  am_symbol_cache.h
+
+  Python access to the process-wide symbol caches of the am module (see
+  am/symbol_cache.h).
+
+  The caches are identified by symbol name ("Wigner6J" or "Wigner9J"):
+
+    SymbolCacheAttach(symbol, filename)
+    SymbolCacheDetach(symbol)
+    SymbolCacheWarm(symbol, j_max, num_threads=0)
+    SymbolCacheSave(symbol, filename)
+    SymbolCacheClear(symbol)
+    SymbolCacheEnable(symbol, enabled=True)
+    SymbolCacheInfo(symbol) -> dict
+
+  Once a cache is enabled (by attaching a table file, warming, or
+  explicitly), am.Wigner6J/am.Wigner9J and their vectorized counterparts
+  Wigner6JArray/Wigner9JArray (see am_fastcall.h and am_numpy.h) consult the
+  cache.  For use in a multiprocessing pool, a table file saved by one
+  process may be attached in each worker (e.g., in the pool initializer),
+  or attached before the workers are forked, so that all workers share the
+  same mapped pages:
+
+    >>> am.SymbolCacheWarm("Wigner6J", 10)
+    >>> am.SymbolCacheSave("Wigner6J", "wigner6j.bin")
+    >>> pool = multiprocessing.Pool(initializer=am.SymbolCacheAttach, initargs=("Wigner6J", "wigner6j.bin"))
+
+  Attaching, warming, and saving release the GIL.
+
+  This file is included by the SWIG interface file am.i, and is not
+  intended for use from C++.
+
+  Language: C++17
+
+  University of Notre Dame
+
+  + 10/18/26: Created.
+
+****************************************************************/
+
+#ifndef AM_PYTHON_AM_SYMBOL_CACHE_H_
+#define AM_PYTHON_AM_SYMBOL_CACHE_H_
+
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include "am/halfint.h"
+#include "am/symbol_cache.h"
+#include "python/am_halfint_dtype.h"
+
+namespace am_python {
+
+  namespace symbol_cache {
+
+    template<typename F>
+    PyObject* WithSymbolCache(const char* symbol, F f)
+    // Invoke f(cache) on cache for given symbol name, and map C++ exceptions
+    // to Python exceptions (following default exception handler in am.i).
+    //
+    // Returns:
+    //   (PyObject*): result of f, or nullptr with Python exception set
+    {
+      try
+        {
+          if (std::strcmp(symbol, "Wigner6J")==0)
+            return f(am::Wigner6JCache());
+          if (std::strcmp(symbol, "Wigner9J")==0)
+            return f(am::Wigner9JCache());
+          PyErr_Format(PyExc_ValueError, "no symbol cache for '%s' (expected 'Wigner6J' or 'Wigner9J')", symbol);
+          return nullptr;
+        }
+      catch (const std::invalid_argument& e)
+        {
+          PyErr_SetString(PyExc_ValueError, e.what());
+        }
+      catch (const std::domain_error& e)
+        {
+          PyErr_SetString(PyExc_ValueError, e.what());
+        }
+      catch (const std::exception& e)
+        {
+          PyErr_SetString(PyExc_RuntimeError, e.what());
+        }
+      return nullptr;
+    }
+
+    template<typename F>
+    void WithoutGIL(F f)
+    // Invoke f with GIL released, rethrowing any exception after the GIL is
+    // reacquired.
+    {
+      std::exception_ptr exception;
+      Py_BEGIN_ALLOW_THREADS
+      try
+        {
+          f();
+        }
+      catch (...)
+        {
+          exception = std::current_exception();
+        }
+      Py_END_ALLOW_THREADS
+      if (exception)
+        std::rethrow_exception(exception);
+    }
+
+    inline
+    PyObject* Attach(PyObject*, PyObject* args, PyObject* kwargs)
+    {
+      static const char* keywords[] = {"symbol", "filename", nullptr};
+      const char* symbol;
+      PyObject* filename;
+      if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sO&:SymbolCacheAttach", const_cast<char**>(keywords), &symbol, PyUnicode_FSConverter, &filename))
+        return nullptr;
+      const std::string filename_string(PyBytes_AS_STRING(filename));
+      Py_DECREF(filename);
+      return WithSymbolCache(symbol, [&](auto& cache) {
+          WithoutGIL([&] {cache.Attach(filename_string);});
+          Py_RETURN_NONE;
+        });
+    }
+
+    inline
+    PyObject* Detach(PyObject*, PyObject* args, PyObject* kwargs)
+    {
+      static const char* keywords[] = {"symbol", nullptr};
+      const char* symbol;
+      if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s:SymbolCacheDetach", const_cast<char**>(keywords), &symbol))
+        return nullptr;
+      return WithSymbolCache(symbol, [&](auto& cache) {
+          cache.Detach();
+          Py_RETURN_NONE;
+        });
+    }
+
+    inline
+    PyObject* Warm(PyObject*, PyObject* args, PyObject* kwargs)
+    {
+      static const char* keywords[] = {"symbol", "j_max", "num_threads", nullptr};
+      const char* symbol;
+      PyObject* j_max_object;
+      int num_threads = 0;
+      if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sO|i:SymbolCacheWarm", const_cast<char**>(keywords), &symbol, &j_max_object, &num_threads))
+        return nullptr;
+      int two_j_max;
+      if (!HalfIntFromPyObject(j_max_object, two_j_max))
+        return nullptr;
+      return WithSymbolCache(symbol, [&](auto& cache) {
+          WithoutGIL([&] {cache.Warm(HalfInt(two_j_max,2), num_threads);});
+          Py_RETURN_NONE;
+        });
+    }
+
+    inline
+    PyObject* Save(PyObject*, PyObject* args, PyObject* kwargs)
+    {
+      static const char* keywords[] = {"symbol", "filename", nullptr};
+      const char* symbol;
+      PyObject* filename;
+      if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sO&:SymbolCacheSave", const_cast<char**>(keywords), &symbol, PyUnicode_FSConverter, &filename))
+        return nullptr;
+      const std::string filename_string(PyBytes_AS_STRING(filename));
+      Py_DECREF(filename);
+      return WithSymbolCache(symbol, [&](auto& cache) {
+          WithoutGIL([&] {cache.Save(filename_string);});
+          Py_RETURN_NONE;
+        });
+    }
+
+    inline
+    PyObject* Clear(PyObject*, PyObject* args, PyObject* kwargs)
+    {
+      static const char* keywords[] = {"symbol", nullptr};
+      const char* symbol;
+      if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s:SymbolCacheClear", const_cast<char**>(keywords), &symbol))
+        return nullptr;
+      return WithSymbolCache(symbol, [&](auto& cache) {
+          cache.Clear();
+          Py_RETURN_NONE;
+        });
+    }
+
+    inline
+    PyObject* Enable(PyObject*, PyObject* args, PyObject* kwargs)
+    {
+      static const char* keywords[] = {"symbol", "enabled", nullptr};
+      const char* symbol;
+      int enabled = 1;
+      if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|p:SymbolCacheEnable", const_cast<char**>(keywords), &symbol, &enabled))
+        return nullptr;
+      return WithSymbolCache(symbol, [&](auto& cache) {
+          cache.set_enabled(enabled);
+          Py_RETURN_NONE;
+        });
+    }
+
+    inline
+    PyObject* Info(PyObject*, PyObject* args, PyObject* kwargs)
+    {
+      static const char* keywords[] = {"symbol", nullptr};
+      const char* symbol;
+      if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s:SymbolCacheInfo", const_cast<char**>(keywords), &symbol))
+        return nullptr;
+      return WithSymbolCache(symbol, [&](auto& cache) {
+          const am::SymbolCacheStatistics statistics = cache.statistics();
+          const std::string filename = cache.filename();
+          return Py_BuildValue(
+              "{s:s,s:O,s:s,s:n,s:n,s:n,s:K,s:K,s:d}",
+              "symbol", cache.name().c_str(),
+              "enabled", cache.enabled() ? Py_True : Py_False,
+              "filename", filename.c_str(),
+              "size", Py_ssize_t(statistics.size()),
+              "mapped_size", Py_ssize_t(statistics.mapped_size),
+              "local_size", Py_ssize_t(statistics.local_size),
+              "hits", static_cast<unsigned long long>(statistics.hits),
+              "misses", static_cast<unsigned long long>(statistics.misses),
+              "hit_rate", statistics.hit_rate()
+            );
+        });
+    }
+
+    template<typename F>
+    constexpr PyCFunction AsPyCFunction(F function)
+    {
+      return reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)()>(function));
+    }
+
+  }  // namespace symbol_cache
+
+  inline
+  int AddSymbolCacheFunctions(PyObject* module, PyObject* public_interface)
+  // Register symbol cache functions in module.
+  //
+  // Returns:
+  //   (int): 0 on success, or -1 with Python exception set
+  {
+    using symbol_cache::AsPyCFunction;
+    static PyMethodDef methods[] = {
+      {
+        "SymbolCacheAttach", AsPyCFunction(symbol_cache::Attach), METH_VARARGS|METH_KEYWORDS,
+        "SymbolCacheAttach(symbol, filename)\n\n"
+        "Attach memory-mapped symbol table file to cache for symbol ('Wigner6J' or 'Wigner9J'), and enable cache."
+      },
+      {
+        "SymbolCacheDetach", AsPyCFunction(symbol_cache::Detach), METH_VARARGS|METH_KEYWORDS,
+        "SymbolCacheDetach(symbol)\n\nDetach symbol table file from cache."
+      },
+      {
+        "SymbolCacheWarm", AsPyCFunction(symbol_cache::Warm), METH_VARARGS|METH_KEYWORDS,
+        "SymbolCacheWarm(symbol, j_max, num_threads=0)\n\n"
+        "Evaluate and cache all symbols with arguments j<=j_max, and enable cache."
+      },
+      {
+        "SymbolCacheSave", AsPyCFunction(symbol_cache::Save), METH_VARARGS|METH_KEYWORDS,
+        "SymbolCacheSave(symbol, filename)\n\nSave cache contents to symbol table file."
+      },
+      {
+        "SymbolCacheClear", AsPyCFunction(symbol_cache::Clear), METH_VARARGS|METH_KEYWORDS,
+        "SymbolCacheClear(symbol)\n\nDiscard process-local cache entries, and reset statistics."
+      },
+      {
+        "SymbolCacheEnable", AsPyCFunction(symbol_cache::Enable), METH_VARARGS|METH_KEYWORDS,
+        "SymbolCacheEnable(symbol, enabled=True)\n\nEnable or disable use of cache."
+      },
+      {
+        "SymbolCacheInfo", AsPyCFunction(symbol_cache::Info), METH_VARARGS|METH_KEYWORDS,
+        "SymbolCacheInfo(symbol) -> dict\n\n"
+        "Get cache status: enabled, attached filename, size (mapped_size+local_size), hits, misses, hit_rate."
+      },
+      {nullptr, nullptr, 0, nullptr}
+    };
+    if (PyModule_AddFunctions(module, methods)<0)
+      return -1;
+    for (const PyMethodDef* method=methods; method->ml_name; ++method)
+      {
+        PyObject* name = PyUnicode_FromString(method->ml_name);
+        if (!name)
+          return -1;
+        PyList_Append(public_interface, name);
+        Py_DECREF(name);
+      }
+    return 0;
+  }
+
+}  // namespace am_python
+
+#endif  // AM_PYTHON_AM_SYMBOL_CACHE_H_
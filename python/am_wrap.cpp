@@ -4635,6 +4635,48 @@ SWIG_AsVal_ptrdiff_t (PyObject * obj, ptrdiff_t *val)
 #include "am/wigner_gsl.h"
 #include "am/racah_reduction.h"
 #include "am/rme.h"
+#include "am/parallel.h"
+
+
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+#include <numpy/ufuncobject.h>
+#include "python/am_halfint_dtype.h"
+#include "python/am_numpy.h"
+#include "python/am_fastcall.h"
+#include "python/am_symbol_cache.h"
+#include "python/am_builders.h"
+
+// conversion of Python objects to and from HalfInt, for HalfInt dtype (see
+// am_halfint_dtype.h)
+namespace am_python {
+bool HalfIntFromPyObject(PyObject* object, int& two_value) {
+  void *argp = 0;
+  if (SWIG_IsOK(SWIG_ConvertPtr(object, &argp, SWIGTYPE_p_HalfInt, 0))) {
+    two_value = reinterpret_cast<HalfInt*>(argp)->TwiceValue();
+    return true;
+  }
+  if (PyIndex_Check(object)) {
+    PyObject* index = PyNumber_Index(object);
+    if (!index) return false;
+    const long value = PyLong_AsLong(index);
+    Py_DECREF(index);
+    two_value = int(2*value);
+    return !PyErr_Occurred();
+  }
+  const double value = PyFloat_AsDouble(object);
+  if (PyErr_Occurred()) return false;
+  if (!(std::abs(2*value)<=double(std::numeric_limits<int>::max())) || (2*value!=std::floor(2*value))) {
+    PyErr_Format(PyExc_ValueError, "value %R is not a half-integer", object);
+    return false;
+  }
+  two_value = int(2*value);
+  return true;
+}
+PyObject* HalfIntToPyObject(int two_value) {
+  return SWIG_InternalNewPointerObj((new HalfInt(two_value,2)), SWIGTYPE_p_HalfInt, SWIG_POINTER_OWN |  0 );
+}
+}
 
 
 extern "C" {
@@ -4686,6 +4728,55 @@ PyObject* HalfInt_dispatch_mul(PyObject* a, PyObject* b) {
 }
 
 
+#include "python/am_buffer.h"
+
+namespace am_python {
+template<typename Container>
+int SwigGetBuffer(PyObject* exporter, Py_buffer* view, int flags, swig_type_info* type) {
+  void *argp = 0;
+  if (!SWIG_IsOK(SWIG_ConvertPtr(exporter, &argp, type, 0))) {
+    PyErr_SetString(PyExc_BufferError, "object does not wrap expected container type");
+    return -1;
+  }
+  return GetBuffer(exporter, *reinterpret_cast<Container*>(argp), view, flags);
+}
+int HalfIntPairGetBuffer(PyObject* exporter, Py_buffer* view, int flags) {
+  return SwigGetBuffer<std::pair<HalfInt,HalfInt> >(exporter, view, flags, SWIGTYPE_p_std__pairT_HalfInt_HalfInt_t);
+}
+int HalfIntVectorGetBuffer(PyObject* exporter, Py_buffer* view, int flags) {
+  return SwigGetBuffer<std::vector<HalfInt> >(exporter, view, flags, SWIGTYPE_p_std__vectorT_HalfInt_t);
+}
+int PairIntGetBuffer(PyObject* exporter, Py_buffer* view, int flags) {
+  return SwigGetBuffer<std::pair<int,int> >(exporter, view, flags, SWIGTYPE_p_std__pairT_int_int_t);
+}
+int VectorIntGetBuffer(PyObject* exporter, Py_buffer* view, int flags) {
+  return SwigGetBuffer<std::vector<int> >(exporter, view, flags, SWIGTYPE_p_std__vectorT_int_t);
+}
+}
+
+
+#include "python/am_pickle.h"
+
+namespace am_python {
+template<>
+PyObject* ContainerToPyObject(std::vector<HalfInt>* container) {
+  return SWIG_InternalNewPointerObj(container, SWIGTYPE_p_std__vectorT_HalfInt_t, SWIG_POINTER_OWN |  0 );
+}
+template<>
+PyObject* ContainerToPyObject(std::pair<HalfInt,HalfInt>* container) {
+  return SWIG_InternalNewPointerObj(container, SWIGTYPE_p_std__pairT_HalfInt_HalfInt_t, SWIG_POINTER_OWN |  0 );
+}
+template<>
+PyObject* ContainerToPyObject(std::vector<int>* container) {
+  return SWIG_InternalNewPointerObj(container, SWIGTYPE_p_std__vectorT_int_t, SWIG_POINTER_OWN |  0 );
+}
+template<>
+PyObject* ContainerToPyObject(std::pair<int,int>* container) {
+  return SWIG_InternalNewPointerObj(container, SWIGTYPE_p_std__pairT_int_int_t, SWIG_POINTER_OWN |  0 );
+}
+}
+
+
 namespace swig {
   template <class Type>
   struct noconst_traits {
@@ -7544,6 +7635,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector___setslice____SWIG_0(PyObject *self, Py
   } 
   arg3 = static_cast< std::vector< HalfInt >::difference_type >(val3);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_HalfInt_Sg____setslice____SWIG_0(arg1,SWIG_STD_MOVE(arg2),SWIG_STD_MOVE(arg3));
@@ -7609,6 +7704,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector___setslice____SWIG_1(PyObject *self, Py
     arg4 = ptr;
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_HalfInt_Sg____setslice____SWIG_1(arg1,SWIG_STD_MOVE(arg2),SWIG_STD_MOVE(arg3),(std::vector< HalfInt,std::allocator< HalfInt > > const &)*arg4);
@@ -7693,6 +7792,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector___delslice__(PyObject *self, PyObject *
   } 
   arg3 = static_cast< std::vector< HalfInt >::difference_type >(val3);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_HalfInt_Sg____delslice__(arg1,SWIG_STD_MOVE(arg2),SWIG_STD_MOVE(arg3));
@@ -7737,6 +7840,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector___delitem____SWIG_0(PyObject *self, Py_
   } 
   arg2 = static_cast< std::vector< HalfInt >::difference_type >(val2);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_HalfInt_Sg____delitem____SWIG_0(arg1,SWIG_STD_MOVE(arg2));
@@ -7837,6 +7944,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector___setitem____SWIG_0(PyObject *self, Py_
     arg3 = ptr;
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_HalfInt_Sg____setitem____SWIG_0(arg1,arg2,(std::vector< HalfInt,std::allocator< HalfInt > > const &)*arg3);
@@ -7882,6 +7993,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector___setitem____SWIG_1(PyObject *self, Py_
     arg2 = (SWIGPY_SLICEOBJECT *) swig_obj[1];
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_HalfInt_Sg____setitem____SWIG_1(arg1,arg2);
@@ -7925,6 +8040,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector___delitem____SWIG_1(PyObject *self, Py_
     arg2 = (SWIGPY_SLICEOBJECT *) swig_obj[1];
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_HalfInt_Sg____delitem____SWIG_1(arg1,arg2);
@@ -8096,6 +8215,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector___setitem____SWIG_2(PyObject *self, Py_
   }
   arg3 = reinterpret_cast< std::vector< HalfInt >::value_type * >(argp3);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_HalfInt_Sg____setitem____SWIG_2(arg1,SWIG_STD_MOVE(arg2),(HalfInt const &)*arg3);
@@ -8140,6 +8263,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector___setitem____SWIG_3(PyObject *self, Py_
   } 
   arg2 = static_cast< std::vector< HalfInt >::difference_type >(val2);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_HalfInt_Sg____setitem____SWIG_3(arg1,SWIG_STD_MOVE(arg2));
@@ -8242,6 +8369,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_pop(PyObject *self, PyObject *args) {
   }
   arg1 = reinterpret_cast< std::vector< HalfInt > * >(argp1);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         result = std_vector_Sl_HalfInt_Sg__pop(arg1);
@@ -8289,6 +8420,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_append(PyObject *self, PyObject *args)
   }
   arg2 = reinterpret_cast< std::vector< HalfInt >::value_type * >(argp2);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       std_vector_Sl_HalfInt_Sg__append(arg1,(HalfInt const &)*arg2);
     } catch (const std::invalid_argument& e) {
@@ -8457,6 +8592,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_swap(PyObject *self, PyObject *args) {
   }
   arg2 = reinterpret_cast< std::vector< HalfInt > * >(argp2);
   {
+    if (am_python::BufferExported(arg1) || am_python::BufferExported(arg2)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->swap(*arg2);
     } catch (const std::invalid_argument& e) {
@@ -8615,6 +8754,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_clear(PyObject *self, PyObject *args) {
   }
   arg1 = reinterpret_cast< std::vector< HalfInt > * >(argp1);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->clear();
     } catch (const std::invalid_argument& e) {
@@ -8707,6 +8850,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_pop_back(PyObject *self, PyObject *args
   }
   arg1 = reinterpret_cast< std::vector< HalfInt > * >(argp1);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->pop_back();
     } catch (const std::invalid_argument& e) {
@@ -8745,6 +8892,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_resize__SWIG_0(PyObject *self, Py_ssize
   } 
   arg2 = static_cast< std::vector< HalfInt >::size_type >(val2);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->resize(arg2);
     } catch (const std::invalid_argument& e) {
@@ -8790,6 +8941,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_erase__SWIG_0(PyObject *self, Py_ssize_
     }
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       result = std_vector_Sl_HalfInt_Sg__erase__SWIG_0(arg1,SWIG_STD_MOVE(arg2));
     } catch (const std::invalid_argument& e) {
@@ -8850,6 +9005,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_erase__SWIG_1(PyObject *self, Py_ssize_
     }
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       result = std_vector_Sl_HalfInt_Sg__erase__SWIG_1(arg1,SWIG_STD_MOVE(arg2),SWIG_STD_MOVE(arg3));
     } catch (const std::invalid_argument& e) {
@@ -9017,6 +9176,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_push_back(PyObject *self, PyObject *arg
   }
   arg2 = reinterpret_cast< std::vector< HalfInt >::value_type * >(argp2);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->push_back((std::vector< HalfInt >::value_type const &)*arg2);
     } catch (const std::invalid_argument& e) {
@@ -9133,6 +9296,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_assign(PyObject *self, PyObject *args)
   }
   arg3 = reinterpret_cast< std::vector< HalfInt >::value_type * >(argp3);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->assign(arg2,(std::vector< HalfInt >::value_type const &)*arg3);
     } catch (const std::invalid_argument& e) {
@@ -9184,6 +9351,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_resize__SWIG_1(PyObject *self, Py_ssize
   }
   arg3 = reinterpret_cast< std::vector< HalfInt >::value_type * >(argp3);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->resize(arg2,(std::vector< HalfInt >::value_type const &)*arg3);
     } catch (const std::invalid_argument& e) {
@@ -9271,6 +9442,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_insert__SWIG_0(PyObject *self, Py_ssize
   }
   arg3 = reinterpret_cast< std::vector< HalfInt >::value_type * >(argp3);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       result = std_vector_Sl_HalfInt_Sg__insert__SWIG_0(arg1,SWIG_STD_MOVE(arg2),(HalfInt const &)*arg3);
     } catch (const std::invalid_argument& e) {
@@ -9337,6 +9512,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_insert__SWIG_1(PyObject *self, Py_ssize
   }
   arg4 = reinterpret_cast< std::vector< HalfInt >::value_type * >(argp4);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       std_vector_Sl_HalfInt_Sg__insert__SWIG_1(arg1,SWIG_STD_MOVE(arg2),SWIG_STD_MOVE(arg3),(HalfInt const &)*arg4);
     } catch (const std::invalid_argument& e) {
@@ -9408,6 +9587,10 @@ SWIGINTERN PyObject *_wrap_HalfIntVector_reserve(PyObject *self, PyObject *args)
   } 
   arg2 = static_cast< std::vector< HalfInt >::size_type >(val2);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->reserve(arg2);
     } catch (const std::invalid_argument& e) {
@@ -14286,6 +14469,10 @@ SWIGINTERN PyObject *_wrap_vectori___setslice____SWIG_0(PyObject *self, Py_ssize
   } 
   arg3 = static_cast< std::vector< int >::difference_type >(val3);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_int_Sg____setslice____SWIG_0(arg1,SWIG_STD_MOVE(arg2),SWIG_STD_MOVE(arg3));
@@ -14351,6 +14538,10 @@ SWIGINTERN PyObject *_wrap_vectori___setslice____SWIG_1(PyObject *self, Py_ssize
     arg4 = ptr;
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_int_Sg____setslice____SWIG_1(arg1,SWIG_STD_MOVE(arg2),SWIG_STD_MOVE(arg3),(std::vector< int,std::allocator< int > > const &)*arg4);
@@ -14435,6 +14626,10 @@ SWIGINTERN PyObject *_wrap_vectori___delslice__(PyObject *self, PyObject *args)
   } 
   arg3 = static_cast< std::vector< int >::difference_type >(val3);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_int_Sg____delslice__(arg1,SWIG_STD_MOVE(arg2),SWIG_STD_MOVE(arg3));
@@ -14479,6 +14674,10 @@ SWIGINTERN PyObject *_wrap_vectori___delitem____SWIG_0(PyObject *self, Py_ssize_
   } 
   arg2 = static_cast< std::vector< int >::difference_type >(val2);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_int_Sg____delitem____SWIG_0(arg1,SWIG_STD_MOVE(arg2));
@@ -14579,6 +14778,10 @@ SWIGINTERN PyObject *_wrap_vectori___setitem____SWIG_0(PyObject *self, Py_ssize_
     arg3 = ptr;
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_int_Sg____setitem____SWIG_0(arg1,arg2,(std::vector< int,std::allocator< int > > const &)*arg3);
@@ -14624,6 +14827,10 @@ SWIGINTERN PyObject *_wrap_vectori___setitem____SWIG_1(PyObject *self, Py_ssize_
     arg2 = (SWIGPY_SLICEOBJECT *) swig_obj[1];
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_int_Sg____setitem____SWIG_1(arg1,arg2);
@@ -14667,6 +14874,10 @@ SWIGINTERN PyObject *_wrap_vectori___delitem____SWIG_1(PyObject *self, Py_ssize_
     arg2 = (SWIGPY_SLICEOBJECT *) swig_obj[1];
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_int_Sg____delitem____SWIG_1(arg1,arg2);
@@ -14837,6 +15048,10 @@ SWIGINTERN PyObject *_wrap_vectori___setitem____SWIG_2(PyObject *self, Py_ssize_
   temp3 = static_cast< std::vector< int >::value_type >(val3);
   arg3 = &temp3;
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_int_Sg____setitem____SWIG_2(arg1,SWIG_STD_MOVE(arg2),(int const &)*arg3);
@@ -14879,6 +15094,10 @@ SWIGINTERN PyObject *_wrap_vectori___setitem____SWIG_3(PyObject *self, Py_ssize_
   } 
   arg2 = static_cast< std::vector< int >::difference_type >(val2);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         std_vector_Sl_int_Sg____setitem____SWIG_3(arg1,SWIG_STD_MOVE(arg2));
@@ -14976,6 +15195,10 @@ SWIGINTERN PyObject *_wrap_vectori_pop(PyObject *self, PyObject *args) {
   }
   arg1 = reinterpret_cast< std::vector< int > * >(argp1);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       try {
         result = (std::vector< int >::value_type)std_vector_Sl_int_Sg__pop(arg1);
@@ -15022,6 +15245,10 @@ SWIGINTERN PyObject *_wrap_vectori_append(PyObject *self, PyObject *args) {
   temp2 = static_cast< std::vector< int >::value_type >(val2);
   arg2 = &temp2;
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       std_vector_Sl_int_Sg__append(arg1,(int const &)*arg2);
     } catch (const std::invalid_argument& e) {
@@ -15188,6 +15415,10 @@ SWIGINTERN PyObject *_wrap_vectori_swap(PyObject *self, PyObject *args) {
   }
   arg2 = reinterpret_cast< std::vector< int > * >(argp2);
   {
+    if (am_python::BufferExported(arg1) || am_python::BufferExported(arg2)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->swap(*arg2);
     } catch (const std::invalid_argument& e) {
@@ -15346,6 +15577,10 @@ SWIGINTERN PyObject *_wrap_vectori_clear(PyObject *self, PyObject *args) {
   }
   arg1 = reinterpret_cast< std::vector< int > * >(argp1);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->clear();
     } catch (const std::invalid_argument& e) {
@@ -15438,6 +15673,10 @@ SWIGINTERN PyObject *_wrap_vectori_pop_back(PyObject *self, PyObject *args) {
   }
   arg1 = reinterpret_cast< std::vector< int > * >(argp1);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->pop_back();
     } catch (const std::invalid_argument& e) {
@@ -15476,6 +15715,10 @@ SWIGINTERN PyObject *_wrap_vectori_resize__SWIG_0(PyObject *self, Py_ssize_t nob
   } 
   arg2 = static_cast< std::vector< int >::size_type >(val2);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->resize(arg2);
     } catch (const std::invalid_argument& e) {
@@ -15521,6 +15764,10 @@ SWIGINTERN PyObject *_wrap_vectori_erase__SWIG_0(PyObject *self, Py_ssize_t nobj
     }
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       result = std_vector_Sl_int_Sg__erase__SWIG_0(arg1,SWIG_STD_MOVE(arg2));
     } catch (const std::invalid_argument& e) {
@@ -15581,6 +15828,10 @@ SWIGINTERN PyObject *_wrap_vectori_erase__SWIG_1(PyObject *self, Py_ssize_t nobj
     }
   }
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       result = std_vector_Sl_int_Sg__erase__SWIG_1(arg1,SWIG_STD_MOVE(arg2),SWIG_STD_MOVE(arg3));
     } catch (const std::invalid_argument& e) {
@@ -15744,6 +15995,10 @@ SWIGINTERN PyObject *_wrap_vectori_push_back(PyObject *self, PyObject *args) {
   temp2 = static_cast< std::vector< int >::value_type >(val2);
   arg2 = &temp2;
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->push_back((std::vector< int >::value_type const &)*arg2);
     } catch (const std::invalid_argument& e) {
@@ -15857,6 +16112,10 @@ SWIGINTERN PyObject *_wrap_vectori_assign(PyObject *self, PyObject *args) {
   temp3 = static_cast< std::vector< int >::value_type >(val3);
   arg3 = &temp3;
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->assign(arg2,(std::vector< int >::value_type const &)*arg3);
     } catch (const std::invalid_argument& e) {
@@ -15905,6 +16164,10 @@ SWIGINTERN PyObject *_wrap_vectori_resize__SWIG_1(PyObject *self, Py_ssize_t nob
   temp3 = static_cast< std::vector< int >::value_type >(val3);
   arg3 = &temp3;
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->resize(arg2,(std::vector< int >::value_type const &)*arg3);
     } catch (const std::invalid_argument& e) {
@@ -15989,6 +16252,10 @@ SWIGINTERN PyObject *_wrap_vectori_insert__SWIG_0(PyObject *self, Py_ssize_t nob
   temp3 = static_cast< std::vector< int >::value_type >(val3);
   arg3 = &temp3;
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       result = std_vector_Sl_int_Sg__insert__SWIG_0(arg1,SWIG_STD_MOVE(arg2),(int const &)*arg3);
     } catch (const std::invalid_argument& e) {
@@ -16052,6 +16319,10 @@ SWIGINTERN PyObject *_wrap_vectori_insert__SWIG_1(PyObject *self, Py_ssize_t nob
   temp4 = static_cast< std::vector< int >::value_type >(val4);
   arg4 = &temp4;
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       std_vector_Sl_int_Sg__insert__SWIG_1(arg1,SWIG_STD_MOVE(arg2),SWIG_STD_MOVE(arg3),(int const &)*arg4);
     } catch (const std::invalid_argument& e) {
@@ -16121,6 +16392,10 @@ SWIGINTERN PyObject *_wrap_vectori_reserve(PyObject *self, PyObject *args) {
   } 
   arg2 = static_cast< std::vector< int >::size_type >(val2);
   {
+    if (am_python::BufferExported(arg1)) {
+      PyErr_SetString(PyExc_BufferError, "cannot modify container while its buffer is exported");
+      SWIG_fail;
+    }
     try {
       (arg1)->reserve(arg2);
     } catch (const std::invalid_argument& e) {
@@ -17134,6 +17409,61 @@ fail:
 }
 
 
+SWIGINTERN PyObject *_wrap_SetNumThreads(PyObject *self, PyObject *args) {
+  PyObject *resultobj = 0;
+  int arg1 ;
+  int val1 ;
+  int ecode1 = 0 ;
+  PyObject *swig_obj[1] ;
+  
+  if (!args) SWIG_fail;
+  swig_obj[0] = args;
+  ecode1 = SWIG_AsVal_int(swig_obj[0], &val1);
+  if (!SWIG_IsOK(ecode1)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode1), "in method '" "SetNumThreads" "', argument " "1"" of type '" "int""'");
+  } 
+  arg1 = static_cast< int >(val1);
+  {
+    try {
+      am::SetNumThreads(arg1);
+    } catch (const std::invalid_argument& e) {
+      SWIG_exception(SWIG_ValueError, e.what());
+    } catch (const std::domain_error& e) {
+      SWIG_exception(SWIG_ValueError, e.what());
+    } catch (const std::exception& e) {
+      SWIG_exception(SWIG_RuntimeError, e.what());
+    }
+  }
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_GetNumThreads(PyObject *self, PyObject *args) {
+  PyObject *resultobj = 0;
+  int result;
+  
+  if (!SWIG_Python_UnpackTuple(args, "GetNumThreads", 0, 0, 0)) SWIG_fail;
+  {
+    try {
+      result = (int)am::GetNumThreads();
+    } catch (const std::invalid_argument& e) {
+      SWIG_exception(SWIG_ValueError, e.what());
+    } catch (const std::domain_error& e) {
+      SWIG_exception(SWIG_ValueError, e.what());
+    } catch (const std::exception& e) {
+      SWIG_exception(SWIG_RuntimeError, e.what());
+    }
+  }
+  resultobj = SWIG_From_int(static_cast< int >(result));
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
 static PyMethodDef SwigMethods[] = {
 	 { "TwiceValue", _wrap_TwiceValue, METH_O, "TwiceValue(HalfInt h) -> int"},
 	 { "IsInteger", _wrap_IsInteger, METH_O, "IsInteger(HalfInt h) -> bool"},
@@ -17193,6 +17523,8 @@ static PyMethodDef SwigMethods[] = {
 		"AngularMomentumRangeIntersection(pairi r1, HalfIntPair r2) -> HalfIntPair\n"
 		"AngularMomentumRangeIntersection(HalfIntPair r1, HalfIntPair r2) -> HalfIntPair\n"
 		""},
+	 { "SetNumThreads", _wrap_SetNumThreads, METH_O, "SetNumThreads(int num_threads)"},
+	 { "GetNumThreads", _wrap_GetNumThreads, METH_NOARGS, "GetNumThreads() -> int"},
 	 { NULL, NULL, 0, NULL }
 };
 
@@ -17668,8 +18000,8 @@ static PyHeapTypeObject SwigPyBuiltin__std__pairT_HalfInt_HalfInt_t_type = {
     (segcountproc) 0,                         /* bf_getsegcount */
     (charbufferproc) 0,                       /* bf_getcharbuffer */
 #endif
-    (getbufferproc) 0,                        /* bf_getbuffer */
-    (releasebufferproc) 0,                    /* bf_releasebuffer */
+    am_python::HalfIntPairGetBuffer,          /* bf_getbuffer */
+    am_python::ReleaseBuffer,                 /* bf_releasebuffer */
   },
     (PyObject *) 0,                           /* ht_name */
     (PyObject *) 0,                           /* ht_slots */
@@ -17956,8 +18288,8 @@ static PyHeapTypeObject SwigPyBuiltin__std__vectorT_HalfInt_t_type = {
     (segcountproc) 0,                         /* bf_getsegcount */
     (charbufferproc) 0,                       /* bf_getcharbuffer */
 #endif
-    (getbufferproc) 0,                        /* bf_getbuffer */
-    (releasebufferproc) 0,                    /* bf_releasebuffer */
+    am_python::HalfIntVectorGetBuffer,        /* bf_getbuffer */
+    am_python::ReleaseBuffer,                 /* bf_releasebuffer */
   },
     (PyObject *) 0,                           /* ht_name */
     (PyObject *) 0,                           /* ht_slots */
@@ -18476,8 +18808,8 @@ static PyHeapTypeObject SwigPyBuiltin__std__pairT_int_int_t_type = {
     (segcountproc) 0,                         /* bf_getsegcount */
     (charbufferproc) 0,                       /* bf_getcharbuffer */
 #endif
-    (getbufferproc) 0,                        /* bf_getbuffer */
-    (releasebufferproc) 0,                    /* bf_releasebuffer */
+    am_python::PairIntGetBuffer,              /* bf_getbuffer */
+    am_python::ReleaseBuffer,                 /* bf_releasebuffer */
   },
     (PyObject *) 0,                           /* ht_name */
     (PyObject *) 0,                           /* ht_slots */
@@ -18764,8 +19096,8 @@ static PyHeapTypeObject SwigPyBuiltin__std__vectorT_int_t_type = {
     (segcountproc) 0,                         /* bf_getsegcount */
     (charbufferproc) 0,                       /* bf_getcharbuffer */
 #endif
-    (getbufferproc) 0,                        /* bf_getbuffer */
-    (releasebufferproc) 0,                    /* bf_releasebuffer */
+    am_python::VectorIntGetBuffer,            /* bf_getbuffer */
+    am_python::ReleaseBuffer,                 /* bf_releasebuffer */
   },
     (PyObject *) 0,                           /* ht_name */
     (PyObject *) 0,                           /* ht_slots */
@@ -19491,6 +19823,31 @@ SWIG_init(void) {
   PyModule_AddObject(m, "vectori", (PyObject *)builtin_pytype);
   SwigPyBuiltin_AddPublicSymbol(public_interface, "vectori");
   d = md;
+  
+  import_array();
+  import_umath();
+  {
+    PyObject* halfint_type = PyObject_GetAttrString(m, "HalfInt");
+    if (!halfint_type)
+      return NULL;
+    int status = am_python::RegisterHalfIntDType(
+        m, public_interface, reinterpret_cast<PyTypeObject*>(halfint_type)
+      );
+    if (status==0)
+      status = am_python::InstallFastCallFunctions(m, reinterpret_cast<PyTypeObject*>(halfint_type));
+    Py_DECREF(halfint_type);
+    if (status<0)
+      return NULL;
+  }
+  if (am_python::AddNumPyFunctions(m, public_interface)<0)
+    return NULL;
+  if (am_python::AddSymbolCacheFunctions(m, public_interface)<0)
+    return NULL;
+  if (am_python::AddBuilderFunctions(m, public_interface)<0)
+    return NULL;
+  if (am_python::InstallPickleSupport(m)<0)
+    return NULL;
+  
 #if PY_VERSION_HEX >= 0x03000000
   return m;
 #else
@@ -5,13 +5,51 @@ setup.py file for am SWIG wrapper
 """
 
 from distutils.core import setup, Extension
+from distutils.command.build_ext import build_ext
+import os
+
+# SWIG options for generating am_wrap.cpp from am.i (see am.i)
+SWIG_OPTS = ['-python', '-c++', '-cppext', 'cpp', '-builtin', '-fastdispatch', '-py3']
+
+
+class am_build_ext(build_ext):
+    """Build extension against NumPy, optionally from freshly generated wrapper.
+
+    The NumPy include directory is found at build time, so that NumPy is only
+    needed for building.  With --regenerate-wrapper, the wrapper is generated
+    from python/am.i with SWIG into the build directory and compiled in place
+    of the committed python/am_wrap.cpp, which is left untouched.
+    """
+
+    user_options = build_ext.user_options + [
+        ('regenerate-wrapper', None, "generate wrapper from python/am.i with SWIG, into build directory"),
+    ]
+    boolean_options = build_ext.boolean_options + ['regenerate-wrapper']
+
+    def initialize_options(self):
+        build_ext.initialize_options(self)
+        self.regenerate_wrapper = False
+
+    def build_extension(self, ext):
+        import numpy
+        ext.include_dirs = ext.include_dirs + [numpy.get_include()]
+        if self.regenerate_wrapper:
+            self.mkpath(self.build_temp)
+            wrapper = os.path.join(self.build_temp, 'am_wrap.cpp')
+            self.spawn(
+                [self.swig or 'swig'] + SWIG_OPTS
+                + ['-I.', '-o', wrapper, '-outdir', self.build_temp, os.path.join('python', 'am.i')]
+            )
+            ext.sources = [wrapper]
+        build_ext.build_extension(self, ext)
 
 
 am_module = Extension(
     '_am',
     sources=['python/am_wrap.cpp'],
     libraries=['gsl', 'gslcblas', 'm'],
-    extra_compile_args=['-std=c++17', '-g', '-O2', '-DAM_EXCEPTIONS', '-I.']
+    extra_compile_args=['-std=c++17', '-g', '-O2', '-DAM_EXCEPTIONS', '-DAM_THREAD_POOL', '-pthread', '-I.'],
+    extra_link_args=['-pthread']
 )
 
 # Package install debugging
@@ -47,5 +85,6 @@ setup (name = 'am',
        author      = "Patrick J. Fasano",
        description = """Angular Momentum library""",
        ext_modules = [am_module],
+       cmdclass = {'build_ext': am_build_ext},
        py_modules = ["am"],
        )
@@ -0,0 +1,75 @@
+""" Benchmark per-call overhead of scalar am functions, fast-call path vs. SWIG wrapper.
+
+    Uses pyperf if available (run with --help for pyperf options), and
+    otherwise reports pyperf-style statistics (mean +- standard deviation
+    over several runs) from timeit.
+
+    Language: Python 3
+
+    University of Notre Dame
+
+    10/18/26: Created.
+
+"""
+
+import statistics
+import sys
+import timeit
+
+import _am
+import am
+
+# benchmark cases: (name, function name, arguments)
+h = am.HalfInt
+CASES = [
+    ("Wigner3J(HalfInt)", "Wigner3J", (h(1,2), h(1,2), h(1), h(1,2), h(-1,2), h(0))),
+    ("Wigner3J(int)", "Wigner3J", (1, 1, 2, 1, -1, 0)),
+    ("ClebschGordan(float)", "ClebschGordan", (0.5, 0.5, 0.5, -0.5, 1, 0)),
+    ("Wigner6J(int)", "Wigner6J", (1, 1, 1, 1, 1, 1)),
+    ("Wigner6J(HalfInt)", "Wigner6J", (h(3,2), h(1), h(1,2), h(1,2), h(1), h(3,2))),
+    ("Wigner9J(int)", "Wigner9J", (1, 1, 1, 1, 1, 1, 1, 1, 1)),
+]
+
+def swig_arguments(arguments):
+    """ Convert arguments to form accepted by SWIG wrapper (HalfInt for floats).
+    """
+    return tuple(h(int(2*a),2) if isinstance(a, float) else a for a in arguments)
+
+def time_per_call(function, arguments, loops, runs):
+    """ Time function call, returning per-call times (s) for each run.
+    """
+    timer = timeit.Timer("function(*arguments)", globals={"function": function, "arguments": arguments})
+    timer.timeit(loops)  # warmup
+    return [timer.timeit(loops)/loops for run in range(runs)]
+
+def format_time(seconds):
+    return "{:.0f} ns".format(seconds*1e9)
+
+def main_timeit(loops=100000, runs=10):
+    print("{:24s} {:>20s} {:>20s} {:>8s}".format("case", "swig", "fastcall", "speedup"))
+    for (label, name, arguments) in CASES:
+        swig = time_per_call(_am._swig_functions[name], swig_arguments(arguments), loops, runs)
+        fast = time_per_call(getattr(am, name), arguments, loops, runs)
+        print("{:24s} {:>20s} {:>20s} {:>7.1f}x".format(
+            label,
+            "{} +- {}".format(format_time(statistics.mean(swig)), format_time(statistics.stdev(swig))),
+            "{} +- {}".format(format_time(statistics.mean(fast)), format_time(statistics.stdev(fast))),
+            statistics.mean(swig)/statistics.mean(fast)
+        ))
+
+def main_pyperf(pyperf):
+    runner = pyperf.Runner()
+    for (label, name, arguments) in CASES:
+        runner.bench_func("swig "+label, _am._swig_functions[name], *swig_arguments(arguments))
+        runner.bench_func("fastcall "+label, getattr(am, name), *arguments)
+
+if (__name__=="__main__"):
+
+    try:
+        import pyperf
+    except ImportError:
+        pyperf = None
+    if pyperf is not None:
+        main_pyperf(pyperf)
+    else:
+        main_timeit()
@@ -0,0 +1,238 @@
+""" Test NumPy extensions to am Python module, against scalar functions.
+
+    Language: Python 3
+
+    University of Notre Dame
+
+    10/18/26: Created.
+
+"""
+
+import os
+import pickle
+import tempfile
+import threading
+
+import numpy as np
+
+import am
+
+def scalar_values(function, twice_values):
+    """ Evaluate scalar am function over broadcast twice-value arrays.
+    """
+    arrays = np.broadcast_arrays(*twice_values)
+    result = np.empty(arrays[0].shape)
+    for index in np.ndindex(result.shape):
+        result[index] = function(*[am.HalfInt(int(array[index]),2) for array in arrays])
+    return result
+
+def container_mutators(make, item):
+    """ Calls of each container method which may reallocate storage, and so
+    must be locked (am.i %am_buffer_lock) while the storage is exported.
+    """
+    return [
+        ("append", lambda c: c.append(item)),
+        ("pop", lambda c: c.pop()),
+        ("push_back", lambda c: c.push_back(item)),
+        ("pop_back", lambda c: c.pop_back()),
+        ("resize", lambda c: c.resize(100)),
+        ("reserve", lambda c: c.reserve(100)),
+        ("insert", lambda c: c.insert(c.begin(), item)),
+        ("erase", lambda c: c.erase(c.begin())),
+        ("assign", lambda c: c.assign(100, item)),
+        ("clear", lambda c: c.clear()),
+        ("__setitem__", lambda c: c.__setitem__(slice(0, 1), make([item, item]))),
+        ("__delitem__", lambda c: c.__delitem__(0)),
+        ("__setslice__", lambda c: c.__setslice__(0, 1, make([item, item]))),
+        ("__delslice__", lambda c: c.__delslice__(0, 1)),
+        ("swap", lambda c: c.swap(make([item]))),
+        ("swap (argument)", lambda c: make([item]).swap(c)),
+    ]
+
+if (__name__=="__main__"):
+
+    # vectorized coefficients vs. scalar coefficients
+    print("vectorized coefficients")
+    rng = np.random.default_rng(42)
+    two_j = 2*rng.integers(0, 6, size=(40, 6))
+    cases = [
+        ("Wigner6J", am.Wigner6J, am.Wigner6J2Array, [two_j[:,i] for i in range(6)]),
+        ("Unitary6J", am.Unitary6J, am.Unitary6J2Array, [two_j[:,i] for i in range(6)]),
+        (
+            "ClebschGordan", am.ClebschGordan, am.ClebschGordan2Array,
+            [np.arange(1,10,2)[:,None], 1, 1, 1, np.arange(0,12,2)[None,:], 2]
+        ),
+        (
+            "RacahReductionFactor1Rose", am.RacahReductionFactor1Rose, am.RacahReductionFactor1Rose2Array,
+            [2, 1, np.array([1,3]), 2, 1, np.array([[1],[3]]), 2]
+        ),
+    ]
+    for (name, scalar_function, vectorized_function, arguments) in cases:
+        expected = scalar_values(scalar_function, arguments)
+        result = vectorized_function(*arguments, num_threads=2)
+        print("{}: shape {} max deviation {}".format(name, result.shape, np.abs(result-expected).max()))
+
+    # argument forms (j values as floats, ints, HalfInt, or twice-values)
+    print("argument forms")
+    print(am.Wigner3JArray(1, 1, 0, 0, 0, 0))
+    print(am.Wigner3JArray([0.5, 1.5], 0.5, 1, 0.5, -0.5, 0))
+    print(am.Wigner3JArray([am.HalfInt(1,2), am.HalfInt(3,2)], am.HalfInt(1,2), 1, am.HalfInt(1,2), am.HalfInt(-1,2), 0))
+    print(am.Wigner3J2Array(np.array([1, 3], dtype=np.int32), 1, 2, 1, -1, 0))
+
+    # HalfInt dtype
+    print("HalfInt dtype")
+    j = np.array([am.HalfInt(1,2), 1, 1.5, 0], dtype=am.HalfIntDType)
+    print(j, j[0])
+    j = np.arange(0, 8, dtype=np.int32).view(am.HalfIntDType)
+    print(j+am.HalfInt(1,2), j-1, 3*j, abs(-j))
+    print(j==1, j<am.HalfInt(3,2), np.maximum(j, 1))
+    print(am.IsIntegerArray(j), am.TwiceValueArray(j), am.HatArray(j))
+    with np.errstate(invalid="ignore"):
+        print(am.ParitySignArray(j), np.array([0.5, 2.25]).astype(am.HalfIntDType))
+    print(j.astype(float), np.sort(j[::-1])[:3], j.max())
+    # selection rule mask: triangle(j1,j2,1) over label table
+    j1, j2 = j[:,None], j[None,:]
+    mask = (abs(j1-j2)<=1) & (j1+j2>=1) & am.IsIntegerArray(j1+j2)
+    print(np.count_nonzero(mask), all(
+        mask[a,b]==am.AllowedTriangle(j[a],j[b],1) for a in range(len(j)) for b in range(len(j))
+    ))
+    print(am.Wigner6JArray(j[2::2], j[2::2], 1, 1, 1, 1))
+
+    # buffer protocol
+    print("buffer protocol")
+    v = am.HalfIntVector([am.HalfInt(1,2), am.HalfInt(3,2), am.HalfInt(2)])
+    view = memoryview(v)
+    print(view.format, view.itemsize, view.tolist())
+    a = np.asarray(v)
+    print(a, a.view(am.HalfIntDType))
+    a[0] = 7  # writes through to container
+    print(v[0])
+    try:
+        v.append(am.HalfInt(1))
+    except BufferError as e:
+        print("Expect error: {}".format(e))
+    view.release()
+    del a
+    v.append(am.HalfInt(5,2))  # lock released
+    print(list(v))
+    for (make, item) in [(am.HalfIntVector, am.HalfInt(1,2)), (am.vectori, 1)]:
+        unlocked = []
+        for (name, mutate) in container_mutators(make, item):
+            container = make([item, item, item])
+            view = memoryview(container)
+            try:
+                mutate(container)
+                unlocked.append(name)
+            except BufferError:
+                pass
+            view.release()
+            mutate(container)  # lock released
+        print(make.__name__, "unlocked while exported:", unlocked, "(expect [])")
+        if unlocked:
+            raise RuntimeError("{} methods {} not locked while buffer is exported".format(make.__name__, unlocked))
+    print(np.asarray(am.vectori([1, 2, 3])), np.asarray(am.pairi(3, 4)))
+    print(np.asarray(am.HalfIntPair(am.HalfInt(1,2), am.HalfInt(5))).view(am.HalfIntDType))
+
+    # pickling
+    print("pickling")
+    for protocol in [2, 4, 5]:
+        print(protocol, list(pickle.loads(pickle.dumps(v, protocol=protocol))))
+    buffers = []
+    data = pickle.dumps([v, am.vectori([1, 2, 3]), am.pairi(3, 4)], protocol=5, buffer_callback=buffers.append)
+    print(len(buffers), [memoryview(container).tolist() for container in pickle.loads(data, buffers=buffers)])
+    del buffers
+    print(np.asarray(pickle.loads(pickle.dumps(am.HalfIntPair(am.HalfInt(1,2), am.HalfInt(5))))).view(am.HalfIntDType))
+
+    # thread control and concurrent callers (GIL released during evaluation)
+    print("threads")
+    default_num_threads = am.GetNumThreads()
+    am.SetNumThreads(2)
+    print(am.GetNumThreads())
+    two_j = 2*rng.integers(0, 8, size=(6, 10000))
+    expected = am.Wigner6J2Array(*two_j, num_threads=1)
+    results = [None]*4
+    def evaluate(index):
+        results[index] = am.Wigner6J2Array(*two_j)
+    threads = [threading.Thread(target=evaluate, args=(index,)) for index in range(len(results))]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    print(all(np.array_equal(result, expected) for result in results))
+    am.SetNumThreads(0)
+    print(am.GetNumThreads()==default_num_threads)
+
+    # symbol caches
+    print("symbol caches")
+    two_j = 2*rng.integers(0, 4, size=(6, 200))
+    expected = scalar_values(am.Wigner6J, list(two_j))
+    am.SymbolCacheWarm("Wigner6J", 3)
+    print(np.abs(am.Wigner6J2Array(*two_j)-expected).max())
+    with tempfile.TemporaryDirectory() as directory:
+        filename = os.path.join(directory, "wigner6j.bin")
+        am.SymbolCacheSave("Wigner6J", filename)
+        am.SymbolCacheClear("Wigner6J")
+        am.SymbolCacheAttach("Wigner6J", filename)
+        print(np.abs(am.Wigner6J2Array(*two_j)-expected).max(), am.Wigner6J(1, 1, 1, 1, 1, 1))
+        info = am.SymbolCacheInfo("Wigner6J")
+        print(info["mapped_size"], info["local_size"], info["hits"]>0, info["misses"])
+        am.SymbolCacheDetach("Wigner6J")
+    am.SymbolCacheClear("Wigner6J")
+    am.SymbolCacheEnable("Wigner6J", False)
+
+    # table builders
+    print("table builders")
+    h = am.HalfInt
+    matrix = am.ClebschGordanMatrix(1, h(3,2))
+    expected = np.zeros(matrix.shape)
+    column = 0
+    for two_J in range(1, 6, 2):
+        for two_M in range(-two_J, two_J+1, 2):
+            for (i1, two_m1) in enumerate(range(-2, 3, 2)):
+                for (i2, two_m2) in enumerate(range(-3, 4, 2)):
+                    if (two_m1+two_m2==two_M):
+                        expected[i1*4+i2,column] = am.ClebschGordan(1, h(two_m1,2), h(3,2), h(two_m2,2), h(two_J,2), h(two_M,2))
+            column += 1
+    print(matrix.shape, np.abs(matrix-expected).max(), np.abs(matrix@matrix.T-np.eye(12)).max())
+    betas = np.linspace(0, np.pi, 12).reshape(3, 4)
+    d = am.WignerSmallDArray(h(3,2), betas)
+    print(d.shape, np.abs(np.einsum("...ij,...kj->...ik", d, d)-np.eye(4)).max())
+    print(np.abs(am.WignerSmallDArray(1, betas)[...,1,1]-np.cos(betas)).max())
+    table = am.SphericalHarmonicCRMEArray(4)
+    expected = np.array([
+        [[am.SphericalHarmonicCRME(lp, l, k) if am.AllowedTriangle(lp, k, l) else 0. for k in range(9)] for l in range(5)]
+        for lp in range(5)
+    ])
+    print(table.shape, np.abs(table-expected).max())
+    table = am.LJCoupledSphericalHarmonicCRMEArray(2, 2)
+    print(table.shape, table[2,1,1,0,2]-am.LJCoupledSphericalHarmonicCRME(2, h(5,2), 1, h(1,2), 2))
+    states = np.array([[1, 1, 0], [1, 1, 1], [1, 1, 2], [0.5, 1.5, 1], [1, 2, 2]])
+    for (function, matrix_function, operator) in [
+            (am.RacahReductionFactor1Rose, am.RacahReductionFactor1RoseMatrix, (1,)),
+            (am.RacahReductionFactor2Rose, am.RacahReductionFactor2RoseMatrix, (1,)),
+            (am.RacahReductionFactor12Rose, am.RacahReductionFactor12RoseMatrix, (1, 1, 1)),
+    ]:
+        expected = np.zeros((len(states), len(states)))
+        for (bra, bra_state) in enumerate(states):
+            for (ket, ket_state) in enumerate(states):
+                try:
+                    expected[bra,ket] = function(*[h(int(2*j),2) for j in bra_state], *[h(int(2*j),2) for j in ket_state], *operator)
+                except ValueError:
+                    pass
+        print(np.abs(matrix_function(states, states, *operator, num_threads=2)-expected).max())
+
+    # errors
+    print("errors")
+    for arguments in [(0.25, 1, 1, 1, 1, 1), ([1, 1], [1, 1, 1], 1, 1, 1, 1), (1, 1, 1)]:
+        try:
+            am.Wigner6JArray(*arguments)
+        except (ValueError, TypeError) as e:
+            print("Expect error: {}".format(e))
+    try:
+        am.RacahReductionFactorRose2Array(2, 2, 2, 2, 2, [4, 8])
+    except ValueError as e:
+        print("Expect error: {}".format(e))
+    try:
+        am.RacahReductionFactor1RoseMatrix([[1, 1]], [[1, 1, 1]], 1)
+    except ValueError as e:
+        print("Expect error: {}".format(e))
@@ -6,10 +6,13 @@
 
 ******************************************************************************/
 
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
 #include "am/am.h"
+#include "am/factor_table.h"
 #include "am/halfint.h"
 #include "am/wigner_gsl.h"
 
@@ -36,6 +39,24 @@ int main(int argc, char **argv)
   std::cout << am::ProductAngularMomentumRange(2,HalfInt(3,2)) << std::endl;
   std::cout << "****" << std::endl;
 
+  // angular momentum product views
+  std::cout << "product angular momenta view" << std::endl;
+  constexpr auto view = am::ProductAngularMomentaView(2,HalfInt(3,2));
+  static_assert(view.size()==4);
+  static_assert(view[3]==HalfInt(7,2));
+  for (HalfInt J : view)
+    std::cout << J << " ";
+  std::cout << std::endl;
+  for (int L : am::ProductAngularMomentaView(3,2,0))
+    std::cout << L << " ";
+  std::cout << std::endl;
+  for (int L : am::ProductAngularMomentaView(3,2,1))
+    std::cout << L << " ";
+  std::cout << std::endl;
+  std::cout << am::ProductAngularMomentaView(HalfInt(1,2),HalfInt(3,2),1).size() << " "
+            << am::ProductAngularMomentaView(HalfInt(1,2),HalfInt(3,2),0).size() << std::endl;
+  std::cout << "****" << std::endl;
+
   // angular momentum range arithmetic
   std::cout << "range intersection" << std::endl;
   constexpr HalfInt::pair r1(1,5);
@@ -51,6 +72,42 @@ int main(int argc, char **argv)
   std::cout << r1x << r2x << "->" << rx << std::endl;
   std::cout << "****" << std::endl;
 
+  // angular momentum intervals
+  std::cout << "angular momentum intervals" << std::endl;
+  {
+    constexpr am::AMInterval even_l(0,6,2), odd_l(1,7,2), integer(1,3), half(HalfInt(1,2),HalfInt(7,2));
+    static_assert(am::AMIntervalIntersection(even_l,odd_l).empty());
+    static_assert(am::AMIntervalIntersection(integer,half).empty());
+    static_assert(am::AMIntervalIntersection(even_l,integer)==am::AMInterval(2));
+    static_assert(am::AMIntervalUnion(even_l,odd_l)==am::AMInterval(0,7));
+    static_assert(am::AMIntervalCoupling(even_l,am::AMInterval(0))==even_l);
+    static_assert(am::AMIntervalCoupling(am::AMInterval(4,6,2),am::AMInterval(1))==am::AMInterval(3,7));
+    static_assert(am::AMIntervalCoupling(even_l,odd_l)==am::AMInterval(1,13));
+    static_assert(am::AMIntervalCoupling(am::AMInterval(0,4,2),am::AMInterval(1,3,2))==am::AMInterval(1,7));
+    static_assert(am::AMIntervalCoupling(integer,half)==am::AMInterval(HalfInt(1,2),HalfInt(13,2)));
+    for (HalfInt j : am::AMIntervalCoupling(half,am::AMInterval(HalfInt(1,2))).values())
+      std::cout << " " << j;
+    std::cout << std::endl;
+    try
+      {
+        am::AMIntervalUnion(integer,half);
+      }
+    catch (const std::invalid_argument& e)
+      {
+        std::cout << "Expect error: " << e.what() << std::endl;
+      }
+    for (int step : {0,-1,3})
+      try
+        {
+          am::AMInterval(0,6,step);
+        }
+      catch (const std::invalid_argument& e)
+        {
+          std::cout << "Expect error: " << e.what() << std::endl;
+        }
+  }
+  std::cout << "****" << std::endl;
+
   // GSL coupling tests
   std::cout << "Wigner 3-J: Expect 0.276026..." << std::endl;
   std::cout << am::Wigner3J(2, HalfInt(3,2), HalfInt(5,2), +2, -HalfInt(1,2), -HalfInt(3,2)) << std::endl;
@@ -66,6 +123,21 @@ int main(int argc, char **argv)
   std::cout << am::Unitary9J(6,3,7,4,5,3,9,8,10) << std::endl;
   std::cout << "****" << std::endl;
 
+  // factor tables
+  std::cout << "factor tables: Expect 0 mismatches" << std::endl;
+  {
+    int mismatches = 0;
+    for (int two_j=0; two_j<20000; ++two_j)
+      {
+        const HalfInt j(two_j,2);
+        mismatches += (am::TabulatedHat(j)!=Hat(j));
+        mismatches += (am::TabulatedInverseHat(j)!=1/Hat(j));
+        mismatches += (am::TabulatedSqrtJJ1(j)!=std::sqrt(double(j)*double(j+1)));
+      }
+    std::cout << mismatches << std::endl;
+  }
+  std::cout << "****" << std::endl;
+
   // termination
   return 0;
 }
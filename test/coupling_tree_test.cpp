@@ -0,0 +1,167 @@
+/******************************************************************************
+  coupling_tree_test.cpp
+
+  Tests am::CouplingTree enumeration against nested loops over
+  ProductAngularMomenta, and times both.  Tests J multiplicities from
+  multiplicity.h against CouplingTree counts.
+
+  Usage: coupling_tree_test [two_j]
+
+  University of Notre Dame
+
+******************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "am/am.h"
+#include "am/coupling_tree.h"
+#include "am/halfint.h"
+#include "am/multiplicity.h"
+
+// iterators and chunks are not available from temporary CouplingTreeStates
+template<typename T, typename = void>
+struct HasChunk : std::false_type {};
+template<typename T>
+struct HasChunk<T, std::void_t<decltype(std::declval<T>().Chunk(0,1))>> : std::true_type {};
+static_assert(HasChunk<const am::CouplingTreeStates&>::value);
+static_assert(!HasChunk<am::CouplingTreeStates&&>::value);
+
+int main(int argc, char **argv)
+{
+  const int two_j = (argc>1) ? std::stoi(argv[1]) : 15;
+  const HalfInt j(two_j,2);
+
+  // small sequential and pairwise trees
+  std::cout << "sequential tree, j=(1/2,1,3/2), J=1" << std::endl;
+  const HalfInt::vector leaves3{HalfInt(1,2), 1, HalfInt(3,2)};
+  for (const auto& state : am::CouplingTree::Sequential(3).States(leaves3, 1))
+    std::cout << "  J12 " << state.J(3) << std::endl;
+  std::cout << "pairwise tree, j=(1,1,1,1), J=1" << std::endl;
+  const am::CouplingTree pairwise = am::CouplingTree::Pairwise(4);
+  for (const auto& state : pairwise.States({1,1,1,1}, 1))
+    std::cout << "  J12 " << state.J(4) << " J34 " << state.J(5) << std::endl;
+  std::cout << "Expect 1 state for single leaf with j=J: "
+            << am::CouplingTree::Sequential(1).Count({HalfInt(5,2)}, HalfInt(5,2)) << std::endl;
+  std::cout << "Expect 0 states for single leaf with j!=J: "
+            << am::CouplingTree::Sequential(1).Count({HalfInt(1,2)}, HalfInt(5,2)) << " "
+            << am::CouplingTree::Sequential(1).Count({HalfInt(5,2)}, HalfInt(1,2)) << std::endl;
+  for (const auto& state : am::CouplingTree::Sequential(1).States({HalfInt(5,2)}, HalfInt(5,2)))
+    std::cout << "  J " << state.J(0) << std::endl;
+  {
+    const am::CouplingTreeStates states = am::CouplingTree::Sequential(1).States({HalfInt(1,2)}, HalfInt(5,2));
+    std::cout << "Expect 0 states iterated: " << std::distance(states.begin(), states.end()) << std::endl;
+  }
+  {
+    const am::CouplingTreeStates states = am::CouplingTree::Sequential(3).States(leaves3, 1);
+    for (const auto& [k, num_chunks] : std::vector<std::pair<std::size_t,std::size_t>>{{0,0},{2,2}})
+      try
+        {
+          states.Chunk(k, num_chunks);
+        }
+      catch (const std::invalid_argument& e)
+        {
+          std::cout << "Expect error: " << e.what() << std::endl;
+        }
+  }
+
+  // five-fold sequential coupling against nested loops
+  const HalfInt::vector leaves(5, j);
+  const am::CouplingTree tree = am::CouplingTree::Sequential(5);
+  for (const HalfInt& J : {HalfInt(1,2), HalfInt(3*two_j/2-1,2), HalfInt(5*two_j,2)})
+    {
+      auto start = std::chrono::steady_clock::now();
+      std::vector<HalfInt::vector> nested;
+      for (HalfInt J12 : am::ProductAngularMomenta(j,j))
+        for (HalfInt J123 : am::ProductAngularMomenta(J12,j))
+          for (HalfInt J1234 : am::ProductAngularMomenta(J123,j))
+            if (am::AllowedTriangle(J1234,j,J))
+              nested.push_back({J12,J123,J1234});
+      auto nested_time = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+
+      start = std::chrono::steady_clock::now();
+      am::CouplingTreeStates states = tree.States(leaves, J);
+      const std::uint64_t count = states.size();
+      auto count_time = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+
+      start = std::chrono::steady_clock::now();
+      bool ok = (count==nested.size());
+      std::size_t i = 0;
+      for (const auto& state : states)
+        {
+          ok &= (i<nested.size()) && (state.J(5)==nested[i][0]) && (state.J(6)==nested[i][1])
+            && (state.J(7)==nested[i][2]) && (state.J(8)==J);
+          ++i;
+        }
+      ok &= (i==nested.size());
+      auto iterate_time = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+
+      // chunks reproduce full enumeration
+      const std::size_t num_chunks = 7;
+      std::size_t position = 0;
+      for (std::size_t k=0; k<num_chunks; ++k)
+        for (const auto& state : states.Chunk(k, num_chunks))
+          {
+            ok &= (state.J(5)==nested[position][0]) && (state.J(7)==nested[position][2]);
+            ++position;
+          }
+      ok &= (position==nested.size());
+
+      // intermediate angular momenta lie within propagated intervals
+      const std::vector<am::AMInterval> intervals
+        = tree.PropagateIntervals(std::vector<am::AMInterval>(5, am::AMInterval(j)), am::AMInterval(J));
+      for (const auto& state : states)
+        for (std::size_t node=0; node<tree.num_nodes(); ++node)
+          ok &= intervals[node].Contains(state.J(node));
+
+      std::cout << "J " << J << " states " << count << " " << (ok ? "OK" : "FAILED")
+                << " nested " << nested_time << " s, count " << count_time
+                << " s, iterate " << iterate_time << " s" << std::endl;
+    }
+
+  // pruning by propagated selection rules: orbital angular momenta l1,l2,l3
+  // of even parity coupled to L=17
+  std::cout << "propagated intervals, l=(0,2,4,6), L=17:";
+  const std::vector<am::AMInterval> even_intervals = am::CouplingTree::Sequential(3).PropagateIntervals(
+      std::vector<am::AMInterval>(3, am::AMInterval(0,6,2)), am::AMInterval(17)
+    );
+  for (const am::AMInterval& interval : even_intervals)
+    std::cout << " [" << interval.min() << "," << interval.max() << "/" << interval.step() << "]";
+  std::cout << std::endl;
+
+  // count without enumeration, beyond reach of nested loops
+  const HalfInt::vector many(12, j);
+  auto start = std::chrono::steady_clock::now();
+  const std::uint64_t count = am::CouplingTree::Sequential(12).Count(many, 1);
+  auto time = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+  std::cout << "12-fold coupling, J=1: " << count
+            << " states, " << time << " s" << std::endl;
+
+  // multiplicities from M distribution
+  start = std::chrono::steady_clock::now();
+  const am::AngularMomentumMultiplicities<> multiplicities = am::ProductAngularMomentumMultiplicities(many);
+  time = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+  bool ok = true;
+  for (HalfInt J=multiplicities.J_min; J<=multiplicities.J_max(); ++J)
+    ok &= (multiplicities(J)==am::CouplingTree::Pairwise(12).Count(many, J));
+  std::cout << "12-fold multiplicities " << (ok ? "OK" : "FAILED") << ", "
+            << time << " s, dimension " << multiplicities.total_dimension() << std::endl;
+  std::cout << "(7/2)^4: Expect J=0 2 2 4 4 5 6 8" << std::endl;
+  const am::AngularMomentumMultiplicities<> fermions = am::FermionAngularMomentumMultiplicities(HalfInt(7,2), 4);
+  for (HalfInt J=fermions.J_min; J<=fermions.J_max(); ++J)
+    for (std::uint64_t i=0; i<fermions(J); ++i)
+      std::cout << " " << J;
+  std::cout << std::endl;
+  start = std::chrono::steady_clock::now();
+  const am::AngularMomentumMultiplicities<> shell = am::FermionAngularMomentumMultiplicities(HalfInt(63,2), 16);
+  time = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+  std::cout << "(63/2)^16: J=0 multiplicity " << shell(0) << ", dimension " << shell.total_dimension()
+            << ", " << time << " s" << std::endl;
+}
@@ -8,6 +8,7 @@
 ******************************************************************************/
 
 #include <string>
+#include <string_view>
 #include <algorithm>
 
 #include "fmt/format.h"
@@ -53,11 +54,84 @@ int main(int argc, char **argv)
   }
   std::cout << "****" << std::endl;
 
+  // character conversion
+  std::cout << "character conversion: Expect 3 3/2 -1/2 -0.5 1.5 3.0" << std::endl;
+  {
+    char buffer[kHalfIntMaxChars];
+    for (const auto& [h, presentation] : std::vector<std::pair<HalfInt,char>>{
+        {3,'g'}, {HalfInt(3,2),'g'}, {HalfInt(-1,2),'g'}, {HalfInt(-1,2),'f'}, {HalfInt(3,2),'f'}, {3,'f'}
+      })
+      {
+        std::to_chars_result result = to_chars(buffer, buffer+kHalfIntMaxChars, h, presentation);
+        std::cout << std::string_view(buffer, result.ptr-buffer) << " ";
+      }
+    std::cout << std::endl;
+    std::cout << "extremes " << std::numeric_limits<int>::min() << "/2 -> " << HalfInt(std::numeric_limits<int>::min(),2)
+              << " " << fmt::format("{:f}", HalfInt(std::numeric_limits<int>::min(),2)) << std::endl;
+  }
+  std::cout << "parsing: Expect 3 3/2 -3/2 3/2 -1/2 2 1 [invalid] [invalid] [invalid] [out of range]"
+            << " -2147483648/2 [out of range] [out of range]" << std::endl;
+  for (std::string_view text : {
+      "3", "3/2", "-3/2", "1.5", "-0.50", "4/2", "1/1", "1.3", "3/4", "-x", "3000000000",
+      "-2147483648/2", "2147483648/2", "-2147483649/2"
+    })
+    {
+      HalfInt h;
+      std::from_chars_result result = from_chars(text.data(), text.data()+text.size(), h);
+      if (result.ec==std::errc::invalid_argument)
+        std::cout << "[invalid] ";
+      else if (result.ec==std::errc::result_out_of_range)
+        std::cout << "[out of range] ";
+      else
+        std::cout << h << " ";
+    }
+  std::cout << std::endl;
+  std::cout << "stream input: Expect (1/2,7/2) 5 fail" << std::endl;
+  {
+    std::istringstream input("  1/2 3.5 5 3/4");
+    HalfInt a, b, c, d;
+    input >> a >> b >> c;
+    std::cout << HalfInt::pair(a,b) << " " << c << " ";
+    input >> d;
+    std::cout << (input.fail() ? "fail" : "ok") << std::endl;
+  }
+  std::cout << "roundtrip through to_chars and from_chars" << std::endl;
+  {
+    // values near zero, and at extremes of twice-value range
+    std::vector<HalfInt> values;
+    for (HalfInt j(-100000); j <= 100000; j += HalfInt(1,2))
+      values.push_back(j);
+    for (int offset=0; offset<4; ++offset)
+      {
+        values.push_back(HalfInt(std::numeric_limits<int>::min()+offset,2));
+        values.push_back(HalfInt(std::numeric_limits<int>::max()-offset,2));
+      }
+    for (char presentation : {'g','f'})
+      for (const HalfInt& j : values)
+        {
+          char buffer[kHalfIntMaxChars];
+          std::to_chars_result written = to_chars(buffer, buffer+kHalfIntMaxChars, j, presentation);
+          HalfInt j_conv;
+          std::from_chars_result read = from_chars(buffer, written.ptr, j_conv);
+          if ((read.ec!=std::errc()) || (read.ptr!=written.ptr) || (j!=j_conv))
+            std::cout << j << " -> " << std::string_view(buffer, written.ptr-buffer) << " -> " << j_conv << std::endl;
+        }
+  }
+  std::cout << "****" << std::endl;
+
   // fmt formatting
   std::cout << fmt::format("{}", 1.5_hi) << std::endl;;
   std::cout << fmt::format("{}", std::tuple(0.5_hi, 1.5_hi, 2.5_hi)) << std::endl;
   const std::tuple t{1.5_hi, 2, 2.5_hi};
   std::cout << fmt::format("{}", t) << std::endl;
+  try
+    {
+      std::cout << fmt::format("{:d}", 1.5_hi) << std::endl;
+    }
+  catch (const fmt::format_error& e)
+    {
+      std::cout << "Expect error: " << e.what() << std::endl;
+    }
   std::cout << "****" << std::endl;
 
   // should cause compiler failure:
@@ -93,6 +167,24 @@ int main(int argc, char **argv)
             << HalfInt(22,2).Str() << " "  << hash_value(HalfInt(22,2)) << std::endl;
   std::cout << "****" << std::endl;
 
+  // compact storage types
+  std::cout << "compact storage types" << std::endl;
+  HalfInt8 j8(HalfInt(7,2));
+  HalfInt16 j16 = 300;
+  std::cout << sizeof(j8) << " " << sizeof(j16) << std::endl;
+  std::cout << j8 << " " << j8+1 << " " << -j8 << " " << (j8<j16) << " " << Hat(j8) << std::endl;
+  std::cout << fmt::format("{} {:f}", j8, j16) << std::endl;
+  std::cout << (std::hash<HalfInt8>()(j8)==std::hash<HalfInt>()(HalfInt(7,2))) << std::endl;
+  try
+    {
+      j8 = j16;
+    }
+  catch (const std::out_of_range& e)
+    {
+      std::cout << "out of range: " << e.what() << std::endl;
+    }
+  std::cout << "****" << std::endl;
+
   // termination
   return 0;
 }
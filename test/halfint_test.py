@@ -8,8 +8,11 @@
     05/17/20 (mac): Created.
     06/26/20 (mac): Finish converting tests.  Add dict key test.
     03/28/26 (mac): Redesignate float cast as throwing TypeError.
+    10/18/26: Add pickling test.
 """
 
+import pickle
+
 import am
 
 if (__name__=="__main__"):
@@ -89,3 +92,8 @@ if (__name__=="__main__"):
     
     d = {am.HalfInt(1,2): 999}
     print("{} {}".format(d,d[am.HalfInt(1,2)]))
+
+    # Python: pickling (as twice-value)
+
+    data = pickle.dumps([am.HalfInt(1,2), am.HalfInt(-3,2), am.HalfInt(4)])
+    print("{}".format(pickle.loads(data)))
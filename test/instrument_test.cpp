@@ -0,0 +1,119 @@
+/******************************************************************************
+  instrument_test.cpp
+
+  Tests call counters and timers (instrument.h), with calls from several
+  threads, and argument profiling, against direct simulation of an LRU
+  cache.
+
+  Instrumentation is enabled for this test whether or not the library is
+  configured with AM_ENABLE_INSTRUMENT or AM_ENABLE_INSTRUMENT_ARGUMENTS.
+
+  University of Notre Dame
+
+******************************************************************************/
+
+#ifndef AM_INSTRUMENT_ARGUMENTS
+#define AM_INSTRUMENT_ARGUMENTS
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <list>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "am/halfint.h"
+#include "am/instrument.h"
+#include "am/racah_reduction.h"
+#include "am/rme.h"
+#include "am/wigner_gsl.h"
+#include "am/wigner_gsl_twice.h"
+
+int main()
+{
+  std::cout << "enabled " << am::InstrumentEnabled() << std::endl;
+
+  // calls from main thread
+  double sum = 0.;
+  for (int i=0; i<1000; ++i)
+    sum += am::Wigner6J(1,1,1,1,1,1);
+  sum += am::Unitary9J(1,1,1,1,1,1,1,1,1);
+  sum += am::Wigner3J2(1,1,2,1,-1,0);
+  sum += am::RacahReductionFactor1Rose(1,1,1,1,1,1,1);
+  sum += am::SphericalHarmonicCRME(1,0,1);
+
+  // calls from threads which exit before statistics are collected
+  std::vector<std::thread> threads;
+  for (int t=0; t<4; ++t)
+    threads.emplace_back([] {
+        for (int i=0; i<250; ++i)
+          am::Wigner9J(1,1,1,1,1,1,1,1,1);
+      });
+  for (std::thread& thread : threads)
+    thread.join();
+  std::cout << "sum " << sum << std::endl;
+
+  // expect Wigner6J 1001 (including call from RacahReductionFactor1Rose),
+  // Wigner9J 1001 (including call from Unitary9J)
+  for (const am::InstrumentRecord& record : am::GetInstrumentStatistics())
+    std::cout << record.name << " " << record.calls << std::endl;
+
+  am::WriteInstrumentStatistics(std::cout, am::InstrumentFormat::kText);
+  am::WriteInstrumentStatistics(std::cout, am::InstrumentFormat::kJSON);
+
+  // reset
+  am::ResetInstrumentStatistics();
+  am::Wigner6J(1,1,1,1,1,1);
+  std::cout << "after reset " << am::GetInstrumentStatistics().size() << " "
+            << am::GetInstrumentStatistics()[0].calls << std::endl;
+
+  // argument profiling: symmetry-related 6-j symbols share canonical key
+  am::ResetInstrumentStatistics();
+  am::Wigner6J(1,2,HalfInt(3,2),HalfInt(5,2),HalfInt(1,2),2);
+  am::Wigner6J(2,1,HalfInt(3,2),HalfInt(1,2),HalfInt(5,2),2);  // swap columns 1,2
+  am::Wigner6J(HalfInt(5,2),HalfInt(1,2),HalfInt(3,2),1,2,2);  // flip columns 1,2
+  am::Wigner9J(1,1,1,1,1,1,1,1,1);
+  for (const am::ArgumentProfile& profile : am::GetArgumentProfiles())
+    std::cout << profile.name << " calls " << profile.calls << " distinct " << profile.distinct_keys
+              << " hit rate (cache size 1) " << profile.PredictedHitRate(1) << std::endl;
+
+  // predicted hit rate vs. simulated LRU cache of canonical keys
+  am::ResetInstrumentStatistics();
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(0, 4);
+  const std::vector<std::size_t> cache_sizes = {1, 4, 16, 64};
+  std::vector<std::list<std::array<int,6>>> caches(cache_sizes.size());
+  std::vector<std::uint64_t> hits(cache_sizes.size(), 0);
+  const int num_calls = 20000;
+  for (int call=0; call<num_calls; ++call)
+    {
+      std::array<int,6> two_values;
+      for (int& two_value : two_values)
+        two_value = 2*distribution(generator);
+      am::Wigner6J2(two_values[0], two_values[1], two_values[2], two_values[3], two_values[4], two_values[5]);
+      const std::array<int,6> key = am::detail::CanonicalWigner6JKey(two_values);
+      for (std::size_t i=0; i<cache_sizes.size(); ++i)
+        {
+          std::list<std::array<int,6>>& cache = caches[i];
+          auto it = std::find(cache.begin(), cache.end(), key);
+          if (it!=cache.end())
+            {
+              ++hits[i];
+              cache.erase(it);
+            }
+          else if (cache.size()==cache_sizes[i])
+            cache.pop_back();
+          cache.push_front(key);
+        }
+    }
+  const am::ArgumentProfile profile = am::GetArgumentProfiles().at(0);
+  for (std::size_t i=0; i<cache_sizes.size(); ++i)
+    std::cout << "cache size " << cache_sizes[i]
+              << " simulated " << double(hits[i])/num_calls
+              << " predicted " << profile.PredictedHitRate(cache_sizes[i]) << std::endl;
+  am::WriteInstrumentStatistics(std::cout, am::InstrumentFormat::kText);
+
+  // output at exit (as also requested by AM_INSTRUMENT_OUTPUT)
+  am::SetInstrumentOutput("-", am::InstrumentFormat::kText);
+}
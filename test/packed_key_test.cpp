@@ -0,0 +1,167 @@
+/******************************************************************************
+  packed_key_test.cpp
+
+  Tests and benchmarks hash quality of am::PackedKey, against the
+  conventional hash of a std::tuple of HalfInt built by hash combination.
+
+  Measures, for the keys of all 6-j symbols with j<=j_max allowed by the
+  triangle conditions:
+
+    - number of full-width hash collisions
+
+    - uniformity of occupancy of 2^k buckets selected by the low bits of the
+      hash (as in power-of-two hash tables), as chi^2/dof (ideal ~1)
+
+    - avalanche: mean fraction of hash bits flipped when the key is changed
+      in a single field by one unit (ideal 0.5)
+
+    - time for hashing alone (16 passes over keys), and time for insertion
+      into and lookup in std::unordered_map
+
+  University of Notre Dame
+
+******************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "am/am.h"
+#include "am/halfint.h"
+#include "am/packed_key.h"
+
+typedef std::tuple<HalfInt,HalfInt,HalfInt,HalfInt,HalfInt,HalfInt> TupleKey;
+
+struct TupleKeyHash
+// conventional hash combination (as in boost::hash_combine)
+{
+  std::size_t operator()(const TupleKey& key) const
+  {
+    std::size_t seed = 0;
+    std::apply(
+        [&seed](const auto&... h) {
+          ((seed ^= std::hash<HalfInt>()(h)+0x9e3779b9+(seed<<6)+(seed>>2)), ...);
+        },
+        key
+      );
+    return seed;
+  }
+};
+
+template<typename Key, typename Hash>
+void Report(const char* name, const std::vector<Key>& keys, const std::vector<Key>& neighbors)
+{
+  Hash hash;
+
+  // collisions
+  std::unordered_set<std::size_t> distinct;
+  for (const Key& key : keys)
+    distinct.insert(hash(key));
+
+  // bucket uniformity for low bits
+  const int bucket_bits = 12;
+  const std::size_t num_buckets = std::size_t(1)<<bucket_bits;
+  std::vector<double> occupancy(num_buckets, 0.);
+  for (const Key& key : keys)
+    occupancy[hash(key)&(num_buckets-1)] += 1.;
+  const double expected = double(keys.size())/num_buckets;
+  double chi2 = 0.;
+  for (double n : occupancy)
+    chi2 += (n-expected)*(n-expected)/expected;
+
+  // avalanche
+  double flipped = 0.;
+  for (std::size_t i=0; i<keys.size(); ++i)
+    flipped += __builtin_popcountll(std::uint64_t(hash(keys[i])^hash(neighbors[i])));
+  const double avalanche = flipped/(64.*keys.size());
+
+  // timing of hashing alone
+  auto hash_start = std::chrono::steady_clock::now();
+  std::size_t hash_sum = 0;
+  for (int repetition=0; repetition<16; ++repetition)
+    for (const Key& key : keys)
+      hash_sum += hash(key);
+  const double hash_time = std::chrono::duration<double>(std::chrono::steady_clock::now()-hash_start).count();
+
+  // timing of map insertion and lookup
+  auto start = std::chrono::steady_clock::now();
+  std::unordered_map<Key,double,Hash> map;
+  for (std::size_t i=0; i<keys.size(); ++i)
+    map.emplace(keys[i], double(i));
+  double sum = 0.;
+  for (int repetition=0; repetition<4; ++repetition)
+    for (const Key& key : keys)
+      sum += map.find(key)->second;
+  auto end = std::chrono::steady_clock::now();
+  const double time = std::chrono::duration<double>(end-start).count();
+
+  std::cout << name
+            << " keys " << keys.size()
+            << " collisions " << keys.size()-distinct.size()
+            << " chi2/dof " << chi2/(num_buckets-1)
+            << " avalanche " << avalanche
+            << " hash time " << hash_time << " s"
+            << " map time " << time << " s"
+            << " (checksum " << sum << " " << hash_sum%1000 << ")"
+            << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+
+  // packing roundtrip and layout
+  std::cout << "packing: Expect 3/2 -5/2 11 ... 0" << std::endl;
+  am::Wigner9JKey key9(HalfInt(3,2),HalfInt(-5,2),11,0,1,2,3,4,HalfInt(-1023,2));
+  for (std::size_t i=0; i<key9.kNumFields; ++i)
+    std::cout << key9[i] << " ";
+  std::cout << std::endl;
+  std::cout << "words " << am::Wigner6JKey::kNumWords << " " << am::Wigner9JKey::kNumWords
+            << " bits " << am::Wigner6JKey::kFieldBits << " " << am::Wigner9JKey::kFieldBits
+            << " sizeof " << sizeof(am::Wigner6JKey) << " " << sizeof(am::NLJKey) << std::endl;
+  std::cout << (am::NLJKey(0,1,HalfInt(1,2))==am::NLJKey(0,1,HalfInt(1,2))) << " "
+            << (am::NLJKey(0,1,HalfInt(1,2))==am::NLJKey(0,1,HalfInt(3,2))) << std::endl;
+  try
+    {
+      am::Wigner9JKey(0,0,0,0,0,0,0,0,2048);
+    }
+  catch (const std::out_of_range& e)
+    {
+      std::cout << "out of range: " << e.what() << std::endl;
+    }
+  std::cout << "****" << std::endl;
+
+  // hash quality for 6-j argument sets
+  const HalfInt j_max = 8;
+  std::vector<am::Wigner6JKey> packed_keys, packed_neighbors;
+  std::vector<TupleKey> tuple_keys, tuple_neighbors;
+  for (HalfInt ja=0; ja<=j_max; ja+=HalfInt(1,2))
+    for (HalfInt jb=0; jb<=j_max; jb+=HalfInt(1,2))
+      for (HalfInt jc : am::ProductAngularMomentaView(ja,jb))
+        for (HalfInt jd=0; jd<=j_max; jd+=HalfInt(1,2))
+          for (HalfInt je=0; je<=j_max; je+=HalfInt(1,2))
+            {
+              if (!am::AllowedTriangle(jd,je,jc))
+                continue;
+              for (HalfInt jf : am::ProductAngularMomentaView(ja,je))
+                {
+                  if (!am::AllowedTriangle(jd,jb,jf))
+                    continue;
+                  packed_keys.emplace_back(ja,jb,jc,jd,je,jf);
+                  packed_neighbors.emplace_back(ja,jb,jc,jd,je,jf+1);
+                  tuple_keys.emplace_back(ja,jb,jc,jd,je,jf);
+                  tuple_neighbors.emplace_back(ja,jb,jc,jd,je,jf+1);
+                }
+            }
+  std::cout << "hash quality for 6-j keys, j<=" << j_max << std::endl;
+  Report<TupleKey,TupleKeyHash>("tuple ", tuple_keys, tuple_neighbors);
+  Report<am::Wigner6JKey,am::PackedKeyHash>("packed", packed_keys, packed_neighbors);
+  std::cout << "****" << std::endl;
+
+  // termination
+  return 0;
+}
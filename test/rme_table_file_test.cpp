@@ -0,0 +1,189 @@
+/******************************************************************************
+  rme_table_file_test.cpp
+
+  Tests am::RMETableWriter and am::RMETableFile, and compares load time of
+  the binary table against the equivalent text table read with am::ReadTable.
+
+  Usage: rme_table_file_test [j_max]
+
+  University of Notre Dame
+
+******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "am/am.h"
+#include "am/halfint.h"
+#include "am/rme_table_file.h"
+#include "am/table_reader.h"
+
+int main(int argc, char **argv)
+{
+  const int j_max = (argc>1) ? std::stoi(argv[1]) : 40;
+
+  // basis: single-particle (l,j) orbitals, grouped into subspaces by j, with
+  // n as multiplicity index
+  const int n_max = 16;
+  am::RMETableBasis basis;
+  basis.label_names = {"n","l","j"};
+  basis.labels.resize(3);
+  for (HalfInt j=HalfInt(1,2); j<=j_max; ++j)
+    {
+      basis.subspaces.push_back({j, std::size_t(2*n_max)});
+      for (int l : {int(j-HalfInt(1,2)), int(j+HalfInt(1,2))})
+        for (int n=0; n<n_max; ++n)
+          {
+            basis.labels[0].push_back(n);
+            basis.labels[1].push_back(l);
+            basis.labels[2].push_back(j);
+          }
+    }
+  const HalfInt k = 2;
+
+  // write binary and text tables
+  const std::string filename = "rme_table_file_test.bin";
+  const std::string text_filename = "rme_table_file_test.dat";
+  std::vector<am::ReducedMatrixBlock> blocks;
+  {
+    am::RMETableWriter writer(filename, basis, basis, k);
+    std::ofstream text_stream(text_filename);
+    for (std::size_t bra=0; bra<basis.subspaces.size(); ++bra)
+      for (std::size_t ket=0; ket<basis.subspaces.size(); ++ket)
+        {
+          const HalfInt Jp = basis.subspaces[bra].J, J = basis.subspaces[ket].J;
+          if (!am::AllowedTriangle(Jp,k,J))
+            continue;
+          am::ReducedMatrixBlock block{bra, ket, {}};
+          for (std::size_t i=0; i<basis.subspaces[bra].dimension; ++i)
+            for (std::size_t j=0; j<basis.subspaces[ket].dimension; ++j)
+              {
+                block.rmes.push_back(double(bra)+1e-3*double(i*100+j));
+                text_stream << Jp << " " << J << " " << i << " " << j << " " << block.rmes.back() << "\n";
+              }
+          writer.WriteBlock(block);
+          blocks.push_back(block);
+        }
+    writer.Close();
+    std::cout << "wrote " << writer.num_blocks() << " blocks" << std::endl;
+  }
+
+  // read binary table
+  {
+    auto start = std::chrono::steady_clock::now();
+    am::RMETableFile table(filename);
+    double checksum = 0.;
+    for (std::size_t b=0; b<table.num_blocks(); ++b)
+      {
+        const am::RMETableBlockView view = table.block(b);
+        checksum += view.rmes[view.rows*view.cols-1];
+      }
+    auto time = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::cout << "binary: " << table.num_blocks() << " blocks, checksum " << checksum
+              << ", " << time << " s" << std::endl;
+
+    // check contents
+    bool ok = (table.k()==k) && (table.num_blocks()==blocks.size())
+      && (table.bra_num_states()==basis.num_states()) && (table.ket_labels().size()==3);
+    for (std::size_t c=0; c<3; ++c)
+      {
+        const am::RMETableLabelColumn& column = table.bra_labels()[c];
+        ok &= (column.name()==basis.label_names[c]);
+        for (std::size_t state=0; state<basis.num_states(); ++state)
+          ok &= (column[state]==basis.labels[c][state]);
+      }
+    std::cout << "label widths:";
+    for (const am::RMETableLabelColumn& column : table.bra_labels())
+      std::cout << " " << column.name() << ":" << column.width();
+    std::cout << std::endl;
+    for (const am::ReducedMatrixBlock& block : blocks)
+      {
+        am::RMETableBlockView view{};
+        ok &= table.Find(block.bra_subspace_index, block.ket_subspace_index, view);
+        ok &= (view.Jp==basis.subspaces[block.bra_subspace_index].J);
+        ok &= std::equal(block.rmes.begin(), block.rmes.end(), view.rmes);
+      }
+    am::RMETableBlockView view{};
+    ok &= !table.Find(0, basis.subspaces.size()-1, view);
+    std::cout << "roundtrip " << (ok ? "OK" : "FAILED") << std::endl;
+  }
+
+  // read text table
+  {
+    auto start = std::chrono::steady_clock::now();
+    am::ColumnarTable table = am::ReadTable(
+        text_filename,
+        {am::ColumnType::kHalfInt, am::ColumnType::kHalfInt, am::ColumnType::kInt,
+         am::ColumnType::kInt, am::ColumnType::kDouble}
+      );
+    auto time = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::cout << "text: " << table.num_rows() << " rows, " << time << " s" << std::endl;
+  }
+
+  // corrupt files: block rows not matching bra subspace dimension, subspace
+  // dimensions not summing to number of states, and repeated block
+  //
+  // Offsets are those of the file layout: header index_offset (40) and
+  // bra/ket basis offsets (24/32), index record (40 bytes) rows (+24),
+  // and subspace record dimension (+24+16*s+8, after basis header).
+  auto read_word = [&](std::uint64_t offset) {
+    std::ifstream stream(filename, std::ios::binary);
+    std::uint64_t word;
+    stream.seekg(offset);
+    stream.read(reinterpret_cast<char*>(&word), sizeof(word));
+    return word;
+  };
+  auto write_word = [&](std::uint64_t offset, std::uint64_t word) {
+    std::fstream stream(filename, std::ios::binary|std::ios::in|std::ios::out);
+    stream.seekp(offset);
+    stream.write(reinterpret_cast<const char*>(&word), sizeof(word));
+  };
+  auto expect_error = [&]() {
+    try
+      {
+        am::RMETableFile table(filename);
+        std::cout << "ERROR: corrupt file accepted" << std::endl;
+      }
+    catch (const std::runtime_error& e)
+      {
+        std::cout << "Expect error: " << e.what() << std::endl;
+      }
+  };
+  const std::uint64_t index_offset = read_word(40);
+  const std::uint64_t rows_offset = index_offset+24;
+  const std::uint64_t bra_dimension_offset = read_word(24)+24+16*blocks[0].bra_subspace_index+8;
+  const std::uint64_t rows = read_word(rows_offset);
+  const std::uint64_t bra_dimension = read_word(bra_dimension_offset);
+  write_word(rows_offset, rows+1);
+  expect_error();
+  write_word(rows_offset, rows);
+  write_word(bra_dimension_offset, std::uint64_t(1)<<33);
+  expect_error();
+  write_word(bra_dimension_offset, bra_dimension);
+  for (std::uint64_t word=0; word<5; ++word)
+    write_word(index_offset+40+8*word, read_word(index_offset+8*word));
+  expect_error();
+
+  // truncated file
+  {
+    std::ofstream stream(filename, std::ios::binary|std::ios::trunc);
+    stream << "AMRMETBL";
+  }
+  try
+    {
+      am::RMETableFile table(filename);
+    }
+  catch (const std::runtime_error& e)
+    {
+      std::cout << "Expect error: " << e.what() << std::endl;
+    }
+
+  std::remove(filename.c_str());
+  std::remove(text_filename.c_str());
+}
@@ -0,0 +1,122 @@
+/******************************************************************************
+  rme_table_test.cpp
+
+  Tests am::SphericalHarmonicRMETable: compares the spherical harmonic RMEs
+  served from the process-wide table against direct evaluation, inside and
+  outside the tabulated range, and after the table is cleared.
+
+  University of Notre Dame
+
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "am/halfint.h"
+#include "am/rme.h"
+
+struct RMEValues
+{
+  std::vector<double> c, y, lj_c, lj_y;
+};
+
+RMEValues EvaluateRMEs(int l_max, int k_max)
+// Evaluate spherical harmonic RMEs (through am::SphericalHarmonic*RME) for all
+// allowed arguments up to given cutoffs.
+{
+  RMEValues values;
+  for (int lp=0; lp<=l_max; ++lp)
+    for (int l=0; l<=l_max; ++l)
+      for (int k=0; k<=k_max; ++k)
+        {
+          if (!am::AllowedTriangle(lp, k, l))
+            continue;
+          values.c.push_back(am::SphericalHarmonicCRME(lp, l, k));
+          values.y.push_back(am::SphericalHarmonicYRME(lp, l, k));
+          for (HalfInt jp : {lp-HalfInt(1,2), lp+HalfInt(1,2)})
+            for (HalfInt j : {l-HalfInt(1,2), l+HalfInt(1,2)})
+              {
+                if ((jp<0) || (j<0))
+                  continue;
+                values.lj_c.push_back(am::LJCoupledSphericalHarmonicCRME(lp, jp, l, j, k));
+                values.lj_y.push_back(am::LJCoupledSphericalHarmonicYRME(lp, jp, l, j, k));
+              }
+        }
+  return values;
+}
+
+double MaxDeviation(const std::vector<double>& a, const std::vector<double>& b)
+{
+  if (a.size()!=b.size())
+    throw std::logic_error("size mismatch");
+  double max_deviation = 0.;
+  for (std::size_t i=0; i<a.size(); ++i)
+    max_deviation = std::max(max_deviation, std::abs(a[i]-b[i]));
+  return max_deviation;
+}
+
+void PrintDeviations(const char* label, const RMEValues& values, const RMEValues& direct)
+{
+  std::cout << label << ": max deviation"
+            << " C " << MaxDeviation(values.c, direct.c)
+            << " Y " << MaxDeviation(values.y, direct.y)
+            << " lj C " << MaxDeviation(values.lj_c, direct.lj_c)
+            << " lj Y " << MaxDeviation(values.lj_y, direct.lj_y)
+            << " (" << direct.c.size() << " + " << direct.lj_c.size() << " RMEs)"
+            << std::endl;
+}
+
+int main()
+{
+  // evaluate beyond tabulated range, to cover both lookup and fallback
+  const int l_max = 8, k_max = 6;
+  const int table_l_max = 5, table_k_max = 3;
+
+  std::cout << "table before initialization " << am::GetSphericalHarmonicRMETable() << std::endl;
+  const RMEValues direct = EvaluateRMEs(l_max, k_max);
+
+  am::InitializeSphericalHarmonicRMETable(table_l_max, table_k_max);
+  const am::SphericalHarmonicRMETable* table = am::GetSphericalHarmonicRMETable();
+  std::cout << "table lmax " << table->lmax() << " kmax " << table->kmax()
+            << " size " << table->size() << std::endl;
+
+  // expect zero deviation, both inside [lmax,kmax] (table) and outside (direct)
+  PrintDeviations("tabulated", EvaluateRMEs(l_max, k_max), direct);
+  std::cout << "table C(2,3,1) " << table->CRME(2,3,1)
+            << " expected " << am::detail::SphericalHarmonicCRMEDirect(2,3,1) << std::endl;
+  std::cout << "table lj C(2,3/2,1,3/2,1) " << table->LJCoupledCRME(2,HalfInt(3,2),1,HalfInt(3,2),1)
+            << " expected " << am::detail::LJCoupledSphericalHarmonicCRMEDirect(2,HalfInt(3,2),1,HalfInt(3,2),1)
+            << std::endl;
+
+  // disallowed arguments still rejected before lookup
+  #ifdef AM_EXCEPTIONS
+  try
+    {
+      am::SphericalHarmonicCRME(0, 3, 1);
+    }
+  catch (const std::domain_error& e)
+    {
+      std::cout << "Expect error: " << e.what() << std::endl;
+    }
+  #else
+  std::cout << "disallowed C(0,3,1) " << am::SphericalHarmonicCRME(0, 3, 1) << " (expect 0)" << std::endl;
+  #endif
+
+  // expect zero deviation after clearing (direct evaluation)
+  am::ClearSphericalHarmonicRMETable();
+  std::cout << "table after clear " << am::GetSphericalHarmonicRMETable() << std::endl;
+  PrintDeviations("cleared", EvaluateRMEs(l_max, k_max), direct);
+
+  // negative cutoff
+  try
+    {
+      am::InitializeSphericalHarmonicRMETable(-1, 2);
+    }
+  catch (const std::invalid_argument& e)
+    {
+      std::cout << "Expect error: " << e.what() << std::endl;
+    }
+}
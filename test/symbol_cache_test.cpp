@@ -0,0 +1,88 @@
+/******************************************************************************
+  symbol_cache_test.cpp
+
+  Tests am::SymbolCache (through am::Wigner6JCache and am::Wigner9JCache):
+  warming, lookup, saving, and attaching a table file.
+
+  Usage: symbol_cache_test [j_max]
+
+  University of Notre Dame
+
+******************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "am/halfint.h"
+#include "am/symbol_cache.h"
+#include "am/wigner_gsl.h"
+
+void PrintStatistics(const std::string& label, const am::SymbolCacheStatistics& statistics)
+{
+  std::cout << label << ": size " << statistics.size()
+            << " (mapped " << statistics.mapped_size << ", local " << statistics.local_size << ")"
+            << " hits " << statistics.hits << " misses " << statistics.misses
+            << " hit rate " << statistics.hit_rate() << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+  const HalfInt j_max = (argc>1) ? HalfInt(std::stoi(argv[1])) : HalfInt(4);
+  am::SymbolCache<6>& cache = am::Wigner6JCache();
+
+  // warm cache
+  auto start = std::chrono::steady_clock::now();
+  cache.Warm(j_max);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()-start;
+  std::cout << "warm to j_max " << j_max << ": " << elapsed.count() << " s" << std::endl;
+  PrintStatistics("Wigner6J warmed", cache.statistics());
+
+  // compare cached and direct values
+  double max_deviation = 0.;
+  for (HalfInt ja=0; ja<=j_max; ja+=HalfInt(1,2))
+    for (HalfInt jb=0; jb<=j_max; jb+=HalfInt(1,2))
+      for (HalfInt jc=0; jc<=j_max; jc+=HalfInt(1,2))
+        for (HalfInt jd : {HalfInt(1,2), HalfInt(1), HalfInt(3,2)})
+          for (HalfInt je : {HalfInt(1,2), HalfInt(2)})
+            for (HalfInt jf=0; jf<=j_max; jf+=HalfInt(1,2))
+              max_deviation = std::max(
+                  max_deviation,
+                  std::abs(am::CachedWigner6J(ja,jb,jc,jd,je,jf)-am::Wigner6J(ja,jb,jc,jd,je,jf))
+                );
+  std::cout << "max deviation " << max_deviation << std::endl;
+  PrintStatistics("Wigner6J after lookup", cache.statistics());
+
+  // save, and reattach in place of local table
+  const std::string filename = "symbol_cache_test.bin";
+  cache.Save(filename);
+  cache.Clear();
+  cache.Attach(filename);
+  std::cout << "attached " << cache.filename() << std::endl;
+  std::cout << "value " << am::CachedWigner6J(1,1,1,1,1,1)
+            << " expected " << am::Wigner6J(1,1,1,1,1,1) << std::endl;
+  std::cout << "value " << am::CachedWigner6J(j_max+1,1,j_max+1,j_max+1,j_max+1,j_max+1)
+            << " expected " << am::Wigner6J(j_max+1,1,j_max+1,j_max+1,j_max+1,j_max+1) << std::endl;
+  PrintStatistics("Wigner6J attached", cache.statistics());
+
+  // wrong symbol type
+  try
+    {
+      am::Wigner9JCache().Attach(filename);
+    }
+  catch (const std::runtime_error& e)
+    {
+      std::cout << "Expect error: " << e.what() << std::endl;
+    }
+
+  // 9-j symbols
+  am::SymbolCache<9>& cache9 = am::Wigner9JCache();
+  cache9.Warm(HalfInt(3,2));
+  std::cout << "value " << am::CachedWigner9J(1,1,1,1,1,1,1,1,1)
+            << " expected " << am::Wigner9J(1,1,1,1,1,1,1,1,1) << std::endl;
+  PrintStatistics("Wigner9J warmed", cache9.statistics());
+
+  std::remove(filename.c_str());
+}
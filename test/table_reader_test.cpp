@@ -0,0 +1,110 @@
+/******************************************************************************
+  table_reader_test.cpp
+
+  Tests am::ReadTable, and benchmarks its throughput against conventional
+  parsing with iostreams.
+
+  Usage: table_reader_test [num_rows]
+
+  University of Notre Dame
+
+******************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "am/halfint.h"
+#include "am/table_reader.h"
+
+int main(int argc, char **argv)
+{
+  const std::size_t num_rows = (argc>1) ? std::stoul(argv[1]) : 2000000;
+
+  // small table
+  std::cout << "small table" << std::endl;
+  const std::string filename = "table_reader_test.dat";
+  {
+    std::ofstream stream(filename);
+    stream << "# n l j J' J rme" << std::endl
+           << "0 1 1/2 3/2 1/2 0.25" << std::endl
+           << std::endl
+           << "  1 2 2.5 +3 7/2 -1.5e-3  " << std::endl
+           << "2\t0\t0.5\t1\t1\t4" << std::endl;
+  }
+  const std::vector<am::ColumnType> column_types{
+      am::ColumnType::kInt, am::ColumnType::kInt, am::ColumnType::kHalfInt,
+      am::ColumnType::kHalfInt, am::ColumnType::kHalfInt, am::ColumnType::kDouble
+    };
+  am::ColumnarTable table = am::ReadTable(filename, column_types);
+  for (std::size_t row=0; row<table.num_rows(); ++row)
+    std::cout << table.int_column(0)[row] << " " << table.int_column(1)[row] << " "
+              << table.halfint_column(2)[row] << " " << table.halfint_column(3)[row] << " "
+              << table.halfint_column(4)[row] << " " << table.double_column(5)[row] << std::endl;
+  {
+    std::ofstream stream(filename);
+    stream << "0 1 1/2 3/2 1/2 0.25" << std::endl
+           << "0 1 3/4 3/2 1/2 0.25" << std::endl;
+  }
+  try
+    {
+      am::ReadTable(filename, column_types);
+    }
+  catch (const std::runtime_error& e)
+    {
+      std::cout << "Expect error on line 2: " << e.what() << std::endl;
+    }
+  std::cout << "****" << std::endl;
+
+  // throughput benchmark
+  std::cout << "throughput: " << num_rows << " rows" << std::endl;
+  {
+    std::ofstream stream(filename);
+    for (std::size_t row=0; row<num_rows; ++row)
+      stream << row%20 << " " << row%7 << " " << HalfInt(2*(row%7)+1,2) << " "
+             << HalfInt(row%13,2) << " " << HalfInt(row%11,2) << " "
+             << std::sin(double(row)) << "\n";
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  table = am::ReadTable(filename, column_types);
+  double time_mapped = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+
+  start = std::chrono::steady_clock::now();
+  std::vector<int> n, l;
+  std::vector<HalfInt> j, Jp, J;
+  std::vector<double> rme;
+  {
+    std::ifstream stream(filename);
+    std::string line;
+    while (std::getline(stream, line))
+      {
+        std::istringstream line_stream(line);
+        int n_value, l_value;
+        HalfInt j_value, Jp_value, J_value;
+        double rme_value;
+        line_stream >> n_value >> l_value >> j_value >> Jp_value >> J_value >> rme_value;
+        n.push_back(n_value); l.push_back(l_value);
+        j.push_back(j_value); Jp.push_back(Jp_value); J.push_back(J_value);
+        rme.push_back(rme_value);
+      }
+  }
+  double time_stream = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+
+  std::size_t mismatches = (table.num_rows()==rme.size()) ? 0 : 1;
+  for (std::size_t row=0; (row<rme.size()) && !mismatches; ++row)
+    mismatches += (table.halfint_column(3)[row]!=Jp[row]) || (table.double_column(5)[row]!=rme[row]);
+  std::cout << "mismatches " << mismatches << std::endl;
+  std::cout << "ReadTable " << time_mapped << " s, " << num_rows/time_mapped/1e6 << " Mrows/s" << std::endl;
+  std::cout << "iostream  " << time_stream << " s, " << num_rows/time_stream/1e6 << " Mrows/s" << std::endl;
+  std::remove(filename.c_str());
+  std::cout << "****" << std::endl;
+
+  // termination
+  return 0;
+}
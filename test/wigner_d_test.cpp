@@ -0,0 +1,99 @@
+/******************************************************************************
+  wigner_d_test.cpp
+
+  University of Notre Dame
+
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <vector>
+
+#include "am/halfint.h"
+#include "am/wigner_d.h"
+
+double Factorial(int n)
+{
+  return std::tgamma(n+1.);
+}
+
+double WignerSmallDSum(const HalfInt& j, const HalfInt& mp, const HalfInt& m, double beta)
+// d^j_{m'm}(beta) by the Wigner sum formula
+{
+  const double c = std::cos(beta/2), s = std::sin(beta/2);
+  const int jpmp=int(j+mp), jmmp=int(j-mp), jpm=int(j+m), jmm=int(j-m), d=int(mp-m);
+  double sum = 0.;
+  for (int k=std::max(0,-d); k<=std::min(jpm,jmmp); ++k)
+    sum += ((d+k)%2 ? -1. : 1.)
+      / (Factorial(jpm-k)*Factorial(k)*Factorial(d+k)*Factorial(jmmp-k))
+      * std::pow(c,jpm+jmmp-2*k) * std::pow(s,d+2*k);
+  return std::sqrt(Factorial(jpmp)*Factorial(jmmp)*Factorial(jpm)*Factorial(jmm))*sum;
+}
+
+int main(int argc, char **argv)
+{
+
+  // small-d by recursion vs. sum formula
+  std::cout << "d^j(beta): Expect deviations ~1e-13 or smaller" << std::endl;
+  const HalfInt j_max = 10;
+  am::WignerSmallD d(j_max);
+  for (double beta : {0., 0.3, 1.7, M_PI, 5.5})
+    {
+      d.Evaluate(beta);
+      double max_deviation = 0.;
+      for (HalfInt j=0; j<=j_max; j+=HalfInt(1,2))
+        for (HalfInt mp=-j; mp<=j; ++mp)
+          for (HalfInt m=-j; m<=j; ++m)
+            max_deviation = std::max(max_deviation,std::abs(d(j,mp,m)-WignerSmallDSum(j,mp,m,beta)));
+      std::cout << "beta " << beta << " " << max_deviation << std::endl;
+    }
+  d.Evaluate(0.3);
+  std::cout << "d^{1/2}_{1/2,-1/2}(0.3): Expect -0.149438..." << std::endl;
+  std::cout << d(HalfInt(1,2),HalfInt(1,2),-HalfInt(1,2)) << std::endl;
+  std::cout << "****" << std::endl;
+
+  // unitarity of D at large j
+  std::cout << "D^j unitarity: Expect deviations ~1e-12 or smaller" << std::endl;
+  {
+    const HalfInt j = HalfInt(201,2);
+    am::WignerD D(j);
+    D.Evaluate(0.4,2.1,-1.3);
+    const std::complex<double>* matrix = D.matrix(j);
+    const int n = am::dim(j);
+    double max_deviation = 0.;
+    for (int a=0; a<n; ++a)
+      for (int b=0; b<n; ++b)
+        {
+          std::complex<double> product = 0.;
+          for (int k=0; k<n; ++k)
+            product += matrix[a*n+k]*std::conj(matrix[b*n+k]);
+          max_deviation = std::max(max_deviation,std::abs(product-(a==b ? 1. : 0.)));
+        }
+    std::cout << "j " << j << " " << max_deviation << std::endl;
+  }
+  std::cout << "****" << std::endl;
+
+  // batch vs. single angle
+  std::cout << "batch: Expect deviation 0" << std::endl;
+  {
+    std::vector<double> betas;
+    for (int a=0; a<50; ++a)
+      betas.push_back(0.1*a);
+    std::vector<double> values = am::WignerSmallDBatch(j_max, betas);
+    const std::size_t size = am::WignerDSize(TwiceValue(j_max));
+    double max_deviation = 0.;
+    for (std::size_t a=0; a<betas.size(); ++a)
+      {
+        d.Evaluate(betas[a]);
+        for (std::size_t i=0; i<size; ++i)
+          max_deviation = std::max(max_deviation,std::abs(values[a*size+i]-d.values()[i]));
+      }
+    std::cout << max_deviation << std::endl;
+  }
+  std::cout << "****" << std::endl;
+
+  // termination
+  return 0;
+}
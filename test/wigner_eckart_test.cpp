@@ -0,0 +1,166 @@
+/******************************************************************************
+  wigner_eckart_test.cpp
+
+  University of Notre Dame
+
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "am/halfint.h"
+#include "am/clebsch_gordan.h"
+#include "am/coupling_transform.h"
+#include "am/ladder_operators.h"
+#include "am/rme.h"
+#include "am/wigner_eckart.h"
+#include "am/wigner_gsl.h"
+
+int main(int argc, char **argv)
+{
+
+  // Clebsch-Gordan tables by recursion vs. GSL
+  std::cout << "Clebsch-Gordan table: Expect deviations ~1e-15 or smaller" << std::endl;
+  for (const HalfInt::vector& triad : std::vector<HalfInt::vector>{
+      {HalfInt(1,2),HalfInt(1,2),1}, {2,HalfInt(3,2),HalfInt(5,2)},
+      {5,3,4}, {HalfInt(15,2),6,HalfInt(9,2)}, {20,HalfInt(31,2),HalfInt(13,2)}
+    })
+    {
+      const HalfInt j1=triad[0], j2=triad[1], J=triad[2];
+      am::ClebschGordanTable table(j1,j2,J);
+      double max_deviation = 0.;
+      for (HalfInt m1=-j1; m1<=j1; ++m1)
+        for (HalfInt m2=-j2; m2<=j2; ++m2)
+          {
+            if (abs(m1+m2)>J) continue;
+            double deviation = std::abs(table(m1,m2)-am::ClebschGordan(j1,m1,j2,m2,J,m1+m2));
+            max_deviation = std::max(max_deviation,deviation);
+          }
+      std::cout << "(" << j1 << "," << j2 << "," << J << ") " << max_deviation << std::endl;
+    }
+  std::cout << "CG: Expect 0.676123..." << std::endl;
+  std::cout << am::ClebschGordanTable(2,HalfInt(3,2),HalfInt(5,2))(+2,-HalfInt(1,2)) << std::endl;
+  std::cout << "****" << std::endl;
+
+  // Wigner-Eckart expansion of angular momentum operator
+  //
+  // Expect J_0 diagonal with entries M, and J_{+1}=-J_+/sqrt(2).
+  std::cout << "Wigner-Eckart expansion of J" << std::endl;
+  std::vector<am::AngularMomentumSubspace> subspaces{{HalfInt(1,2),1},{HalfInt(3,2),2}};
+  std::vector<am::ReducedMatrixBlock> blocks;
+  for (std::size_t s=0; s<subspaces.size(); ++s)
+    {
+      am::ReducedMatrixBlock block{s, s, std::vector<double>(subspaces[s].dimension*subspaces[s].dimension, 0.)};
+      for (std::size_t i=0; i<subspaces[s].dimension; ++i)
+        block.rmes[i*subspaces[s].dimension+i] = am::AngularMomentumJRME(subspaces[s].J,subspaces[s].J);
+      blocks.push_back(block);
+    }
+  std::vector<am::CSRMatrix> matrices = am::WignerEckartExpansion(subspaces, subspaces, blocks, 1);
+  for (int q=-1; q<=1; ++q)
+    {
+      const am::CSRMatrix& matrix = matrices[q+1];
+      std::cout << "q " << q << " nnz " << matrix.nnz() << std::endl;
+      for (std::size_t row=0; row<matrix.num_rows; ++row)
+        for (std::size_t position=matrix.row_offsets[row]; position<matrix.row_offsets[row+1]; ++position)
+          std::cout << "  (" << row << "," << matrix.column_indices[position] << ") "
+                    << matrix.values[position] << std::endl;
+    }
+
+  // invalid tensor rank or component
+  #ifdef AM_EXCEPTIONS
+  for (const auto& [k, q] : std::vector<std::pair<int,HalfInt>>{{1,2}, {1,-2}, {1,HalfInt(1,2)}, {-1,0}})
+    {
+      try
+        {
+          am::WignerEckartExpansion(subspaces, subspaces, blocks, k, q);
+        }
+      catch (const std::invalid_argument& e)
+        {
+          std::cout << "Expect error: " << e.what() << std::endl;
+        }
+    }
+  #endif
+  std::cout << "****" << std::endl;
+
+  // coupling transform
+  std::cout << "coupling transform: Expect deviations ~1e-15 or smaller" << std::endl;
+  {
+    am::CouplingTransform transform(HalfInt(7,2),5);
+    const std::size_t num_vectors = 3;
+    std::vector<double> uncoupled(transform.dimension()*num_vectors), coupled(uncoupled.size()), roundtrip(uncoupled.size());
+    for (std::size_t a=0; a<uncoupled.size(); ++a)
+      uncoupled[a] = std::sin(double(a));
+    transform.Couple(num_vectors, uncoupled.data(), coupled.data());
+    transform.Uncouple(num_vectors, coupled.data(), roundtrip.data());
+    double max_deviation = 0.;
+    for (std::size_t a=0; a<uncoupled.size(); ++a)
+      max_deviation = std::max(max_deviation,std::abs(roundtrip[a]-uncoupled[a]));
+    std::cout << "roundtrip " << max_deviation << std::endl;
+    const HalfInt J=HalfInt(9,2), M=HalfInt(-3,2);
+    double direct = 0.;
+    for (HalfInt m1=-transform.j1(); m1<=transform.j1(); ++m1)
+      if (abs(M-m1)<=transform.j2())
+        direct += am::ClebschGordan(transform.j1(),m1,transform.j2(),M-m1,J,M)
+          * uncoupled[transform.UncoupledIndex(m1,M-m1)*num_vectors+1];
+    std::cout << "direct " << std::abs(direct-coupled[transform.CoupledIndex(J,M)*num_vectors+1]) << std::endl;
+  }
+  std::cout << "****" << std::endl;
+
+  // ladder operators and J projection
+  std::cout << "J^2 on projected vectors: Expect deviations ~1e-12 or smaller" << std::endl;
+  {
+    am::ProductMSchemeLayout layout({HalfInt(3,2),1,HalfInt(5,2)});
+    const std::size_t dimension = layout.dimension();
+    std::vector<double> x(dimension), projected(dimension), y(dimension);
+    for (std::size_t a=0; a<dimension; ++a)
+      x[a] = std::sin(1.+a);
+    double total_weight = 0., norm = 0.;
+    for (std::size_t a=0; a<dimension; ++a)
+      norm += x[a]*x[a];
+    for (HalfInt J=layout.J_min(); J<=layout.J_max(); ++J)
+      {
+        projected = x;
+        am::ProjectJ(layout, J, projected.data(), 1);
+        am::ApplyJ2(layout, projected.data(), 1, y.data(), 1);
+        double max_deviation = 0., weight = 0.;
+        for (std::size_t a=0; a<dimension; ++a)
+          {
+            max_deviation = std::max(max_deviation,std::abs(y[a]-double(J)*double(J+1)*projected[a]));
+            weight += x[a]*projected[a];
+          }
+        total_weight += weight;
+        std::cout << "J " << J << " " << max_deviation << std::endl;
+      }
+    std::cout << "completeness " << std::abs(total_weight-norm) << std::endl;
+
+    // invalid lower bound J_min
+    for (HalfInt J_min : {HalfInt(3,2), HalfInt(4)})
+      {
+        projected = x;
+        #ifdef AM_EXCEPTIONS
+        try
+          {
+            am::ProjectJ(layout, HalfInt(3), projected.data(), 1, J_min);
+          }
+        catch (const std::invalid_argument& e)
+          {
+            std::cout << "Expect error: " << e.what() << std::endl;
+          }
+        #else
+        am::ProjectJ(layout, HalfInt(3), projected.data(), 1, J_min);
+        std::cout << "J_min " << J_min << " projected norm "
+                  << std::sqrt(std::inner_product(projected.begin(), projected.end(), projected.begin(), 0.))
+                  << " (expect 0)" << std::endl;
+        #endif
+      }
+  }
+  std::cout << "****" << std::endl;
+
+  // termination
+  return 0;
+}